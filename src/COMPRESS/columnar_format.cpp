@@ -0,0 +1,186 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "columnar_format.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <zlib.h>
+
+#ifdef LAMMPS_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace LAMMPS_NS;
+
+/* ----------------------------------------------------------------------
+   codec used for new files: zstd if available, else zlib
+------------------------------------------------------------------------- */
+
+int ColumnarFormat::default_codec()
+{
+#ifdef LAMMPS_ZSTD
+  return ZSTD;
+#else
+  return ZLIB;
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+
+bool ColumnarFormat::has_codec(int codec)
+{
+  if (codec == ZLIB) return true;
+#ifdef LAMMPS_ZSTD
+  if (codec == ZSTD) return true;
+#endif
+  return false;
+}
+
+/* ---------------------------------------------------------------------- */
+
+const char *ColumnarFormat::codec_name(int codec)
+{
+  if (codec == ZLIB) return "zlib";
+  if (codec == ZSTD) return "zstd";
+  return "unknown";
+}
+
+/* ---------------------------------------------------------------------- */
+
+int ColumnarFormat::default_level(int codec)
+{
+#ifdef LAMMPS_ZSTD
+  if (codec == ZSTD) return ZSTD_CLEVEL_DEFAULT;
+#endif
+  return Z_DEFAULT_COMPRESSION;
+}
+
+/* ----------------------------------------------------------------------
+   return true if level is valid for codec, set allowed range
+------------------------------------------------------------------------- */
+
+bool ColumnarFormat::check_level(int codec, int level, int &min_level, int &max_level)
+{
+  min_level = Z_DEFAULT_COMPRESSION;
+  max_level = Z_BEST_COMPRESSION;
+#ifdef LAMMPS_ZSTD
+  if (codec == ZSTD) {
+    min_level = ZSTD_minCLevel();
+    max_level = ZSTD_maxCLevel();
+  }
+#endif
+  return (level >= min_level) && (level <= max_level);
+}
+
+/* ----------------------------------------------------------------------
+   encode N values with stride from a column of per-atom data into N*8 bytes
+   DELTA: integer values, difference to previous value, zigzag mapped
+   QUANT: like DELTA after rounding value*precision to the nearest integer
+   RAW: bit pattern of double
+   the 8 bytes of all values are stored as 8 byte planes,
+     so the mostly zero high bytes of small deltas form long runs
+------------------------------------------------------------------------- */
+
+void ColumnarFormat::encode(const double *values, bigint n, int stride, int encoding,
+                            double precision, unsigned char *out)
+{
+  int64_t prev = 0;
+  uint64_t u;
+
+  for (bigint i = 0; i < n; i++) {
+    const double value = values[i * stride];
+    if (encoding == RAW) {
+      memcpy(&u, &value, sizeof(uint64_t));
+    } else {
+      int64_t q;
+      if (encoding == QUANT) q = std::llround(value * precision);
+      else q = static_cast<int64_t>(value);
+      const uint64_t delta = static_cast<uint64_t>(q) - static_cast<uint64_t>(prev);
+      u = (delta << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(delta) >> 63);
+      prev = q;
+    }
+    for (int b = 0; b < 8; b++) out[b * n + i] = (u >> (8 * b)) & 0xff;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   inverse of encode(), store N values contiguously
+------------------------------------------------------------------------- */
+
+void ColumnarFormat::decode(const unsigned char *in, bigint n, int encoding, double precision,
+                            double *values)
+{
+  int64_t prev = 0;
+
+  for (bigint i = 0; i < n; i++) {
+    uint64_t u = 0;
+    for (int b = 0; b < 8; b++) u |= static_cast<uint64_t>(in[b * n + i]) << (8 * b);
+    if (encoding == RAW) {
+      memcpy(&values[i], &u, sizeof(double));
+    } else {
+      const uint64_t delta = (u >> 1) ^ (~(u & 1) + 1);
+      prev = static_cast<int64_t>(static_cast<uint64_t>(prev) + delta);
+      if (encoding == QUANT) values[i] = prev / precision;
+      else values[i] = static_cast<double>(prev);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   compress N bytes with codec and level into out, resized to fit
+   return false on error
+------------------------------------------------------------------------- */
+
+bool ColumnarFormat::compress(int codec, int level, const unsigned char *in, size_t n,
+                              std::vector<unsigned char> &out)
+{
+#ifdef LAMMPS_ZSTD
+  if (codec == ZSTD) {
+    out.resize(ZSTD_compressBound(n));
+    size_t nout = ZSTD_compress(out.data(), out.size(), in, n, level);
+    if (ZSTD_isError(nout)) return false;
+    out.resize(nout);
+    return true;
+  }
+#endif
+  if (codec != ZLIB) return false;
+
+  uLongf nout = compressBound(n);
+  out.resize(nout);
+  if (compress2(out.data(), &nout, in, n, level) != Z_OK) return false;
+  out.resize(nout);
+  return true;
+}
+
+/* ----------------------------------------------------------------------
+   decompress Nin bytes with codec into exactly Nout bytes
+   return false on error or size mismatch
+------------------------------------------------------------------------- */
+
+bool ColumnarFormat::decompress(int codec, const unsigned char *in, size_t nin,
+                                unsigned char *out, size_t nout)
+{
+#ifdef LAMMPS_ZSTD
+  if (codec == ZSTD) {
+    size_t ndone = ZSTD_decompress(out, nout, in, nin);
+    return !ZSTD_isError(ndone) && (ndone == nout);
+  }
+#endif
+  if (codec != ZLIB) return false;
+
+  uLongf ndone = nout;
+  if (uncompress(out, &ndone, in, nin) != Z_OK) return false;
+  return ndone == nout;
+}
@@ -0,0 +1,67 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_COLUMNAR_FORMAT_H
+#define LMP_COLUMNAR_FORMAT_H
+
+#include "lmptype.h"
+
+#include <vector>
+
+namespace LAMMPS_NS {
+
+/* ----------------------------------------------------------------------
+   layout and codecs of columnar dump files, shared by
+   dump style columnar and read_dump format columnar
+
+   file header:  magic, endian, revision, codec, ncol,
+                 name/type/encoding of each column, precision, units
+   frame record: FRAME tag, # of bytes that follow, timestep, natoms,
+                 triclinic, boundary, box bounds, tilt, time flag, time,
+                 then for each column: # of bytes, compressed column block
+   index record: INDEX tag, nframes, nframes x (timestep, file offset),
+                 nframes, index magic = trailer at end of file
+------------------------------------------------------------------------- */
+
+namespace ColumnarFormat {
+
+  constexpr int MAGICLEN = 16;
+  constexpr char MAGIC[MAGICLEN] = "LAMMPS COLUMNAR";
+  constexpr char INDEX_MAGIC[MAGICLEN] = "COLUMNAR INDEX";
+  constexpr int ENDIAN = 0x0001;
+  constexpr int REVISION = 0x0001;
+
+  enum { ZLIB = 1, ZSTD = 2 };      // codecs
+  enum { FRAME = 1, INDEX = 2 };    // record tags
+  enum { RAW, DELTA, QUANT };       // column encodings
+
+  // bytes of index trailer after the index entries
+
+  constexpr int TRAILER = sizeof(bigint) + MAGICLEN;
+
+  int default_codec();
+  bool has_codec(int);
+  const char *codec_name(int);
+  int default_level(int);
+  bool check_level(int, int, int &, int &);
+
+  void encode(const double *, bigint, int, int, double, unsigned char *);
+  void decode(const unsigned char *, bigint, int, double, double *);
+
+  bool compress(int, int, const unsigned char *, size_t, std::vector<unsigned char> &);
+  bool decompress(int, const unsigned char *, size_t, unsigned char *, size_t);
+
+}    // namespace ColumnarFormat
+}    // namespace LAMMPS_NS
+
+#endif
@@ -0,0 +1,269 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "dump_columnar.h"
+
+#include "atom.h"
+#include "columnar_format.h"
+#include "domain.h"
+#include "error.h"
+#include "update.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+DumpColumnar::DumpColumnar(LAMMPS *lmp, int narg, char **arg) :
+    DumpCustom(lmp, narg, arg), nframe(0), nrows(0), frametime(0.0)
+{
+  if (compressed) error->all(FLERR, "Dump columnar file name must not have a compression suffix");
+
+  // per-atom data is written as binary column blocks
+  // sorted by atom ID by default, so that IDs and coordinates delta-encode well
+
+  binary = 1;
+  buffer_allow = 0;
+  buffer_flag = 0;
+  if (atom->tag_enable) {
+    sort_flag = 1;
+    sortcol = 0;
+  }
+
+  codec = ColumnarFormat::default_codec();
+  level = ColumnarFormat::default_level(codec);
+  precision = fileprecision = 0.0;
+  for (double &b : framebox) b = 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   a single file gets its frame index appended before the base class closes it
+------------------------------------------------------------------------- */
+
+DumpColumnar::~DumpColumnar()
+{
+  if (multifile == 0 && filewriter && fp) write_index();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::init_style()
+{
+  if (append_flag) error->all(FLERR, "Dump columnar does not support dump_modify append yes");
+  if (!write_header_flag)
+    error->all(FLERR, "Dump columnar does not support dump_modify header no");
+
+  DumpCustom::init_style();
+}
+
+/* ----------------------------------------------------------------------
+   open file as in base class, then write file header with column layout
+   column encoding is fixed for each file:
+     integer columns are delta-encoded
+     unscaled coordinates are quantized and delta-encoded if precision > 0
+     all other columns are stored as raw doubles
+------------------------------------------------------------------------- */
+
+void DumpColumnar::openfile()
+{
+  if (singlefile_opened) return;
+
+  Dump::openfile();
+
+  index_step.clear();
+  index_offset.clear();
+
+  fileprecision = precision;
+  encoding.resize(nfield);
+  auto keys = utils::split_words(columns_default);
+  for (int i = 0; i < nfield; i++) {
+    if (vtype[i] != Dump::DOUBLE)
+      encoding[i] = ColumnarFormat::DELTA;
+    else if ((fileprecision > 0.0) && utils::strmatch(keys[i], "^[xyz]u?$"))
+      encoding[i] = ColumnarFormat::QUANT;
+    else
+      encoding[i] = ColumnarFormat::RAW;
+  }
+
+  if (filewriter) write_file_header();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::write_file_header()
+{
+  const int endian = ColumnarFormat::ENDIAN;
+  const int revision = ColumnarFormat::REVISION;
+
+  fwrite(ColumnarFormat::MAGIC, sizeof(char), ColumnarFormat::MAGICLEN, fp);
+  fwrite(&endian, sizeof(int), 1, fp);
+  fwrite(&revision, sizeof(int), 1, fp);
+  fwrite(&codec, sizeof(int), 1, fp);
+  fwrite(&nfield, sizeof(int), 1, fp);
+
+  auto labels = utils::split_words(columns);
+  for (int i = 0; i < nfield; i++) {
+    int len = labels[i].size();
+    fwrite(&len, sizeof(int), 1, fp);
+    fwrite(labels[i].c_str(), sizeof(char), len, fp);
+    fwrite(&vtype[i], sizeof(int), 1, fp);
+    fwrite(&encoding[i], sizeof(int), 1, fp);
+  }
+
+  fwrite(&fileprecision, sizeof(double), 1, fp);
+  int len = strlen(update->unit_style);
+  fwrite(&len, sizeof(int), 1, fp);
+  fwrite(update->unit_style, sizeof(char), len, fp);
+}
+
+/* ----------------------------------------------------------------------
+   store snapshot header info, frame is written once all atoms arrived
+   or right away for an empty snapshot
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_header(bigint ndump)
+{
+  nframe = ndump;
+  nrows = 0;
+
+  framebox[0] = boxxlo;
+  framebox[1] = boxxhi;
+  framebox[2] = boxylo;
+  framebox[3] = boxyhi;
+  framebox[4] = boxzlo;
+  framebox[5] = boxzhi;
+  framebox[6] = domain->triclinic ? boxxy : 0.0;
+  framebox[7] = domain->triclinic ? boxxz : 0.0;
+  framebox[8] = domain->triclinic ? boxyz : 0.0;
+  frametime = time_flag ? compute_time() : 0.0;
+
+  framebuf.resize(nframe * size_one);
+  if (nframe == 0) write_frame();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::write_data(int n, double *mybuf)
+{
+  if (nrows + n > nframe) error->one(FLERR, "Dump columnar received too many atoms");
+
+  std::copy(mybuf, mybuf + (bigint) n * size_one, framebuf.begin() + nrows * size_one);
+  nrows += n;
+  if (n && (nrows == nframe)) write_frame();
+}
+
+/* ----------------------------------------------------------------------
+   encode and compress each column of the snapshot, then write frame record
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_frame()
+{
+  const bigint offset = platform::ftell(fp);
+
+  // # of bytes after the size field: frame header plus column blocks
+
+  bigint nbytes = 2 * sizeof(bigint) + 8 * sizeof(int) + 10 * sizeof(double);
+
+  rawbuf.resize(nframe * sizeof(double));
+  colbuf.resize(size_one);
+  for (int i = 0; i < size_one; i++) {
+    ColumnarFormat::encode(framebuf.data() + i, nframe, size_one, encoding[i], fileprecision,
+                           rawbuf.data());
+    if (!ColumnarFormat::compress(codec, level, rawbuf.data(), rawbuf.size(), colbuf[i]))
+      error->one(FLERR, "Dump columnar could not compress column {} with {}", i + 1,
+                 ColumnarFormat::codec_name(codec));
+    nbytes += sizeof(bigint) + colbuf[i].size();
+  }
+
+  const int tag = ColumnarFormat::FRAME;
+  fwrite(&tag, sizeof(int), 1, fp);
+  fwrite(&nbytes, sizeof(bigint), 1, fp);
+  fwrite(&update->ntimestep, sizeof(bigint), 1, fp);
+  fwrite(&nframe, sizeof(bigint), 1, fp);
+  fwrite(&domain->triclinic, sizeof(int), 1, fp);
+  fwrite(&domain->boundary[0][0], sizeof(int), 6, fp);
+  fwrite(framebox, sizeof(double), 9, fp);
+  fwrite(&time_flag, sizeof(int), 1, fp);
+  fwrite(&frametime, sizeof(double), 1, fp);
+
+  for (int i = 0; i < size_one; i++) {
+    bigint ncol = colbuf[i].size();
+    fwrite(&ncol, sizeof(bigint), 1, fp);
+    fwrite(colbuf[i].data(), sizeof(unsigned char), ncol, fp);
+  }
+
+  index_step.push_back(update->ntimestep);
+  index_offset.push_back(offset);
+
+  // each file of a multi-file dump holds one frame and is complete now
+
+  if (multifile) write_index();
+}
+
+/* ----------------------------------------------------------------------
+   append frame index as trailer, so readers can seek to any timestep
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_index()
+{
+  const int tag = ColumnarFormat::INDEX;
+  const bigint nframes = index_step.size();
+
+  fwrite(&tag, sizeof(int), 1, fp);
+  fwrite(&nframes, sizeof(bigint), 1, fp);
+  for (bigint i = 0; i < nframes; i++) {
+    fwrite(&index_step[i], sizeof(bigint), 1, fp);
+    fwrite(&index_offset[i], sizeof(bigint), 1, fp);
+  }
+  fwrite(&nframes, sizeof(bigint), 1, fp);
+  fwrite(ColumnarFormat::INDEX_MAGIC, sizeof(char), ColumnarFormat::MAGICLEN, fp);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int DumpColumnar::modify_param(int narg, char **arg)
+{
+  int consumed = DumpCustom::modify_param(narg, arg);
+  if (consumed) return consumed;
+
+  if (strcmp(arg[0], "precision") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify precision", error);
+    precision = utils::numeric(FLERR, arg[1], false, lmp);
+    if (precision < 0.0) error->all(FLERR, "Illegal dump_modify precision value: {}", arg[1]);
+    return 2;
+
+  } else if (strcmp(arg[0], "compression_level") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify compression_level", error);
+    int min_level, max_level;
+    int newlevel = utils::inumeric(FLERR, arg[1], false, lmp);
+    if (!ColumnarFormat::check_level(codec, newlevel, min_level, max_level))
+      error->all(FLERR, "Dump_modify compression_level must be in the range of [{}, {}]",
+                 min_level, max_level);
+    level = newlevel;
+    return 2;
+  }
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+double DumpColumnar::memory_usage()
+{
+  double bytes = DumpCustom::memory_usage();
+  bytes += (double) framebuf.capacity() * sizeof(double);
+  bytes += (double) rawbuf.capacity();
+  for (const auto &block : colbuf) bytes += (double) block.capacity();
+  return bytes;
+}
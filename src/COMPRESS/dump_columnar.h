@@ -0,0 +1,69 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef DUMP_CLASS
+// clang-format off
+DumpStyle(columnar,DumpColumnar);
+// clang-format on
+#else
+
+#ifndef LMP_DUMP_COLUMNAR_H
+#define LMP_DUMP_COLUMNAR_H
+
+#include "dump_custom.h"
+
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class DumpColumnar : public DumpCustom {
+ public:
+  DumpColumnar(class LAMMPS *, int, char **);
+  ~DumpColumnar() override;
+
+ protected:
+  int codec;              // compression library of column blocks
+  int level;              // compression level
+  double precision;       // quantization of coordinates, 0.0 = lossless
+  double fileprecision;   // precision of the currently open file
+
+  std::vector<int> encoding;    // encoding of each column
+
+  bigint nframe;                   // # of atoms in current snapshot
+  bigint nrows;                    // # of atoms received so far
+  double framebox[9];              // box bounds and tilt of current snapshot
+  double frametime;                // simulation time of current snapshot
+  std::vector<double> framebuf;    // per-atom data of current snapshot
+
+  std::vector<unsigned char> rawbuf;                 // encoded column
+  std::vector<std::vector<unsigned char>> colbuf;    // compressed columns
+
+  std::vector<bigint> index_step;      // timestep of each frame in file
+  std::vector<bigint> index_offset;    // file offset of each frame in file
+
+  void init_style() override;
+  void openfile() override;
+  void write_header(bigint) override;
+  void write_data(int, double *) override;
+  int modify_param(int, char **) override;
+  double memory_usage() override;
+
+  void write_file_header();
+  void write_frame();
+  void write_index();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
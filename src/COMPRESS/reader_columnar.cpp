@@ -0,0 +1,370 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "reader_columnar.h"
+
+#include "columnar_format.h"
+#include "error.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+// also in read_dump.cpp
+
+enum{ID,TYPE,X,Y,Z,VX,VY,VZ,Q,IX,IY,IZ,FX,FY,FZ};
+enum{UNSET,NOSCALE_NOWRAP,NOSCALE_WRAP,SCALE_NOWRAP,SCALE_WRAP};
+
+static const char *fieldnames[] = {"id", "type", "x",  "y",  "z",  "vx", "vy", "vz",
+                                   "q",  "ix",   "iy", "iz", "fx", "fy", "fz"};
+
+/* ---------------------------------------------------------------------- */
+
+ReaderColumnar::ReaderColumnar(LAMMPS *lmp) :
+    Reader(lmp), codec(0), precision(0.0), ncol(0), frameend(0), natoms(0), iatom(0),
+    index_start(-1)
+{
+  binary = true;
+}
+
+/* ----------------------------------------------------------------------
+   open file, read file header and frame index trailer, if present
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::open_file(const std::string &file)
+{
+  if (fp != nullptr) close_file();
+
+  if (platform::has_compress_extension(file))
+    error->one(FLERR, "Columnar dump file {} must not be compressed externally", file);
+
+  compressed = false;
+  fp = fopen(file.c_str(), "rb");
+  if (!fp) error->one(FLERR, "Cannot open file {}: {}", file, utils::getsyserror());
+
+  read_file_header();
+  read_index();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ReaderColumnar::read_file_header()
+{
+  char magic[ColumnarFormat::MAGICLEN];
+  int endian, revision;
+
+  read_buf(magic, sizeof(char), ColumnarFormat::MAGICLEN);
+  if (memcmp(magic, ColumnarFormat::MAGIC, ColumnarFormat::MAGICLEN) != 0)
+    error->one(FLERR, "Dump file is not a columnar dump file");
+  read_buf(&endian, sizeof(int), 1);
+  if (endian != ColumnarFormat::ENDIAN)
+    error->one(FLERR, "Columnar dump file was written on a machine with different endianness");
+  read_buf(&revision, sizeof(int), 1);
+  if (revision > ColumnarFormat::REVISION)
+    error->one(FLERR, "Unsupported columnar dump file revision {}", revision);
+
+  read_buf(&codec, sizeof(int), 1);
+  if (!ColumnarFormat::has_codec(codec))
+    error->one(FLERR, "Columnar dump file uses {} compression, which is not available",
+               ColumnarFormat::codec_name(codec));
+
+  read_buf(&ncol, sizeof(int), 1);
+  if (ncol <= 0) error->one(FLERR, "Dump file is invalid or corrupted");
+
+  labels.clear();
+  encoding.resize(ncol);
+  int len, type;
+  for (int i = 0; i < ncol; i++) {
+    read_buf(&len, sizeof(int), 1);
+    if (len < 0) error->one(FLERR, "Dump file is invalid or corrupted");
+    std::string label(len, '\0');
+    read_buf(&label[0], sizeof(char), len);
+    labels[label] = i;
+    read_buf(&type, sizeof(int), 1);
+    read_buf(&encoding[i], sizeof(int), 1);
+  }
+
+  read_buf(&precision, sizeof(double), 1);
+
+  // skip over unit style
+
+  read_buf(&len, sizeof(int), 1);
+  if (len < 0) error->one(FLERR, "Dump file is invalid or corrupted");
+  platform::fseek(fp, platform::ftell(fp) + len);
+}
+
+/* ----------------------------------------------------------------------
+   load frame index from trailer at end of file
+   without trailer, e.g. from an interrupted run, frames are scanned in order
+   index is not used if timesteps do not increase, e.g. after reset_timestep
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::read_index()
+{
+  index_step.clear();
+  index_offset.clear();
+  index_start = -1;
+
+  const bigint start = platform::ftell(fp);
+  platform::fseek(fp, platform::END_OF_FILE);
+  const bigint size = platform::ftell(fp);
+
+  bigint nframes = -1;
+  char magic[ColumnarFormat::MAGICLEN];
+  const bigint minsize = sizeof(int) + sizeof(bigint) + ColumnarFormat::TRAILER;
+
+  if (size - start >= minsize) {
+    platform::fseek(fp, size - ColumnarFormat::TRAILER);
+    if ((fread(&nframes, sizeof(bigint), 1, fp) != 1) ||
+        (fread(magic, sizeof(char), ColumnarFormat::MAGICLEN, fp) != ColumnarFormat::MAGICLEN) ||
+        (memcmp(magic, ColumnarFormat::INDEX_MAGIC, ColumnarFormat::MAGICLEN) != 0) ||
+        (nframes < 0) || (2 * sizeof(bigint) * nframes > (size_t) (size - start - minsize)))
+      nframes = -1;
+  }
+
+  if (nframes > 0) {
+    std::vector<bigint> entries(2 * nframes);
+    const bigint first = size - ColumnarFormat::TRAILER - 2 * sizeof(bigint) * nframes;
+    platform::fseek(fp, first);
+    read_buf(entries.data(), sizeof(bigint), entries.size());
+    index_start = first - sizeof(bigint) - sizeof(int);
+
+    index_step.resize(nframes);
+    index_offset.resize(nframes);
+    for (bigint i = 0; i < nframes; i++) {
+      index_step[i] = entries[2 * i];
+      index_offset[i] = entries[2 * i + 1];
+    }
+
+    if (!std::is_sorted(index_step.begin(), index_step.end())) {
+      index_step.clear();
+      index_offset.clear();
+    }
+  }
+
+  platform::fseek(fp, start);
+}
+
+/* ----------------------------------------------------------------------
+   read and return time stamp from dump file
+   if first read reaches end-of-file or the index, return 1
+     so caller can open next file
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+int ReaderColumnar::read_time(bigint &ntimestep)
+{
+  int tag;
+  bigint nbytes;
+
+  if (fread(&tag, sizeof(int), 1, fp) != 1) return 1;
+  if (tag == ColumnarFormat::INDEX) return 1;
+  if (tag != ColumnarFormat::FRAME) error->one(FLERR, "Dump file is invalid or corrupted");
+
+  read_buf(&nbytes, sizeof(bigint), 1);
+  frameend = platform::ftell(fp) + nbytes;
+  read_buf(&ntimestep, sizeof(bigint), 1);
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   skip snapshot from timestamp onward
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::skip()
+{
+  platform::fseek(fp, frameend);
+}
+
+/* ----------------------------------------------------------------------
+   move forward to first frame with timestep >= Ntimestep using the index
+   next read_time() returns that frame or end-of-file
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::seek_time(bigint ntimestep)
+{
+  if (index_step.empty()) return;
+
+  auto it = std::lower_bound(index_step.begin(), index_step.end(), ntimestep);
+  bigint target = index_start;
+  if (it != index_step.end()) target = index_offset[it - index_step.begin()];
+  if (target > platform::ftell(fp)) platform::fseek(fp, target);
+}
+
+/* ----------------------------------------------------------------------
+   read remaining header info:
+     return natoms
+     box bounds, triclinic, fieldflag (1 if any fields not found),
+     xyz flags = UNSET (not a requested field), SCALE/WRAP as in enum
+   if fieldflag set:
+     match Nfield fields to per-atom column labels
+     set fieldindex = which column each field maps to
+     fieldtype = X,VX,IZ etc
+     fieldlabel = user-specified label or nullptr if use fieldtype default
+   xyz flags = scaleflag+wrapflag if has fieldlabel name,
+     else set by x,xs,xu,xsu
+   then decompress and decode the columns of all requested fields
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+bigint ReaderColumnar::read_header(double box[3][3], int &boxinfo, int &triclinic, int fieldinfo,
+                                   int nfield, int *fieldtype, char **fieldlabel, int scaleflag,
+                                   int wrapflag, int &fieldflag, int &xflag, int &yflag,
+                                   int &zflag)
+{
+  int boundary[3][2], timeflag;
+  double bounds[9], time;
+
+  read_buf(&natoms, sizeof(bigint), 1);
+  read_buf(&triclinic, sizeof(int), 1);
+  read_buf(&boundary[0][0], sizeof(int), 6);
+  read_buf(bounds, sizeof(double), 9);
+  read_buf(&timeflag, sizeof(int), 1);
+  read_buf(&time, sizeof(double), 1);
+
+  boxinfo = 1;
+  for (int i = 0; i < 3; i++) {
+    box[i][0] = bounds[2 * i];
+    box[i][1] = bounds[2 * i + 1];
+    box[i][2] = triclinic ? bounds[6 + i] : 0.0;
+  }
+
+  // match each field with a column of per-atom data
+  // if fieldlabel set, match with explicit column
+  // else infer one or more column matches from fieldtype
+  // xyz flag set by scaleflag + wrapflag (if fieldlabel set) or column label
+
+  if (fieldinfo) {
+    fieldindex.resize(nfield);
+    xflag = UNSET;
+    yflag = UNSET;
+    zflag = UNSET;
+
+    for (int i = 0; i < nfield; i++) {
+      if (fieldlabel[i]) {
+        fieldindex[i] = find_label(fieldlabel[i]);
+        if (fieldtype[i] == X) xflag = 2 * scaleflag + wrapflag + 1;
+        else if (fieldtype[i] == Y) yflag = 2 * scaleflag + wrapflag + 1;
+        else if (fieldtype[i] == Z) zflag = 2 * scaleflag + wrapflag + 1;
+      } else if (fieldtype[i] == X) {
+        fieldindex[i] = find_coord(0, xflag);
+      } else if (fieldtype[i] == Y) {
+        fieldindex[i] = find_coord(1, yflag);
+      } else if (fieldtype[i] == Z) {
+        fieldindex[i] = find_coord(2, zflag);
+      } else {
+        fieldindex[i] = find_label(fieldnames[fieldtype[i]]);
+      }
+    }
+
+    // set fieldflag = -1 if any unfound fields
+
+    fieldflag = 0;
+    for (int i = 0; i < nfield; i++)
+      if (fieldindex[i] < 0) fieldflag = -1;
+  }
+
+  // decode only the columns of requested fields, skip all others
+  // leave file positioned at end of frame for next read_time()
+
+  std::vector<bool> needed(ncol, false);
+  for (const auto &index : fieldindex)
+    if (index >= 0) needed[index] = true;
+
+  data.resize(ncol);
+  bigint nbytes;
+  for (int i = 0; i < ncol; i++) {
+    read_buf(&nbytes, sizeof(bigint), 1);
+    if (!needed[i]) {
+      platform::fseek(fp, platform::ftell(fp) + nbytes);
+      data[i].clear();
+      continue;
+    }
+
+    zbuf.resize(nbytes);
+    rawbuf.resize(natoms * sizeof(double));
+    data[i].resize(natoms);
+    read_buf(zbuf.data(), sizeof(unsigned char), nbytes);
+    if (!ColumnarFormat::decompress(codec, zbuf.data(), nbytes, rawbuf.data(), rawbuf.size()))
+      error->one(FLERR, "Columnar dump file column {} is invalid or corrupted", i + 1);
+    ColumnarFormat::decode(rawbuf.data(), natoms, encoding[i], precision, data[i].data());
+  }
+
+  platform::fseek(fp, frameend);
+  iatom = 0;
+  return natoms;
+}
+
+/* ----------------------------------------------------------------------
+   return N atoms from the decoded columns of the current frame
+   stores appropriate values in fields array
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::read_atoms(int n, int nfield, double **fields)
+{
+  if (iatom + n > natoms) error->one(FLERR, "Unexpected end of dump file");
+
+  for (int i = 0; i < n; i++) {
+    for (int m = 0; m < nfield; m++) fields[i][m] = data[fieldindex[m]][iatom];
+    iatom++;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   match label to any of the column labels
+   return index of match or -1 if no match
+------------------------------------------------------------------------- */
+
+int ReaderColumnar::find_label(const std::string &label)
+{
+  auto it = labels.find(label);
+  if (it != labels.end()) return it->second;
+  return -1;
+}
+
+/* ----------------------------------------------------------------------
+   match coordinate of dimension dim to x or else to the first of xs,xu,xsu
+   set flag for scaling and wrapping of the matched column
+------------------------------------------------------------------------- */
+
+int ReaderColumnar::find_coord(int dim, int &flag)
+{
+  const std::string name(1, "xyz"[dim]);
+
+  flag = NOSCALE_WRAP;
+  int index = find_label(name);
+  if (index >= 0) return index;
+
+  const std::pair<std::string, int> variants[] = {
+      {"s", SCALE_WRAP}, {"u", NOSCALE_NOWRAP}, {"su", SCALE_NOWRAP}};
+  for (const auto &variant : variants) {
+    int vindex = find_label(name + variant.first);
+    if ((vindex >= 0) && ((index < 0) || (vindex < index))) {
+      index = vindex;
+      flag = variant.second;
+    }
+  }
+  return index;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ReaderColumnar::read_buf(void *ptr, size_t size, size_t count)
+{
+  utils::sfread(FLERR, ptr, size, count, fp, nullptr, error);
+}
@@ -0,0 +1,74 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef READER_CLASS
+// clang-format off
+ReaderStyle(columnar,ReaderColumnar);
+// clang-format on
+#else
+
+#ifndef LMP_READER_COLUMNAR_H
+#define LMP_READER_COLUMNAR_H
+
+#include "reader.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class ReaderColumnar : public Reader {
+ public:
+  ReaderColumnar(class LAMMPS *);
+
+  int read_time(bigint &) override;
+  void skip() override;
+  void seek_time(bigint) override;
+  bigint read_header(double[3][3], int &, int &, int, int, int *, char **, int, int, int &, int &,
+                     int &, int &) override;
+  void read_atoms(int, int, double **) override;
+
+  void open_file(const std::string &) override;
+
+ private:
+  int codec;          // compression library of column blocks
+  double precision;   // quantization of coordinates
+
+  int ncol;                                // # of per-atom columns in dump file
+  std::map<std::string, int> labels;       // column index of each column label
+  std::vector<int> encoding;               // encoding of each column
+  std::vector<int> fieldindex;             // column of each requested field
+  std::vector<std::vector<double>> data;   // decoded requested columns of frame
+
+  bigint frameend;    // file offset of end of current frame
+  bigint natoms;      // # of atoms in current frame
+  bigint iatom;       // index of next atom to return from current frame
+
+  std::vector<unsigned char> zbuf, rawbuf;    // compressed and encoded column
+
+  std::vector<bigint> index_step;      // timestep of each frame, from index trailer
+  std::vector<bigint> index_offset;    // file offset of each frame
+  bigint index_start;                  // file offset of index record
+
+  int find_label(const std::string &);
+  int find_coord(int, int &);
+  void read_buf(void *, size_t, size_t);
+  void read_file_header();
+  void read_index();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -43,6 +43,7 @@ PairLJCutCoulLongCS::PairLJCutCoulLongCS(LAMMPS *lmp) : PairLJCutCoulLong(lmp)
 {
   ewaldflag = pppmflag = 1;
   respa_enable = 0;  // TODO: r-RESPA handling is inconsistent and thus disabled until fixed
+  cluster_enable = 0;
   single_enable = 0; // TODO: single function does not match compute
   writedata = 1;
   ftable = nullptr;
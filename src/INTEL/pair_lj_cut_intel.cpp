@@ -40,6 +40,8 @@ PairLJCutIntel::PairLJCutIntel(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::INTEL;
   respa_enable = 0;
+  overlap_enable = 0;
+  soa_enable = 0;
   cut_respa = nullptr;
 }
 
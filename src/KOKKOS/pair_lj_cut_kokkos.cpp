@@ -39,6 +39,8 @@ template<class DeviceType>
 PairLJCutKokkos<DeviceType>::PairLJCutKokkos(LAMMPS *lmp) : PairLJCut(lmp)
 {
   respa_enable = 0;
+  overlap_enable = 0;
+  soa_enable = 0;
 
   kokkosable = 1;
   atomKK = (AtomKokkos *) atom;
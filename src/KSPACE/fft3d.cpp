@@ -39,6 +39,10 @@
 #define MIN(A,B) ((A) < (B) ? (A) : (B))
 #define MAX(A,B) ((A) > (B) ? (A) : (B))
 
+static void fft_3d_pipelined(FFT_DATA *, FFT_DATA *, int, struct fft_plan_3d *);
+static void fft_1d_chunk(FFT_DATA *, int, int, int, struct fft_plan_3d *);
+static void fft_3d_scale(FFT_DATA *, struct fft_plan_3d *);
+
 /* ----------------------------------------------------------------------
    Data layout for 3d FFTs:
 
@@ -71,12 +75,16 @@
 
 void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 {
-  FFT_SCALAR norm;
-#if defined(FFT_FFTW3)
-  FFT_SCALAR *out_ptr;
-#endif
   FFT_DATA *data,*copy;
 
+  // remaps overlapped with 1d FFTs, chunk by chunk
+
+  if (plan->nchunk) {
+    fft_3d_pipelined(in,out,flag,plan);
+    if (flag == -1 && plan->scaled) fft_3d_scale(out,plan);
+    return;
+  }
+
   // system specific constants
 
 #if defined(FFT_FFTW3)
@@ -200,23 +208,163 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 
   // scaling if required
 
-  if (flag == -1 && plan->scaled) {
-    norm = plan->norm;
-    const int num = plan->normnum;
+  if (flag == -1 && plan->scaled) fft_3d_scale(out,plan);
+}
+
+/* ----------------------------------------------------------------------
+   Perform 3d FFT with remaps overlapped with 1d FFTs
+   the 1d FFTs ahead of each remap are done one chunk of planes at a time,
+     each chunk is sent as soon as it is transformed while the next
+     chunk is transformed, recvs complete after the last chunk is sent
+   same arguments as fft_3d()
+------------------------------------------------------------------------- */
+
+static void fft_3d_pipelined(FFT_DATA *in, FFT_DATA *out, int flag,
+                             struct fft_plan_3d *plan)
+{
+  int ichunk;
+  FFT_DATA *data,*copy;
+  FFT_SCALAR *scratch = (FFT_SCALAR *) plan->scratch;
+
+  // pre-remap to prepare for 1st FFTs if needed
+  // no FFTs to overlap with, but still uses non-blocking sends
+
+  if (plan->pre_plan) {
+    if (plan->pre_target == 0) copy = out;
+    else copy = plan->copy;
+    remap_3d((FFT_SCALAR *) in, (FFT_SCALAR *) copy, scratch, plan->pre_plan);
+    data = copy;
+  }
+  else
+    data = in;
+
+  // 1d FFTs along fast axis overlapped with 1st mid-remap
+
+  if (plan->mid1_target == 0) copy = out;
+  else copy = plan->copy;
+  remap_3d_begin(scratch,plan->mid1_plan);
+  for (ichunk = 0; ichunk < plan->nchunk; ichunk++) {
+    fft_1d_chunk(data,1,flag,ichunk,plan);
+    remap_3d_send((FFT_SCALAR *) data,scratch,ichunk,plan->mid1_plan);
+  }
+  remap_3d_end((FFT_SCALAR *) copy,scratch,plan->mid1_plan);
+  data = copy;
+
+  // 1d FFTs along mid axis overlapped with 2nd mid-remap
+
+  if (plan->mid2_target == 0) copy = out;
+  else copy = plan->copy;
+  remap_3d_begin(scratch,plan->mid2_plan);
+  for (ichunk = 0; ichunk < plan->nchunk; ichunk++) {
+    fft_1d_chunk(data,2,flag,ichunk,plan);
+    remap_3d_send((FFT_SCALAR *) data,scratch,ichunk,plan->mid2_plan);
+  }
+  remap_3d_end((FFT_SCALAR *) copy,scratch,plan->mid2_plan);
+  data = copy;
+
+  // 1d FFTs along slow axis overlapped with post-remap if needed
+
+  if (plan->post_plan) {
+    remap_3d_begin(scratch,plan->post_plan);
+    for (ichunk = 0; ichunk < plan->nchunk; ichunk++) {
+      fft_1d_chunk(data,3,flag,ichunk,plan);
+      remap_3d_send((FFT_SCALAR *) data,scratch,ichunk,plan->post_plan);
+    }
+    remap_3d_end((FFT_SCALAR *) out,scratch,plan->post_plan);
+  } else {
+    for (ichunk = 0; ichunk < plan->nchunk; ichunk++)
+      fft_1d_chunk(data,3,flag,ichunk,plan);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Perform one chunk of the 1st, 2nd, or 3rd set of 1d FFTs
+   planes are assigned to chunks the same way as in remap_3d_chunk()
+   a plane holds all 1d FFTs for one value of the slowest varying index
+------------------------------------------------------------------------- */
+
+static void fft_1d_chunk(FFT_DATA *data, int stage, int flag, int ichunk,
+                         struct fft_plan_3d *plan)
+{
+  int length,nplane,nline;
+
+  if (stage == 1) {
+    length = plan->length1;
+    nplane = plan->nplane1;
+    nline = plan->nline1;
+  } else if (stage == 2) {
+    length = plan->length2;
+    nplane = plan->nplane2;
+    nline = plan->nline2;
+  } else {
+    length = plan->length3;
+    nplane = plan->nplane3;
+    nline = plan->nline3;
+  }
+
+  const int iplanelo = ichunk*nplane/plan->nchunk;
+  const int iplanehi = (ichunk+1)*nplane/plan->nchunk;
+
+#if defined(FFT_MKL)
+  DFTI_DESCRIPTOR *handle;
+  if (stage == 1) handle = plan->handle_fast_plane;
+  else if (stage == 2) handle = plan->handle_mid_plane;
+  else handle = plan->handle_slow_plane;
+#elif defined(FFT_FFTW3)
+  FFTW_API(plan) theplan;
+  if (stage == 1)
+    theplan = (flag == 1) ? plan->plan_fast_forward_plane : plan->plan_fast_backward_plane;
+  else if (stage == 2)
+    theplan = (flag == 1) ? plan->plan_mid_forward_plane : plan->plan_mid_backward_plane;
+  else
+    theplan = (flag == 1) ? plan->plan_slow_forward_plane : plan->plan_slow_backward_plane;
+#else
+  kiss_fft_cfg cfg;
+  if (stage == 1)
+    cfg = (flag == 1) ? plan->cfg_fast_forward : plan->cfg_fast_backward;
+  else if (stage == 2)
+    cfg = (flag == 1) ? plan->cfg_mid_forward : plan->cfg_mid_backward;
+  else
+    cfg = (flag == 1) ? plan->cfg_slow_forward : plan->cfg_slow_backward;
+#endif
+
+  for (int iplane = iplanelo; iplane < iplanehi; iplane++) {
+    FFT_DATA *plane = &data[iplane*nline*length];
+#if defined(FFT_MKL)
+    if (flag == 1)
+      DftiComputeForward(handle,plane);
+    else
+      DftiComputeBackward(handle,plane);
+#elif defined(FFT_FFTW3)
+    FFTW_API(execute_dft)(theplan,plane,plane);
+#else
+    for (int offset = 0; offset < nline*length; offset += length)
+      kiss_fft(cfg,&plane[offset],&plane[offset]);
+#endif
+  }
+}
+
+/* ----------------------------------------------------------------------
+   scale result of backward 3d FFT
+------------------------------------------------------------------------- */
+
+static void fft_3d_scale(FFT_DATA *out, struct fft_plan_3d *plan)
+{
+  FFT_SCALAR norm = plan->norm;
+  const int num = plan->normnum;
 #if defined(FFT_FFTW3)
-    out_ptr = (FFT_SCALAR *)out;
+  FFT_SCALAR *out_ptr = (FFT_SCALAR *)out;
 #endif
-    for (int i = 0; i < num; i++) {
+  for (int i = 0; i < num; i++) {
 #if defined(FFT_FFTW3)
-      *(out_ptr++) *= norm;
-      *(out_ptr++) *= norm;
+    *(out_ptr++) *= norm;
+    *(out_ptr++) *= norm;
 #elif defined(FFT_MKL)
-      out[i] *= norm;
+    out[i] *= norm;
 #else  /* FFT_KISS */
-      out[i].re *= norm;
-      out[i].im *= norm;
+    out[i].re *= norm;
+    out[i].im *= norm;
 #endif
-    }
   }
 }
 
@@ -239,6 +387,10 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
                           2 = permute twice = slow->fast, fast->mid, mid->slow
    nbuf                 returns size of internal storage buffers used by FFT
    usecollective        use collective MPI operations for remapping data
+   nchunk               # of chunks to overlap remaps with 1d FFTs
+                          0 = no overlap, remaps use blocking sends
+                          N = split each set of 1d FFTs into N chunks
+                        ignored if usecollective is set
 ------------------------------------------------------------------------- */
 
 struct fft_plan_3d *fft_3d_create_plan(
@@ -247,7 +399,7 @@ struct fft_plan_3d *fft_3d_create_plan(
        int in_klo, int in_khi,
        int out_ilo, int out_ihi, int out_jlo, int out_jhi,
        int out_klo, int out_khi,
-       int scaled, int permute, int *nbuf, int usecollective)
+       int scaled, int permute, int *nbuf, int usecollective, int nchunk)
 {
   struct fft_plan_3d *plan;
   int me,nprocs,nthreads;
@@ -282,6 +434,11 @@ struct fft_plan_3d *fft_3d_create_plan(
   plan = (struct fft_plan_3d *) malloc(sizeof(struct fft_plan_3d));
   if (plan == nullptr) return nullptr;
 
+  // pipelined FFTs require point-to-point remaps
+
+  if (usecollective) nchunk = 0;
+  plan->nchunk = MAX(nchunk,0);
+
   // remap from initial distribution to layout needed for 1st set of 1d FFTs
   // not needed if all procs own entire fast axis initially
   // first indices = distribution after 1st set of FFTs
@@ -310,7 +467,8 @@ struct fft_plan_3d *fft_3d_create_plan(
     first_khi = (ip2+1)*nslow/np2 - 1;
     plan->pre_plan = remap_3d_create_plan(comm,in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
                                           first_ilo,first_ihi,first_jlo,first_jhi,
-                                          first_klo,first_khi,2,0,0,FFT_PRECISION,0);
+                                          first_klo,first_khi,2,0,0,FFT_PRECISION,0,
+                                          MIN(plan->nchunk,1));
     if (plan->pre_plan == nullptr) return nullptr;
   }
 
@@ -318,6 +476,8 @@ struct fft_plan_3d *fft_3d_create_plan(
 
   plan->length1 = nfast;
   plan->total1 = nfast * (first_jhi-first_jlo+1) * (first_khi-first_klo+1);
+  plan->nline1 = MAX(first_jhi-first_jlo+1,0);
+  plan->nplane1 = plan->nline1 ? MAX(first_khi-first_klo+1,0) : 0;
 
   // remap from 1st to 2nd FFT
   // choose which axis is split over np1 vs np2 to minimize communication
@@ -332,13 +492,15 @@ struct fft_plan_3d *fft_3d_create_plan(
   plan->mid1_plan = remap_3d_create_plan(comm, first_ilo,first_ihi,first_jlo,first_jhi,
                                          first_klo,first_khi,second_ilo,second_ihi,
                                          second_jlo,second_jhi,second_klo,second_khi,
-                                         2,1,0,FFT_PRECISION,usecollective);
+                                         2,1,0,FFT_PRECISION,usecollective,plan->nchunk);
   if (plan->mid1_plan == nullptr) return nullptr;
 
   // 1d FFTs along mid axis
 
   plan->length2 = nmid;
   plan->total2 = (second_ihi-second_ilo+1) * nmid * (second_khi-second_klo+1);
+  plan->nline2 = MAX(second_khi-second_klo+1,0);
+  plan->nplane2 = plan->nline2 ? MAX(second_ihi-second_ilo+1,0) : 0;
 
   // remap from 2nd to 3rd FFT
   // if final distribution is permute=2 with all procs owning entire slow axis
@@ -373,13 +535,16 @@ struct fft_plan_3d *fft_3d_create_plan(
                          second_jlo,second_jhi,second_klo,second_khi,
                          second_ilo,second_ihi,
                          third_jlo,third_jhi,third_klo,third_khi,
-                         third_ilo,third_ihi,2,1,0,FFT_PRECISION,usecollective);
+                         third_ilo,third_ihi,2,1,0,FFT_PRECISION,usecollective,
+                         plan->nchunk);
   if (plan->mid2_plan == nullptr) return nullptr;
 
   // 1d FFTs along slow axis
 
   plan->length3 = nslow;
   plan->total3 = (third_ihi-third_ilo+1) * (third_jhi-third_jlo+1) * nslow;
+  plan->nline3 = MAX(third_ihi-third_ilo+1,0);
+  plan->nplane3 = plan->nline3 ? MAX(third_jhi-third_jlo+1,0) : 0;
 
   // remap from 3rd FFT to final distribution
   //  not needed if permute = 2 and third indices = out indices on all procs
@@ -402,7 +567,8 @@ struct fft_plan_3d *fft_3d_create_plan(
                            third_klo,third_khi,third_ilo,third_ihi,
                            third_jlo,third_jhi,
                            out_klo,out_khi,out_ilo,out_ihi,
-                           out_jlo,out_jhi,2,(permute+1)%3,0,FFT_PRECISION,0);
+                           out_jlo,out_jhi,2,(permute+1)%3,0,FFT_PRECISION,0,
+                           plan->nchunk);
     if (plan->post_plan == nullptr) return nullptr;
   }
 
@@ -514,6 +680,46 @@ struct fft_plan_3d *fft_3d_create_plan(
 #endif
   DftiCommitDescriptor(plan->handle_slow);
 
+  // descriptors for one plane of 1d FFTs each when pipelined
+
+  if (plan->nchunk) {
+    DftiCreateDescriptor( &(plan->handle_fast_plane), FFT_MKL_PREC, DFTI_COMPLEX, 1,
+                          (MKL_LONG)nfast);
+    DftiSetValue(plan->handle_fast_plane, DFTI_NUMBER_OF_TRANSFORMS,
+                 (MKL_LONG)MAX(plan->nline1,1));
+    DftiSetValue(plan->handle_fast_plane, DFTI_PLACEMENT,DFTI_INPLACE);
+    DftiSetValue(plan->handle_fast_plane, DFTI_INPUT_DISTANCE, (MKL_LONG)nfast);
+    DftiSetValue(plan->handle_fast_plane, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nfast);
+#if defined(FFT_MKL_THREADS)
+    DftiSetValue(plan->handle_fast_plane, DFTI_NUMBER_OF_USER_THREADS, nthreads);
+#endif
+    DftiCommitDescriptor(plan->handle_fast_plane);
+
+    DftiCreateDescriptor( &(plan->handle_mid_plane), FFT_MKL_PREC, DFTI_COMPLEX, 1,
+                          (MKL_LONG)nmid);
+    DftiSetValue(plan->handle_mid_plane, DFTI_NUMBER_OF_TRANSFORMS,
+                 (MKL_LONG)MAX(plan->nline2,1));
+    DftiSetValue(plan->handle_mid_plane, DFTI_PLACEMENT,DFTI_INPLACE);
+    DftiSetValue(plan->handle_mid_plane, DFTI_INPUT_DISTANCE, (MKL_LONG)nmid);
+    DftiSetValue(plan->handle_mid_plane, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nmid);
+#if defined(FFT_MKL_THREADS)
+    DftiSetValue(plan->handle_mid_plane, DFTI_NUMBER_OF_USER_THREADS, nthreads);
+#endif
+    DftiCommitDescriptor(plan->handle_mid_plane);
+
+    DftiCreateDescriptor( &(plan->handle_slow_plane), FFT_MKL_PREC, DFTI_COMPLEX, 1,
+                          (MKL_LONG)nslow);
+    DftiSetValue(plan->handle_slow_plane, DFTI_NUMBER_OF_TRANSFORMS,
+                 (MKL_LONG)MAX(plan->nline3,1));
+    DftiSetValue(plan->handle_slow_plane, DFTI_PLACEMENT,DFTI_INPLACE);
+    DftiSetValue(plan->handle_slow_plane, DFTI_INPUT_DISTANCE, (MKL_LONG)nslow);
+    DftiSetValue(plan->handle_slow_plane, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nslow);
+#if defined(FFT_MKL_THREADS)
+    DftiSetValue(plan->handle_slow_plane, DFTI_NUMBER_OF_USER_THREADS, nthreads);
+#endif
+    DftiCommitDescriptor(plan->handle_slow_plane);
+  }
+
 #elif defined(FFT_FFTW3)
 #if defined(FFT_FFTW_THREADS)
   if (nthreads > 1) {
@@ -553,6 +759,47 @@ struct fft_plan_3d *fft_3d_create_plan(
                             nullptr,&nslow,1,plan->length3,
                             FFTW_BACKWARD,FFTW_ESTIMATE);
 
+  // plans for one plane of 1d FFTs each when pipelined
+  // planes start at arbitrary offsets, so plans must not assume alignment
+
+  if (plan->nchunk) {
+    int nline;
+
+    nline = MAX(plan->nline1,1);
+    plan->plan_fast_forward_plane =
+      FFTW_API(plan_many_dft)(1, &nfast,nline,
+                              nullptr,&nfast,1,plan->length1,
+                              nullptr,&nfast,1,plan->length1,
+                              FFTW_FORWARD,FFTW_ESTIMATE | FFTW_UNALIGNED);
+    plan->plan_fast_backward_plane =
+      FFTW_API(plan_many_dft)(1, &nfast,nline,
+                              nullptr,&nfast,1,plan->length1,
+                              nullptr,&nfast,1,plan->length1,
+                              FFTW_BACKWARD,FFTW_ESTIMATE | FFTW_UNALIGNED);
+    nline = MAX(plan->nline2,1);
+    plan->plan_mid_forward_plane =
+      FFTW_API(plan_many_dft)(1, &nmid,nline,
+                              nullptr,&nmid,1,plan->length2,
+                              nullptr,&nmid,1,plan->length2,
+                              FFTW_FORWARD,FFTW_ESTIMATE | FFTW_UNALIGNED);
+    plan->plan_mid_backward_plane =
+      FFTW_API(plan_many_dft)(1, &nmid,nline,
+                              nullptr,&nmid,1,plan->length2,
+                              nullptr,&nmid,1,plan->length2,
+                              FFTW_BACKWARD,FFTW_ESTIMATE | FFTW_UNALIGNED);
+    nline = MAX(plan->nline3,1);
+    plan->plan_slow_forward_plane =
+      FFTW_API(plan_many_dft)(1, &nslow,nline,
+                              nullptr,&nslow,1,plan->length3,
+                              nullptr,&nslow,1,plan->length3,
+                              FFTW_FORWARD,FFTW_ESTIMATE | FFTW_UNALIGNED);
+    plan->plan_slow_backward_plane =
+      FFTW_API(plan_many_dft)(1, &nslow,nline,
+                              nullptr,&nslow,1,plan->length3,
+                              nullptr,&nslow,1,plan->length3,
+                              FFTW_BACKWARD,FFTW_ESTIMATE | FFTW_UNALIGNED);
+  }
+
 #else /* FFT_KISS */
 
   plan->cfg_fast_forward = kiss_fft_alloc(nfast,0,nullptr,nullptr);
@@ -612,6 +859,11 @@ void fft_3d_destroy_plan(struct fft_plan_3d *plan)
   DftiFreeDescriptor(&(plan->handle_fast));
   DftiFreeDescriptor(&(plan->handle_mid));
   DftiFreeDescriptor(&(plan->handle_slow));
+  if (plan->nchunk) {
+    DftiFreeDescriptor(&(plan->handle_fast_plane));
+    DftiFreeDescriptor(&(plan->handle_mid_plane));
+    DftiFreeDescriptor(&(plan->handle_slow_plane));
+  }
 #elif defined(FFT_FFTW3)
   FFTW_API(destroy_plan)(plan->plan_slow_forward);
   FFTW_API(destroy_plan)(plan->plan_slow_backward);
@@ -619,6 +871,14 @@ void fft_3d_destroy_plan(struct fft_plan_3d *plan)
   FFTW_API(destroy_plan)(plan->plan_mid_backward);
   FFTW_API(destroy_plan)(plan->plan_fast_forward);
   FFTW_API(destroy_plan)(plan->plan_fast_backward);
+  if (plan->nchunk) {
+    FFTW_API(destroy_plan)(plan->plan_slow_forward_plane);
+    FFTW_API(destroy_plan)(plan->plan_slow_backward_plane);
+    FFTW_API(destroy_plan)(plan->plan_mid_forward_plane);
+    FFTW_API(destroy_plan)(plan->plan_mid_backward_plane);
+    FFTW_API(destroy_plan)(plan->plan_fast_forward_plane);
+    FFTW_API(destroy_plan)(plan->plan_fast_backward_plane);
+  }
 #if defined(FFT_FFTW_THREADS)
   FFTW_API(cleanup_threads)();
 #endif
@@ -119,12 +119,18 @@ struct fft_plan_3d {
   int scaled;     // whether to scale FFT results
   int normnum;    // # of values to rescale
   double norm;    // normalization factor for rescaling
+  int nchunk;                         // # of chunks of pipelined FFTs, 0 = not pipelined
+  int nplane1, nplane2, nplane3;      // # of planes of 1st,2nd,3rd FFTs split into chunks
+  int nline1, nline2, nline3;         // # of 1st,2nd,3rd FFTs in one plane
 
   // system specific 1d FFT info
 #if defined(FFT_MKL)
   DFTI_DESCRIPTOR *handle_fast;
   DFTI_DESCRIPTOR *handle_mid;
   DFTI_DESCRIPTOR *handle_slow;
+  DFTI_DESCRIPTOR *handle_fast_plane;
+  DFTI_DESCRIPTOR *handle_mid_plane;
+  DFTI_DESCRIPTOR *handle_slow_plane;
 #elif defined(FFT_FFTW3)
   FFTW_API(plan) plan_fast_forward;
   FFTW_API(plan) plan_fast_backward;
@@ -132,6 +138,12 @@ struct fft_plan_3d {
   FFTW_API(plan) plan_mid_backward;
   FFTW_API(plan) plan_slow_forward;
   FFTW_API(plan) plan_slow_backward;
+  FFTW_API(plan) plan_fast_forward_plane;
+  FFTW_API(plan) plan_fast_backward_plane;
+  FFTW_API(plan) plan_mid_forward_plane;
+  FFTW_API(plan) plan_mid_backward_plane;
+  FFTW_API(plan) plan_slow_forward_plane;
+  FFTW_API(plan) plan_slow_backward_plane;
 #elif defined(FFT_KISS)
   kiss_fft_cfg cfg_fast_forward;
   kiss_fft_cfg cfg_fast_backward;
@@ -147,7 +159,7 @@ struct fft_plan_3d {
 extern "C" {
 void fft_3d(FFT_DATA *, FFT_DATA *, int, struct fft_plan_3d *);
 struct fft_plan_3d *fft_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int, int,
-                                       int, int, int, int, int, int, int, int *, int);
+                                       int, int, int, int, int, int, int, int *, int, int);
 void fft_3d_destroy_plan(struct fft_plan_3d *);
 void factor(int, int *, int *);
 void bifactor(int, int *, int *);
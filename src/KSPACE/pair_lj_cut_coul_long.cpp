@@ -50,6 +50,7 @@ PairLJCutCoulLong::PairLJCutCoulLong(LAMMPS *lmp) : Pair(lmp)
 {
   ewaldflag = pppmflag = 1;
   respa_enable = 1;
+  cluster_enable = 1;
   writedata = 1;
   ftable = nullptr;
   qdist = 0.0;
@@ -94,6 +95,22 @@ void PairLJCutCoulLong::compute(int eflag, int vflag)
   evdwl = ecoul = 0.0;
   ev_init(eflag,vflag);
 
+  // cluster pair list from neighbor style cluster
+
+  if (list->cluster == 8) {
+    if (evflag) {
+      if (eflag) eval_cluster<1,1,8>();
+      else eval_cluster<1,0,8>();
+    } else eval_cluster<0,0,8>();
+    return;
+  } else if (list->cluster) {
+    if (evflag) {
+      if (eflag) eval_cluster<1,1,4>();
+      else eval_cluster<1,0,4>();
+    } else eval_cluster<0,0,4>();
+    return;
+  }
+
   double **x = atom->x;
   double **f = atom->f;
   double *q = atom->q;
@@ -205,6 +222,154 @@ void PairLJCutCoulLong::compute(int eflag, int vflag)
   if (vflag_fdotr) virial_fdotr_compute();
 }
 
+/* ----------------------------------------------------------------------
+   compute forces from a cluster pair list, always with newton on
+   cluster lists only exist for atomic systems, so no special bonds
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG, int CLUSTERSIZE>
+void PairLJCutCoulLong::eval_cluster()
+{
+  constexpr int CS = CLUSTERSIZE;
+  int itable;
+  double r,r2inv,r6inv,forcecoul,forcelj,fpair,prefactor,grij,expm2,t,erfc;
+  double fraction,table;
+  double evdwl = 0.0;
+  double ecoul = 0.0;
+
+  double **f = atom->f;
+  double *q = atom->q;
+  const int nlocal = atom->nlocal;
+  const double qqrd2e = force->qqrd2e;
+
+  list->pack_cluster_x();
+
+  const int nclocal = list->nclocal;
+  const double * _noalias const xcluster = list->xcluster;
+  const int * _noalias const clusteratom = list->clusteratom;
+  const int * _noalias const clustertype = list->clustertype;
+  const int * _noalias const firstcj = list->firstcj;
+  const int * _noalias const numcj = list->numcj;
+  const int * _noalias const cjlist = list->cjlist;
+  const uint64_t * _noalias const cjmask = list->cjmask;
+
+  for (int ci = 0; ci < nclocal; ci++) {
+    const double * _noalias const xi = &xcluster[3*CS*ci];
+    const int * const iatom = &clusteratom[CS*ci];
+    const int * const itype = &clustertype[CS*ci];
+
+    double qi[CS],fxi[CS],fyi[CS],fzi[CS];
+    for (int ii = 0; ii < CS; ii++) {
+      qi[ii] = (iatom[ii] >= 0) ? q[iatom[ii]] : 0.0;
+      fxi[ii] = fyi[ii] = fzi[ii] = 0.0;
+    }
+
+    const int kfirst = firstcj[ci];
+    const int klast = kfirst + numcj[ci];
+
+    for (int k = kfirst; k < klast; k++) {
+      const int cj = cjlist[k];
+      const uint64_t mask = cjmask[k];
+      const double * _noalias const xj = &xcluster[3*CS*cj];
+      const int * const jatom = &clusteratom[CS*cj];
+      const int * const jtype = &clustertype[CS*cj];
+
+      double qj[CS],fxj[CS],fyj[CS],fzj[CS];
+      for (int jj = 0; jj < CS; jj++) {
+        qj[jj] = (jatom[jj] >= 0) ? q[jatom[jj]] : 0.0;
+        fxj[jj] = fyj[jj] = fzj[jj] = 0.0;
+      }
+
+      for (int ii = 0; ii < CS; ii++) {
+        const int it = itype[ii];
+
+        for (int jj = 0; jj < CS; jj++) {
+          if (!((mask >> (ii*CS + jj)) & 1)) continue;
+
+          const double delx = xi[ii] - xj[jj];
+          const double dely = xi[CS+ii] - xj[CS+jj];
+          const double delz = xi[2*CS+ii] - xj[2*CS+jj];
+          const double rsq = delx*delx + dely*dely + delz*delz;
+          const int jt = jtype[jj];
+          if (rsq >= cutsq[it][jt]) continue;
+
+          r2inv = 1.0/rsq;
+
+          if (rsq < cut_coulsq) {
+            if (!ncoultablebits || rsq <= tabinnersq) {
+              r = sqrt(rsq);
+              grij = g_ewald * r;
+              expm2 = exp(-grij*grij);
+              t = 1.0 / (1.0 + EWALD_P*grij);
+              erfc = t * (A1+t*(A2+t*(A3+t*(A4+t*A5)))) * expm2;
+              prefactor = qqrd2e * qi[ii]*qj[jj]/r;
+              forcecoul = prefactor * (erfc + EWALD_F*grij*expm2);
+            } else {
+              union_int_float_t rsq_lookup;
+              rsq_lookup.f = rsq;
+              itable = rsq_lookup.i & ncoulmask;
+              itable >>= ncoulshiftbits;
+              fraction = (rsq_lookup.f - rtable[itable]) * drtable[itable];
+              table = ftable[itable] + fraction*dftable[itable];
+              forcecoul = qi[ii]*qj[jj] * table;
+            }
+          } else forcecoul = 0.0;
+
+          if (rsq < cut_ljsq[it][jt]) {
+            r6inv = r2inv*r2inv*r2inv;
+            forcelj = r6inv * (lj1[it][jt]*r6inv - lj2[it][jt]);
+          } else forcelj = 0.0;
+
+          fpair = (forcecoul + forcelj) * r2inv;
+
+          fxi[ii] += delx*fpair;
+          fyi[ii] += dely*fpair;
+          fzi[ii] += delz*fpair;
+          fxj[jj] -= delx*fpair;
+          fyj[jj] -= dely*fpair;
+          fzj[jj] -= delz*fpair;
+
+          if (EFLAG) {
+            if (rsq < cut_coulsq) {
+              if (!ncoultablebits || rsq <= tabinnersq)
+                ecoul = prefactor*erfc;
+              else {
+                table = etable[itable] + fraction*detable[itable];
+                ecoul = qi[ii]*qj[jj] * table;
+              }
+            } else ecoul = 0.0;
+
+            if (rsq < cut_ljsq[it][jt]) {
+              evdwl = r6inv*(lj3[it][jt]*r6inv-lj4[it][jt]) - offset[it][jt];
+            } else evdwl = 0.0;
+          }
+
+          if (EVFLAG) ev_tally(iatom[ii],jatom[jj],nlocal,1,
+                               evdwl,ecoul,fpair,delx,dely,delz);
+        }
+      }
+
+      for (int jj = 0; jj < CS; jj++) {
+        const int j = jatom[jj];
+        if (j < 0) continue;
+        f[j][0] += fxj[jj];
+        f[j][1] += fyj[jj];
+        f[j][2] += fzj[jj];
+      }
+    }
+
+    for (int ii = 0; ii < CS; ii++) {
+      const int i = iatom[ii];
+      if (i < 0) continue;
+      f[i][0] += fxi[ii];
+      f[i][1] += fyi[ii];
+      f[i][2] += fzi[ii];
+    }
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
 /* ---------------------------------------------------------------------- */
 
 void PairLJCutCoulLong::compute_inner()
@@ -662,6 +827,7 @@ void PairLJCutCoulLong::init_style()
     if (respa->level_inner >= 0) list_style = NeighConst::REQ_RESPA_INOUT;
     if (respa->level_middle >= 0) list_style = NeighConst::REQ_RESPA_ALL;
   }
+  if (cluster_enable) list_style |= NeighConst::REQ_CLUSTER;
   neighbor->add_request(this, list_style);
 
   cut_coulsq = cut_coul * cut_coul;
@@ -58,6 +58,8 @@ class PairLJCutCoulLong : public Pair {
   double g_ewald;
 
   virtual void allocate();
+
+  template <int EVFLAG, int EFLAG, int CLUSTERSIZE> void eval_cluster();
 };
 
 }    // namespace LAMMPS_NS
@@ -34,6 +34,7 @@ PairLJCutCoulMSM::PairLJCutCoulMSM(LAMMPS *lmp) : PairLJCutCoulLong(lmp)
 {
   ewaldflag = pppmflag = 0;
   msmflag = 1;
+  cluster_enable = 0;
   nmax = 0;
   ftmp = nullptr;
 }
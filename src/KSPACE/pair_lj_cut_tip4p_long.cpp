@@ -50,6 +50,7 @@ PairLJCutTIP4PLong::PairLJCutTIP4PLong(LAMMPS *lmp) :
 {
   tip4pflag = 1;
   ewaldflag = pppmflag = 1;  // for clarity, though inherited from parent class
+  cluster_enable = 0;
 
   single_enable = 0;
   respa_enable = 0;
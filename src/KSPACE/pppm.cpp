@@ -37,6 +37,7 @@
 #include "pair.h"
 #include "remap_wrap.h"
 
+#include <cfloat>
 #include <cmath>
 #include <cstring>
 
@@ -330,6 +331,13 @@ void PPPM::init()
 
   double estimated_accuracy = final_accuracy();
 
+  // with single precision FFTs, round-off may exceed the requested accuracy
+
+  double df_fft = estimate_fft_error();
+  if ((df_fft > accuracy) && (me == 0))
+    error->warning(FLERR,"PPPM accuracy limited by single precision FFTs: "
+                   "estimated round-off {:.8g} > requested accuracy {:.8g}",df_fft,accuracy);
+
   // print stats
 
   int ngrid_max,nfft_both_max;
@@ -797,17 +805,17 @@ void PPPM::allocate()
   fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,pipeline);
 
   fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,pipeline);
 
   remap = new Remap(lmp,world,
                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                    1,0,0,FFT_PRECISION,collective_flag);
+                    1,0,0,FFT_PRECISION,collective_flag,pipeline ? 1 : 0);
 
   // create ghost grid object for rho and electric field communication
   // also create 2 bufs for ghost grid cell comm, passed to GridComm methods
@@ -1301,12 +1309,33 @@ double PPPM::final_accuracy()
   double q2_over_sqrt = q2 / sqrt(natoms*cutoff*xprd*yprd*zprd);
   double df_rspace = 2.0 * q2_over_sqrt * exp(-g_ewald*g_ewald*cutoff*cutoff);
   double df_table = estimate_table_accuracy(q2_over_sqrt,df_rspace);
+  double df_fft = estimate_fft_error();
   double estimated_accuracy = sqrt(df_kspace*df_kspace + df_rspace*df_rspace +
-                                   df_table*df_table);
+                                   df_table*df_table + df_fft*df_fft);
 
   return estimated_accuracy;
 }
 
+/* ----------------------------------------------------------------------
+   estimate round-off error of single precision grids and FFTs
+   relative FFT round-off grows as sqrt of log2 of # of grid points,
+   RMS KSpace force on a charge is of order q2 g_ewald^2 / natoms
+   zero for double precision FFTs
+------------------------------------------------------------------------- */
+
+double PPPM::estimate_fft_error()
+{
+#ifdef FFT_SINGLE
+  bigint natoms = atom->natoms;
+  if (natoms == 0) natoms = 1; // avoid division by zero
+
+  double ngrid_all = (double) nx_pppm * ny_pppm * nz_pppm;
+  return FLT_EPSILON * sqrt(log2(ngrid_all)) * q2 * g_ewald*g_ewald / natoms;
+#else
+  return 0.0;
+#endif
+}
+
 /* ----------------------------------------------------------------------
    set local subset of PPPM/FFT grid that I own
    n xyz lo/hi in = 3d brick that I own (inclusive)
@@ -1885,6 +1914,8 @@ void PPPM::particle_map()
   }
 
   if (flag) error->one(FLERR,"Out of range atoms - cannot compute PPPM");
+
+  tile_sort(part2grid,nlower,nupper,nylo_out,nyhi_out,nzlo_out,nzhi_out);
 }
 
 /* ----------------------------------------------------------------------
@@ -1904,7 +1935,7 @@ void PPPM::make_rho()
   memset(&(density_brick[nzlo_out][nylo_out][nxlo_out]),0,
          ngrid*sizeof(FFT_SCALAR));
 
-  // loop over my charges, add their contribution to nearby grid points
+  // loop over my charges in tile order, add their contribution to nearby grid points
   // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
   // (dx,dy,dz) = distance to "lower left" grid pt
   // (mx,my,mz) = global coords of moving stencil pt
@@ -1913,7 +1944,8 @@ void PPPM::make_rho()
   double **x = atom->x;
   int nlocal = atom->nlocal;
 
-  for (int i = 0; i < nlocal; i++) {
+  for (int ii = 0; ii < nlocal; ii++) {
+    const int i = tile_order[ii];
 
     nx = part2grid[i][0];
     ny = part2grid[i][1];
@@ -2398,9 +2430,9 @@ void PPPM::fieldforce()
 
 void PPPM::fieldforce_ik()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
-  FFT_SCALAR ekx,eky,ekz;
+  double ekx,eky,ekz;
 
   // loop over my charges, interpolate electric field from nearby grid points
   // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
@@ -2414,7 +2446,8 @@ void PPPM::fieldforce_ik()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -2456,9 +2489,9 @@ void PPPM::fieldforce_ik()
 
 void PPPM::fieldforce_ad()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz;
-  FFT_SCALAR ekx,eky,ekz;
+  double ekx,eky,ekz;
   double s1,s2,s3;
   double sf = 0.0;
   double *prd;
@@ -2484,7 +2517,8 @@ void PPPM::fieldforce_ad()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -2543,9 +2577,9 @@ void PPPM::fieldforce_ad()
 
 void PPPM::fieldforce_peratom()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
-  FFT_SCALAR u,v0,v1,v2,v3,v4,v5;
+  double u,v0,v1,v2,v3,v4,v5;
 
   // loop over my charges, interpolate from nearby grid points
   // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
@@ -2557,7 +2591,8 @@ void PPPM::fieldforce_peratom()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -3033,6 +3068,7 @@ int PPPM::timing_3d(int n, double &time3d)
 double PPPM::memory_usage()
 {
   double bytes = (double)nmax*3 * sizeof(double);
+  bytes += (double)(maxtile_order + maxtile_start) * sizeof(int);
 
   int nbrick = (nxhi_out-nxlo_out+1) * (nyhi_out-nylo_out+1) *
     (nzhi_out-nzlo_out+1);
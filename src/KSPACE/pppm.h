@@ -134,6 +134,7 @@ class PPPM : public KSpace {
   int factorable(int);
   virtual double compute_df_kspace();
   double estimate_ik_error(double, double, bigint);
+  double estimate_fft_error();
   virtual double compute_qopt();
   virtual void compute_gf_denom();
   virtual void compute_gf_ik();
@@ -590,17 +590,17 @@ void PPPMDipole::allocate()
   fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,pipeline);
 
   fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,pipeline);
 
   remap = new Remap(lmp,world,
                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                    1,0,0,FFT_PRECISION,collective_flag);
+                    1,0,0,FFT_PRECISION,collective_flag,pipeline ? 1 : 0);
 
   // create ghost grid object for rho and electric field communication
   // also create 2 bufs for ghost grid cell comm, passed to GridComm methods
@@ -1198,7 +1198,7 @@ void PPPMDipole::make_rho_dipole()
   memset(&(densityz_brick_dipole[nzlo_out][nylo_out][nxlo_out]),0,
          ngrid*sizeof(FFT_SCALAR));
 
-  // loop over my charges, add their contribution to nearby grid points
+  // loop over my dipoles in tile order, add their contribution to nearby grid points
   // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
   // (dx,dy,dz) = distance to "lower left" grid pt
   // (mx,my,mz) = global coords of moving stencil pt
@@ -1207,7 +1207,8 @@ void PPPMDipole::make_rho_dipole()
   double **x = atom->x;
   int nlocal = atom->nlocal;
 
-  for (int i = 0; i < nlocal; i++) {
+  for (int ii = 0; ii < nlocal; ii++) {
+    const int i = tile_order[ii];
 
     nx = part2grid[i][0];
     ny = part2grid[i][1];
@@ -2030,7 +2031,7 @@ void PPPMDipole::poisson_peratom_dipole()
 
 void PPPMDipole::fieldforce_ik_dipole()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz;
   FFT_SCALAR x0,y0,z0;
   FFT_SCALAR ex,ey,ez;
@@ -2048,7 +2049,8 @@ void PPPMDipole::fieldforce_ik_dipole()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -2101,7 +2103,7 @@ void PPPMDipole::fieldforce_ik_dipole()
 
 void PPPMDipole::fieldforce_peratom_dipole()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR ux,uy,uz;
   FFT_SCALAR v0x,v1x,v2x,v3x,v4x,v5x;
@@ -2118,7 +2120,8 @@ void PPPMDipole::fieldforce_peratom_dipole()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -2507,6 +2510,7 @@ int PPPMDipole::timing_3d(int n, double &time3d)
 double PPPMDipole::memory_usage()
 {
   double bytes = (double)nmax*3 * sizeof(double);
+  bytes += (double)(maxtile_order + maxtile_start) * sizeof(int);
 
   int nbrick = (nxhi_out-nxlo_out+1) * (nyhi_out-nylo_out+1) *
     (nzhi_out-nzlo_out+1);
@@ -1735,17 +1735,17 @@ void _noopt PPPMDisp::allocate()
     fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                      nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                      nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                     0,0,&tmp,collective_flag);
+                     0,0,&tmp,collective_flag,pipeline);
 
     fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                      nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                      nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                     0,0,&tmp,collective_flag);
+                     0,0,&tmp,collective_flag,pipeline);
 
     remap = new Remap(lmp,world,
                       nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
                       nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                      1,0,0,FFT_PRECISION,collective_flag);
+                      1,0,0,FFT_PRECISION,collective_flag,pipeline ? 1 : 0);
 
     // create ghost grid object for rho and electric field communication
     // also create 2 bufs for ghost grid cell comm, passed to GridComm methods
@@ -1816,19 +1816,19 @@ void _noopt PPPMDisp::allocate()
       new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
                 nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
                 nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                0,0,&tmp,collective_flag);
+                0,0,&tmp,collective_flag,pipeline);
 
     fft2_6 =
       new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
                 nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
                 nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
-                0,0,&tmp,collective_flag);
+                0,0,&tmp,collective_flag,pipeline);
 
     remap_6 =
       new Remap(lmp,world,
                 nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
                 nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                1,0,0,FFT_PRECISION,collective_flag);
+                1,0,0,FFT_PRECISION,collective_flag,pipeline ? 1 : 0);
 
     // create ghost grid object for rho and electric field communication
     // also create 2 bufs for ghost grid cell comm, passed to GridComm methods
@@ -1981,17 +1981,17 @@ void _noopt PPPMDisp::allocate()
     fft1_6 = new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
                      nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
                      nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                     0,0,&tmp,collective_flag);
+                     0,0,&tmp,collective_flag,pipeline);
 
     fft2_6 = new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
                      nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
                      nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
-                     0,0,&tmp,collective_flag);
+                     0,0,&tmp,collective_flag,pipeline);
 
     remap_6 = new Remap(lmp,world,
                       nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
                       nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                      1,0,0,FFT_PRECISION,collective_flag);
+                      1,0,0,FFT_PRECISION,collective_flag,pipeline ? 1 : 0);
 
     // create ghost grid object for rho and electric field communication
     // also create 2 bufs for ghost grid cell comm, passed to GridComm methods
@@ -2068,17 +2068,17 @@ void _noopt PPPMDisp::allocate()
     fft1_6 = new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
                      nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
                      nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                     0,0,&tmp,collective_flag);
+                     0,0,&tmp,collective_flag,pipeline);
 
     fft2_6 = new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
                      nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
                      nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
-                     0,0,&tmp,collective_flag);
+                     0,0,&tmp,collective_flag,pipeline);
 
     remap_6 = new Remap(lmp,world,
                       nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
                       nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                      1,0,0,FFT_PRECISION,collective_flag);
+                      1,0,0,FFT_PRECISION,collective_flag,pipeline ? 1 : 0);
 
     // create ghost grid object for rho and electric field communication
     // also create 2 bufs for ghost grid cell comm, passed to GridComm methods
@@ -4308,6 +4308,8 @@ void PPPMDisp::particle_map(double delx, double dely, double delz,
   }
 
   if (flag) error->one(FLERR,"Out of range atoms - cannot compute PPPMDisp");
+
+  tile_sort(p2g,nlow,nup,nylo,nyhi,nzlo,nzhi);
 }
 
 /* ----------------------------------------------------------------------
@@ -4348,7 +4350,8 @@ void PPPMDisp::make_rho_c()
   double **x = atom->x;
   int nlocal = atom->nlocal;
 
-  for (int i = 0; i < nlocal; i++) {
+  for (int ii = 0; ii < nlocal; ii++) {
+    const int i = tile_order[ii];
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -4400,7 +4403,8 @@ void PPPMDisp::make_rho_g()
   double **x = atom->x;
   int nlocal = atom->nlocal;
 
-  for (int i = 0; i < nlocal; i++) {
+  for (int ii = 0; ii < nlocal; ii++) {
+    const int i = tile_order[ii];
     nx = part2grid_6[i][0];
     ny = part2grid_6[i][1];
     nz = part2grid_6[i][2];
@@ -4465,7 +4469,8 @@ void PPPMDisp::make_rho_a()
   double **x = atom->x;
   int nlocal = atom->nlocal;
 
-  for (int i = 0; i < nlocal; i++) {
+  for (int ii = 0; ii < nlocal; ii++) {
+    const int i = tile_order[ii];
     nx = part2grid_6[i][0];
     ny = part2grid_6[i][1];
     nz = part2grid_6[i][2];
@@ -4526,7 +4531,8 @@ void PPPMDisp::make_rho_none()
   double **x = atom->x;
   int nlocal = atom->nlocal;
 
-  for (int i = 0; i < nlocal; i++) {
+  for (int ii = 0; ii < nlocal; ii++) {
+    const int i = tile_order[ii];
     nx = part2grid_6[i][0];
     ny = part2grid_6[i][1];
     nz = part2grid_6[i][2];
@@ -5680,7 +5686,7 @@ poisson_none_peratom(int n1, int n2,
 
 void PPPMDisp::fieldforce_c_ik()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR ekx,eky,ekz;
 
@@ -5696,7 +5702,8 @@ void PPPMDisp::fieldforce_c_ik()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -5738,7 +5745,7 @@ void PPPMDisp::fieldforce_c_ik()
 
 void PPPMDisp::fieldforce_c_ad()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz;
   FFT_SCALAR ekx,eky,ekz;
   double s1,s2,s3;
@@ -5770,7 +5777,8 @@ void PPPMDisp::fieldforce_c_ad()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -5827,7 +5835,7 @@ void PPPMDisp::fieldforce_c_ad()
 
 void PPPMDisp::fieldforce_c_peratom()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR u_pa,v0,v1,v2,v3,v4,v5;
 
@@ -5842,7 +5850,8 @@ void PPPMDisp::fieldforce_c_peratom()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     nx = part2grid[i][0];
     ny = part2grid[i][1];
     nz = part2grid[i][2];
@@ -5898,7 +5907,7 @@ void PPPMDisp::fieldforce_c_peratom()
 
 void PPPMDisp::fieldforce_g_ik()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR ekx,eky,ekz;
 
@@ -5915,7 +5924,8 @@ void PPPMDisp::fieldforce_g_ik()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     nx = part2grid_6[i][0];
     ny = part2grid_6[i][1];
     nz = part2grid_6[i][2];
@@ -5959,7 +5969,7 @@ void PPPMDisp::fieldforce_g_ik()
 
 void PPPMDisp::fieldforce_g_ad()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz;
   FFT_SCALAR ekx,eky,ekz;
   double s1,s2,s3;
@@ -5992,7 +6002,8 @@ void PPPMDisp::fieldforce_g_ad()
   int nlocal = atom->nlocal;
 
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     nx = part2grid_6[i][0];
     ny = part2grid_6[i][1];
     nz = part2grid_6[i][2];
@@ -6055,7 +6066,7 @@ void PPPMDisp::fieldforce_g_ad()
 
 void PPPMDisp::fieldforce_g_peratom()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR u_pa,v0,v1,v2,v3,v4,v5;
 
@@ -6071,7 +6082,8 @@ void PPPMDisp::fieldforce_g_peratom()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     nx = part2grid_6[i][0];
     ny = part2grid_6[i][1];
     nz = part2grid_6[i][2];
@@ -6128,7 +6140,7 @@ void PPPMDisp::fieldforce_g_peratom()
 
 void PPPMDisp::fieldforce_a_ik()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR ekx0, eky0, ekz0, ekx1, eky1, ekz1, ekx2, eky2, ekz2;
   FFT_SCALAR ekx3, eky3, ekz3, ekx4, eky4, ekz4, ekx5, eky5, ekz5;
@@ -6147,7 +6159,8 @@ void PPPMDisp::fieldforce_a_ik()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
 
     nx = part2grid_6[i][0];
     ny = part2grid_6[i][1];
@@ -6218,7 +6231,7 @@ void PPPMDisp::fieldforce_a_ik()
 
 void PPPMDisp::fieldforce_a_ad()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR ekx0, eky0, ekz0, ekx1, eky1, ekz1, ekx2, eky2, ekz2;
   FFT_SCALAR ekx3, eky3, ekz3, ekx4, eky4, ekz4, ekx5, eky5, ekz5;
@@ -6253,7 +6266,8 @@ void PPPMDisp::fieldforce_a_ad()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
 
     nx = part2grid_6[i][0];
     ny = part2grid_6[i][1];
@@ -6383,7 +6397,7 @@ void PPPMDisp::fieldforce_a_ad()
 
 void PPPMDisp::fieldforce_a_peratom()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR u_pa0,v00,v10,v20,v30,v40,v50;
   FFT_SCALAR u_pa1,v01,v11,v21,v31,v41,v51;
@@ -6405,7 +6419,8 @@ void PPPMDisp::fieldforce_a_peratom()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
 
     nx = part2grid_6[i][0];
     ny = part2grid_6[i][1];
@@ -6525,7 +6540,7 @@ void PPPMDisp::fieldforce_a_peratom()
 
 void PPPMDisp::fieldforce_none_ik()
 {
-  int i,k,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,k,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR *ekx, *eky, *ekz;
 
@@ -6545,7 +6560,8 @@ void PPPMDisp::fieldforce_none_ik()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
 
     nx = part2grid_6[i][0];
     ny = part2grid_6[i][1];
@@ -6595,7 +6611,7 @@ void PPPMDisp::fieldforce_none_ik()
 
 void PPPMDisp::fieldforce_none_ad()
 {
-  int i,k,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,k,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR *ekx, *eky, *ekz;
 
@@ -6634,7 +6650,8 @@ void PPPMDisp::fieldforce_none_ad()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
 
     nx = part2grid_6[i][0];
     ny = part2grid_6[i][1];
@@ -6717,7 +6734,7 @@ void PPPMDisp::fieldforce_none_ad()
 
 void PPPMDisp::fieldforce_none_peratom()
 {
-  int i,k,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,k,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR *u_pa,*v0,*v1,*v2,*v3,*v4,*v5;
 
@@ -6741,7 +6758,8 @@ void PPPMDisp::fieldforce_none_peratom()
 
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
 
     nx = part2grid_6[i][0];
     ny = part2grid_6[i][1];
@@ -8280,6 +8298,7 @@ int PPPMDisp::timing_3d(int n, double &time3d)
 double PPPMDisp::memory_usage()
 {
   double bytes = (double)nmax*3 * sizeof(double);
+  bytes += (double)(maxtile_order + maxtile_start) * sizeof(int);
 
   int mixing = 1;
   int diff = 3;     //depends on differentiation
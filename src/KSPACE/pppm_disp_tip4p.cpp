@@ -108,6 +108,8 @@ void PPPMDispTIP4P::particle_map_c(double delx, double dely, double delz,
   }
 
   if (flag) error->one(FLERR,"Out of range atoms - cannot compute PPPM");
+
+  tile_sort(p2g,nlow,nup,nylo,nyhi,nzlo,nzhi);
 }
 
 /* ----------------------------------------------------------------------
@@ -138,7 +140,8 @@ void PPPMDispTIP4P::make_rho_c()
   double **x = atom->x;
   int nlocal = atom->nlocal;
 
-  for (int i = 0; i < nlocal; i++) {
+  for (int ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     if (type[i] == typeO) {
       find_M(i,iH1,iH2,xM);
       xi = xM;
@@ -176,7 +179,7 @@ void PPPMDispTIP4P::make_rho_c()
 
 void PPPMDispTIP4P::fieldforce_c_ik()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR ekx,eky,ekz;
   double *xi;
@@ -196,7 +199,8 @@ void PPPMDispTIP4P::fieldforce_c_ik()
   int *type = atom->type;
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     if (type[i] == typeO) {
       find_M(i,iH1,iH2,xM);
       xi = xM;
@@ -264,7 +268,7 @@ void PPPMDispTIP4P::fieldforce_c_ik()
 
 void PPPMDispTIP4P::fieldforce_c_ad()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz;
   FFT_SCALAR ekx,eky,ekz;
   double *xi;
@@ -302,7 +306,8 @@ void PPPMDispTIP4P::fieldforce_c_ad()
   int *type = atom->type;
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     if (type[i] == typeO) {
       find_M(i,iH1,iH2,xM);
       xi = xM;
@@ -387,7 +392,7 @@ void PPPMDispTIP4P::fieldforce_c_ad()
 
 void PPPMDispTIP4P::fieldforce_c_peratom()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   double *xi;
   int iH1,iH2;
@@ -405,7 +410,8 @@ void PPPMDispTIP4P::fieldforce_c_peratom()
   int *type = atom->type;
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     if (type[i] == typeO) {
       find_M(i,iH1,iH2,xM);
       xi = xM;
@@ -105,6 +105,8 @@ void PPPMTIP4P::particle_map()
   int flag_all;
   MPI_Allreduce(&flag,&flag_all,1,MPI_INT,MPI_SUM,world);
   if (flag_all) error->all(FLERR,"Out of range atoms - cannot compute PPPM");
+
+  tile_sort(part2grid,nlower,nupper,nylo_out,nyhi_out,nzlo_out,nzhi_out);
 }
 
 /* ----------------------------------------------------------------------
@@ -125,7 +127,7 @@ void PPPMTIP4P::make_rho()
   FFT_SCALAR *vec = &density_brick[nzlo_out][nylo_out][nxlo_out];
   for (i = 0; i < ngrid; i++) vec[i] = ZEROF;
 
-  // loop over my charges, add their contribution to nearby grid points
+  // loop over my charges in tile order, add their contribution to nearby grid points
   // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
   // (dx,dy,dz) = distance to "lower left" grid pt
   // (mx,my,mz) = global coords of moving stencil pt
@@ -135,7 +137,8 @@ void PPPMTIP4P::make_rho()
   double **x = atom->x;
   int nlocal = atom->nlocal;
 
-  for (int i = 0; i < nlocal; i++) {
+  for (int ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     if (type[i] == typeO) {
       find_M(i,iH1,iH2,xM);
       xi = xM;
@@ -172,9 +175,9 @@ void PPPMTIP4P::make_rho()
 
 void PPPMTIP4P::fieldforce_ik()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
-  FFT_SCALAR ekx,eky,ekz;
+  double ekx,eky,ekz;
   double *xi;
   int iH1,iH2;
   double xM[3];
@@ -192,7 +195,8 @@ void PPPMTIP4P::fieldforce_ik()
   int *type = atom->type;
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     if (type[i] == typeO) {
       find_M(i,iH1,iH2,xM);
       xi = xM;
@@ -259,9 +263,9 @@ void PPPMTIP4P::fieldforce_ik()
 
 void PPPMTIP4P::fieldforce_ad()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz;
-  FFT_SCALAR ekx,eky,ekz;
+  double ekx,eky,ekz;
   double *xi;
   int iH1,iH2;
   double xM[3];
@@ -294,7 +298,8 @@ void PPPMTIP4P::fieldforce_ad()
   int *type = atom->type;
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     if (type[i] == typeO) {
       find_M(i,iH1,iH2,xM);
       xi = xM;
@@ -379,12 +384,12 @@ void PPPMTIP4P::fieldforce_ad()
 
 void PPPMTIP4P::fieldforce_peratom()
 {
-  int i,l,m,n,nx,ny,nz,mx,my,mz;
+  int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   double *xi;
   int iH1,iH2;
   double xM[3];
-  FFT_SCALAR u_pa,v0,v1,v2,v3,v4,v5;
+  double u_pa,v0,v1,v2,v3,v4,v5;
 
   // loop over my charges, interpolate electric field from nearby grid points
   // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
@@ -398,7 +403,8 @@ void PPPMTIP4P::fieldforce_peratom()
   int *type = atom->type;
   int nlocal = atom->nlocal;
 
-  for (i = 0; i < nlocal; i++) {
+  for (ii = 0; ii < nlocal; ii++) {
+    i = tile_order[ii];
     if (type[i] == typeO) {
       find_M(i,iH1,iH2,xM);
       xi = xM;
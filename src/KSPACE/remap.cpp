@@ -63,9 +63,17 @@
 void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
               struct remap_plan_3d *plan)
 {
+  // use non-blocking point-to-point communication, all chunks at once
+
+  if (plan->nchunk) {
+    remap_3d_begin(buf,plan);
+    for (int ichunk = 0; ichunk < plan->nchunk; ichunk++)
+      remap_3d_send(in,buf,ichunk,plan);
+    remap_3d_end(out,buf,plan);
+
   // use point-to-point communication
 
-  if (!plan->usecollective) {
+  } else if (!plan->usecollective) {
     int i,isend,irecv;
     FFT_SCALAR *scratch;
 
@@ -202,6 +210,130 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
   }
 }
 
+/* ----------------------------------------------------------------------
+   Start a non-blocking 3d remap, plan must have been created with nchunk > 0
+   the remap is completed by calling remap_3d_send() once for each chunk
+     and then remap_3d_end(), other work can be done in between,
+     e.g. computing the input data of the next chunk
+
+   Arguments:
+   buf          extra memory required for remap, same as for remap_3d()
+   plan         plan returned by previous call to remap_3d_create_plan
+------------------------------------------------------------------------- */
+
+void remap_3d_begin(FFT_SCALAR *buf, struct remap_plan_3d *plan)
+{
+  int irecv,me;
+  FFT_SCALAR *scratch;
+
+  if (plan->memory == 0)
+    scratch = buf;
+  else
+    scratch = plan->scratch;
+
+  MPI_Comm_rank(plan->comm,&me);
+
+  // post all recvs into scratch space, self data is copied there directly
+
+  for (irecv = 0; irecv < plan->nrecv; irecv++) {
+    if (plan->recv_proc[irecv] == me)
+      plan->request[irecv] = MPI_REQUEST_NULL;
+    else
+      MPI_Irecv(&scratch[plan->recv_bufloc[irecv]],plan->recv_size[irecv],
+                MPI_FFT_SCALAR,plan->recv_proc[irecv],0,
+                plan->comm,&plan->request[irecv]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Send one chunk of a non-blocking 3d remap
+   input data of chunk = planes of the slow index assigned by remap_3d_chunk()
+   must be called for every chunk in increasing order
+   input data must not change until remap_3d_end() returns
+
+   Arguments:
+   in           starting address of input data on this proc
+   buf          extra memory required for remap, same as for remap_3d()
+   ichunk       index of chunk to send
+   plan         plan returned by previous call to remap_3d_create_plan
+------------------------------------------------------------------------- */
+
+void remap_3d_send(FFT_SCALAR *in, FFT_SCALAR *buf, int ichunk,
+                   struct remap_plan_3d *plan)
+{
+  int isend,me;
+  FFT_SCALAR *scratch;
+
+  if (plan->memory == 0)
+    scratch = buf;
+  else
+    scratch = plan->scratch;
+
+  MPI_Comm_rank(plan->comm,&me);
+
+  // each message is packed into its own section of sendbuf,
+  // so all sends of the chunk can be in flight at the same time
+
+  for (isend = plan->send_chunk[ichunk]; isend < plan->send_chunk[ichunk+1]; isend++) {
+    if (plan->send_proc[isend] == me) {
+      plan->pack(&in[plan->send_offset[isend]],
+                 &scratch[plan->send_bufloc[isend]],&plan->packplan[isend]);
+      plan->send_request[isend] = MPI_REQUEST_NULL;
+    } else {
+      plan->pack(&in[plan->send_offset[isend]],
+                 &plan->sendbuf[plan->send_bufloc[isend]],&plan->packplan[isend]);
+      MPI_Isend(&plan->sendbuf[plan->send_bufloc[isend]],plan->send_size[isend],
+                MPI_FFT_SCALAR,plan->send_proc[isend],0,
+                plan->comm,&plan->send_request[isend]);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Complete a non-blocking 3d remap
+
+   Arguments:
+   out          starting address of where output data for this proc
+                  will be placed (can be same as in)
+   buf          extra memory required for remap, same as for remap_3d()
+   plan         plan returned by previous call to remap_3d_create_plan
+------------------------------------------------------------------------- */
+
+void remap_3d_end(FFT_SCALAR *out, FFT_SCALAR *buf, struct remap_plan_3d *plan)
+{
+  int i,irecv,nself,me;
+  FFT_SCALAR *scratch;
+
+  if (plan->memory == 0)
+    scratch = buf;
+  else
+    scratch = plan->scratch;
+
+  MPI_Comm_rank(plan->comm,&me);
+
+  // unpack self data from scratch -> out
+
+  nself = 0;
+  for (irecv = 0; irecv < plan->nrecv; irecv++) {
+    if (plan->recv_proc[irecv] != me) continue;
+    plan->unpack(&scratch[plan->recv_bufloc[irecv]],
+                 &out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
+    nself++;
+  }
+
+  // unpack all messages from scratch -> out in the order they arrive
+
+  for (i = 0; i < plan->nrecv - nself; i++) {
+    MPI_Waitany(plan->nrecv,plan->request,&irecv,MPI_STATUS_IGNORE);
+    plan->unpack(&scratch[plan->recv_bufloc[irecv]],
+                 &out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
+  }
+
+  // sendbuf may be reused once all sends have completed
+
+  if (plan->nsend) MPI_Waitall(plan->nsend,plan->send_request,MPI_STATUSES_IGNORE);
+}
+
 /* ----------------------------------------------------------------------
    Create plan for performing a 3d remap
 
@@ -225,6 +357,10 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
                           1 = single precision (4 bytes per datum)
                           2 = double precision (8 bytes per datum)
    usecollective        whether to use collective MPI or point-to-point
+   nchunk               # of chunks for non-blocking point-to-point MPI
+                          0 = use blocking sends
+                          N = split input along slow index into N chunks
+                        ignored if usecollective is set
 ------------------------------------------------------------------------- */
 
 struct remap_plan_3d *remap_3d_create_plan(
@@ -233,14 +369,15 @@ struct remap_plan_3d *remap_3d_create_plan(
   int in_klo, int in_khi,
   int out_ilo, int out_ihi, int out_jlo, int out_jhi,
   int out_klo, int out_khi,
-  int nqty, int permute, int memory, int /*precision*/, int usecollective)
+  int nqty, int permute, int memory, int /*precision*/, int usecollective,
+  int nchunk)
 
 {
 
   struct remap_plan_3d *plan;
   struct extent_3d *inarray, *outarray;
-  struct extent_3d in,out,overlap;
-  int i,j,iproc,nsend,nrecv,ibuf,size,me,nprocs;
+  struct extent_3d in,out,overlap,chunk;
+  int i,j,iproc,ichunk,nloop,nsend,nrecv,nself,ibuf,size,me,nprocs;
 
   // query MPI info
 
@@ -252,6 +389,8 @@ struct remap_plan_3d *remap_3d_create_plan(
   plan = (struct remap_plan_3d *) malloc(sizeof(struct remap_plan_3d));
   if (plan == nullptr) return nullptr;
   plan->usecollective = usecollective;
+  plan->nchunk = usecollective ? 0 : MAX(nchunk,0);
+  nloop = MAX(plan->nchunk,1);
 
   // store parameters in local data structs
 
@@ -291,13 +430,17 @@ struct remap_plan_3d *remap_3d_create_plan(
                 outarray,sizeof(struct extent_3d),MPI_BYTE,comm);
 
   // count send collides, including self
+  // with chunks, each chunk of my input is sent separately
 
   nsend = 0;
-  iproc = me;
-  for (i = 0; i < nprocs; i++) {
-    iproc++;
-    if (iproc == nprocs) iproc = 0;
-    nsend += remap_3d_collide(&in,&outarray[iproc],&overlap);
+  for (ichunk = 0; ichunk < nloop; ichunk++) {
+    remap_3d_chunk(&in,ichunk,nloop,&chunk);
+    iproc = me;
+    for (i = 0; i < nprocs; i++) {
+      iproc++;
+      if (iproc == nprocs) iproc = 0;
+      nsend += remap_3d_collide(&chunk,&outarray[iproc],&overlap);
+    }
   }
 
   // malloc space for send info
@@ -313,34 +456,53 @@ struct remap_plan_3d *remap_3d_create_plan(
 
     if (plan->send_offset == nullptr || plan->send_size == nullptr ||
         plan->send_proc == nullptr || plan->packplan == nullptr) return nullptr;
+
+    if (plan->nchunk) {
+      plan->send_bufloc = (int *) malloc(nsend*sizeof(int));
+      plan->send_request = (MPI_Request *) malloc(nsend*sizeof(MPI_Request));
+      if (plan->send_bufloc == nullptr || plan->send_request == nullptr) return nullptr;
+    }
+  }
+
+  if (plan->nchunk) {
+    plan->send_chunk = (int *) malloc((plan->nchunk+1)*sizeof(int));
+    if (plan->send_chunk == nullptr) return nullptr;
   }
 
-  // store send info, with self as last entry
+  // store send info, with self as last entry (of each chunk)
 
   nsend = 0;
-  iproc = me;
-  for (i = 0; i < nprocs; i++) {
-    iproc++;
-    if (iproc == nprocs) iproc = 0;
-    if (remap_3d_collide(&in,&outarray[iproc],&overlap)) {
-      plan->send_proc[nsend] = iproc;
-      plan->send_offset[nsend] = nqty *
-        ((overlap.klo-in.klo)*in.jsize*in.isize +
-         ((overlap.jlo-in.jlo)*in.isize + overlap.ilo-in.ilo));
-      plan->packplan[nsend].nfast = nqty*overlap.isize;
-      plan->packplan[nsend].nmid = overlap.jsize;
-      plan->packplan[nsend].nslow = overlap.ksize;
-      plan->packplan[nsend].nstride_line = nqty*in.isize;
-      plan->packplan[nsend].nstride_plane = nqty*in.jsize*in.isize;
-      plan->packplan[nsend].nqty = nqty;
-      plan->send_size[nsend] = nqty*overlap.isize*overlap.jsize*overlap.ksize;
-      nsend++;
+  for (ichunk = 0; ichunk < nloop; ichunk++) {
+    if (plan->nchunk) plan->send_chunk[ichunk] = nsend;
+    remap_3d_chunk(&in,ichunk,nloop,&chunk);
+    iproc = me;
+    for (i = 0; i < nprocs; i++) {
+      iproc++;
+      if (iproc == nprocs) iproc = 0;
+      if (remap_3d_collide(&chunk,&outarray[iproc],&overlap)) {
+        plan->send_proc[nsend] = iproc;
+        plan->send_offset[nsend] = nqty *
+          ((overlap.klo-in.klo)*in.jsize*in.isize +
+           ((overlap.jlo-in.jlo)*in.isize + overlap.ilo-in.ilo));
+        plan->packplan[nsend].nfast = nqty*overlap.isize;
+        plan->packplan[nsend].nmid = overlap.jsize;
+        plan->packplan[nsend].nslow = overlap.ksize;
+        plan->packplan[nsend].nstride_line = nqty*in.isize;
+        plan->packplan[nsend].nstride_plane = nqty*in.jsize*in.isize;
+        plan->packplan[nsend].nqty = nqty;
+        plan->send_size[nsend] = nqty*overlap.isize*overlap.jsize*overlap.ksize;
+        nsend++;
+      }
     }
   }
+  if (plan->nchunk) plan->send_chunk[plan->nchunk] = nsend;
 
   // plan->nsend = # of sends not including self
+  // with chunks, self data is "sent" by copying it to scratch and is included
 
-  if (nsend && plan->send_proc[nsend-1] == me) {
+  if (plan->nchunk)
+    plan->nsend = nsend;
+  else if (nsend && plan->send_proc[nsend-1] == me) {
     if (plan->usecollective) // for collectives include self in nsend list
       plan->nsend = nsend;
     else
@@ -354,13 +516,17 @@ struct remap_plan_3d *remap_3d_create_plan(
                 inarray,sizeof(struct extent_3d),MPI_BYTE,comm);
 
   // count recv collides, including self
+  // with chunks, each chunk of another proc's input is received separately
 
   nrecv = 0;
-  iproc = me;
-  for (i = 0; i < nprocs; i++) {
-    iproc++;
-    if (iproc == nprocs) iproc = 0;
-    nrecv += remap_3d_collide(&out,&inarray[iproc],&overlap);
+  for (ichunk = 0; ichunk < nloop; ichunk++) {
+    iproc = me;
+    for (i = 0; i < nprocs; i++) {
+      iproc++;
+      if (iproc == nprocs) iproc = 0;
+      remap_3d_chunk(&inarray[iproc],ichunk,nloop,&chunk);
+      nrecv += remap_3d_collide(&out,&chunk,&overlap);
+    }
   }
 
   // malloc space for recv info
@@ -398,56 +564,58 @@ struct remap_plan_3d *remap_3d_create_plan(
         plan->request == nullptr || plan->unpackplan == nullptr) return nullptr;
   }
 
-  // store recv info, with self as last entry
+  // store recv info, with self as last entry (of each chunk)
 
   ibuf = 0;
   nrecv = 0;
-  iproc = me;
-
-  for (i = 0; i < nprocs; i++) {
-    iproc++;
-    if (iproc == nprocs) iproc = 0;
-    if (remap_3d_collide(&out,&inarray[iproc],&overlap)) {
-      plan->recv_proc[nrecv] = iproc;
-      plan->recv_bufloc[nrecv] = ibuf;
-
-      if (permute == 0) {
-        plan->recv_offset[nrecv] = nqty *
-          ((overlap.klo-out.klo)*out.jsize*out.isize +
-           (overlap.jlo-out.jlo)*out.isize + (overlap.ilo-out.ilo));
-        plan->unpackplan[nrecv].nfast = nqty*overlap.isize;
-        plan->unpackplan[nrecv].nmid = overlap.jsize;
-        plan->unpackplan[nrecv].nslow = overlap.ksize;
-        plan->unpackplan[nrecv].nstride_line = nqty*out.isize;
-        plan->unpackplan[nrecv].nstride_plane = nqty*out.jsize*out.isize;
-        plan->unpackplan[nrecv].nqty = nqty;
-      }
-      else if (permute == 1) {
-        plan->recv_offset[nrecv] = nqty *
-          ((overlap.ilo-out.ilo)*out.ksize*out.jsize +
-           (overlap.klo-out.klo)*out.jsize + (overlap.jlo-out.jlo));
-        plan->unpackplan[nrecv].nfast = overlap.isize;
-        plan->unpackplan[nrecv].nmid = overlap.jsize;
-        plan->unpackplan[nrecv].nslow = overlap.ksize;
-        plan->unpackplan[nrecv].nstride_line = nqty*out.jsize;
-        plan->unpackplan[nrecv].nstride_plane = nqty*out.ksize*out.jsize;
-        plan->unpackplan[nrecv].nqty = nqty;
-      }
-      else {
-        plan->recv_offset[nrecv] = nqty *
-          ((overlap.jlo-out.jlo)*out.isize*out.ksize +
-           (overlap.ilo-out.ilo)*out.ksize + (overlap.klo-out.klo));
-        plan->unpackplan[nrecv].nfast = overlap.isize;
-        plan->unpackplan[nrecv].nmid = overlap.jsize;
-        plan->unpackplan[nrecv].nslow = overlap.ksize;
-        plan->unpackplan[nrecv].nstride_line = nqty*out.ksize;
-        plan->unpackplan[nrecv].nstride_plane = nqty*out.isize*out.ksize;
-        plan->unpackplan[nrecv].nqty = nqty;
-      }
+  for (ichunk = 0; ichunk < nloop; ichunk++) {
+    iproc = me;
+    for (i = 0; i < nprocs; i++) {
+      iproc++;
+      if (iproc == nprocs) iproc = 0;
+      remap_3d_chunk(&inarray[iproc],ichunk,nloop,&chunk);
+      if (remap_3d_collide(&out,&chunk,&overlap)) {
+        plan->recv_proc[nrecv] = iproc;
+        plan->recv_bufloc[nrecv] = ibuf;
+
+        if (permute == 0) {
+          plan->recv_offset[nrecv] = nqty *
+            ((overlap.klo-out.klo)*out.jsize*out.isize +
+             (overlap.jlo-out.jlo)*out.isize + (overlap.ilo-out.ilo));
+          plan->unpackplan[nrecv].nfast = nqty*overlap.isize;
+          plan->unpackplan[nrecv].nmid = overlap.jsize;
+          plan->unpackplan[nrecv].nslow = overlap.ksize;
+          plan->unpackplan[nrecv].nstride_line = nqty*out.isize;
+          plan->unpackplan[nrecv].nstride_plane = nqty*out.jsize*out.isize;
+          plan->unpackplan[nrecv].nqty = nqty;
+        }
+        else if (permute == 1) {
+          plan->recv_offset[nrecv] = nqty *
+            ((overlap.ilo-out.ilo)*out.ksize*out.jsize +
+             (overlap.klo-out.klo)*out.jsize + (overlap.jlo-out.jlo));
+          plan->unpackplan[nrecv].nfast = overlap.isize;
+          plan->unpackplan[nrecv].nmid = overlap.jsize;
+          plan->unpackplan[nrecv].nslow = overlap.ksize;
+          plan->unpackplan[nrecv].nstride_line = nqty*out.jsize;
+          plan->unpackplan[nrecv].nstride_plane = nqty*out.ksize*out.jsize;
+          plan->unpackplan[nrecv].nqty = nqty;
+        }
+        else {
+          plan->recv_offset[nrecv] = nqty *
+            ((overlap.jlo-out.jlo)*out.isize*out.ksize +
+             (overlap.ilo-out.ilo)*out.ksize + (overlap.klo-out.klo));
+          plan->unpackplan[nrecv].nfast = overlap.isize;
+          plan->unpackplan[nrecv].nmid = overlap.jsize;
+          plan->unpackplan[nrecv].nslow = overlap.ksize;
+          plan->unpackplan[nrecv].nstride_line = nqty*out.ksize;
+          plan->unpackplan[nrecv].nstride_plane = nqty*out.isize*out.ksize;
+          plan->unpackplan[nrecv].nqty = nqty;
+        }
 
-      plan->recv_size[nrecv] = nqty*overlap.isize*overlap.jsize*overlap.ksize;
-      ibuf += plan->recv_size[nrecv];
-      nrecv++;
+        plan->recv_size[nrecv] = nqty*overlap.isize*overlap.jsize*overlap.ksize;
+        ibuf += plan->recv_size[nrecv];
+        nrecv++;
+      }
     }
   }
 
@@ -557,7 +725,8 @@ struct remap_plan_3d *remap_3d_create_plan(
   // plan->nrecv = # of recvs not including self
   // for collectives include self in the nsend list
 
-  if (nrecv && plan->recv_proc[nrecv-1] == me) {
+  if (plan->nchunk) plan->nrecv = nrecv;
+  else if (nrecv && plan->recv_proc[nrecv-1] == me) {
     if (plan->usecollective) plan->nrecv = nrecv;
     else plan->nrecv = nrecv - 1;
   } else plan->nrecv = nrecv;
@@ -574,13 +743,33 @@ struct remap_plan_3d *remap_3d_create_plan(
   free(inarray);
   free(outarray);
 
+  // with chunks, self messages are copied to the scratch location
+  // of the matching recv, both lists hold them in order of chunks
+
+  if (plan->nchunk) {
+    nself = 0;
+    size = 0;
+    for (nsend = 0; nsend < plan->nsend; nsend++) {
+      if (plan->send_proc[nsend] == me) {
+        while (plan->recv_proc[nself] != me) nself++;
+        plan->send_bufloc[nsend] = plan->recv_bufloc[nself++];
+      } else {
+        plan->send_bufloc[nsend] = size;
+        size += plan->send_size[nsend];
+      }
+    }
+  }
+
   // find biggest send message (not including self) and malloc space for it
+  // with chunks, all messages are in flight at once and need their own space
 
   plan->sendbuf = nullptr;
 
-  size = 0;
-  for (nsend = 0; nsend < plan->nsend; nsend++)
-    size = MAX(size,plan->send_size[nsend]);
+  if (!plan->nchunk) {
+    size = 0;
+    for (nsend = 0; nsend < plan->nsend; nsend++)
+      size = MAX(size,plan->send_size[nsend]);
+  }
 
   if (size) {
     plan->sendbuf = (FFT_SCALAR *) malloc(size*sizeof(FFT_SCALAR));
@@ -655,6 +844,14 @@ void remap_3d_destroy_plan(struct remap_plan_3d *plan)
     if (plan->sendbuf) free(plan->sendbuf);
   }
 
+  if (plan->nchunk) {
+    free(plan->send_chunk);
+    if (plan->nsend) {
+      free(plan->send_bufloc);
+      free(plan->send_request);
+    }
+  }
+
   if (plan->nrecv || plan->self) {
     free(plan->recv_offset);
     free(plan->recv_size);
@@ -698,3 +895,18 @@ int remap_3d_collide(struct extent_3d *block1, struct extent_3d *block2,
 
   return 1;
 }
+
+/* ----------------------------------------------------------------------
+   assign planes of the slow index of block to one of nchunk chunks
+   return sub-block of block for chunk ichunk in chunk
+   chunks differ in size by at most one plane and can be empty
+------------------------------------------------------------------------- */
+
+void remap_3d_chunk(struct extent_3d *block, int ichunk, int nchunk,
+                    struct extent_3d *chunk)
+{
+  *chunk = *block;
+  chunk->klo = block->klo + ichunk*block->ksize/nchunk;
+  chunk->khi = block->klo + (ichunk+1)*block->ksize/nchunk - 1;
+  chunk->ksize = chunk->khi - chunk->klo + 1;
+}
@@ -48,6 +48,10 @@ struct remap_plan_3d {
   int usecollective;                  // use collective or point-to-point MPI
   int commringlen;                    // length of commringlist
   int *commringlist;                  // ranks on communication ring of this plan
+  int nchunk;                         // # of chunks of non-blocking remap, 0 = blocking
+  int *send_chunk;                    // first send message of each chunk
+  int *send_bufloc;                   // offset in sendbuf (scratch for self) of each send
+  MPI_Request *send_request;          // MPI request for each posted send
 };
 
 // collision between 2 regions
@@ -61,7 +65,11 @@ struct extent_3d {
 // function prototypes
 
 void remap_3d(FFT_SCALAR *, FFT_SCALAR *, FFT_SCALAR *, struct remap_plan_3d *);
+void remap_3d_begin(FFT_SCALAR *, struct remap_plan_3d *);
+void remap_3d_send(FFT_SCALAR *, FFT_SCALAR *, int, struct remap_plan_3d *);
+void remap_3d_end(FFT_SCALAR *, FFT_SCALAR *, struct remap_plan_3d *);
 struct remap_plan_3d *remap_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int,
-                                           int, int, int, int, int, int, int, int);
+                                           int, int, int, int, int, int, int, int, int);
 void remap_3d_destroy_plan(struct remap_plan_3d *);
 int remap_3d_collide(struct extent_3d *, struct extent_3d *, struct extent_3d *);
+void remap_3d_chunk(struct extent_3d *, int, int, struct extent_3d *);
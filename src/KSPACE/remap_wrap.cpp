@@ -26,12 +26,12 @@ Remap::Remap(LAMMPS *lmp, MPI_Comm comm,
              int out_ilo, int out_ihi, int out_jlo, int out_jhi,
              int out_klo, int out_khi,
              int nqty, int permute, int memory,
-             int precision, int usecollective) : Pointers(lmp)
+             int precision, int usecollective, int nchunk) : Pointers(lmp)
 {
   plan = remap_3d_create_plan(comm,
                               in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
                               out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
-                              nqty,permute,memory,precision,usecollective);
+                              nqty,permute,memory,precision,usecollective,nchunk);
   if (plan == nullptr) error->one(FLERR,"Could not create 3d remap plan");
 }
 
@@ -41,6 +41,7 @@ PairEAM::PairEAM(LAMMPS *lmp) : Pair(lmp)
 {
   restartinfo = 0;
   manybody_flag = 1;
+  cluster_enable = 1;
   embedstep = -1;
   unit_convert_flag = utils::get_supported_conversions(utils::ENERGY);
 
@@ -163,6 +164,22 @@ void PairEAM::compute(int eflag, int vflag)
     memory->create(numforce,nmax,"pair:numforce");
   }
 
+  // cluster pair list from neighbor style cluster
+
+  if (list->cluster == 8) {
+    if (evflag) {
+      if (eflag) eval_cluster<1,1,8>();
+      else eval_cluster<1,0,8>();
+    } else eval_cluster<0,0,8>();
+    return;
+  } else if (list->cluster) {
+    if (evflag) {
+      if (eflag) eval_cluster<1,1,4>();
+      else eval_cluster<1,0,4>();
+    } else eval_cluster<0,0,4>();
+    return;
+  }
+
   double **x = atom->x;
   double **f = atom->f;
   int *type = atom->type;
@@ -327,6 +344,219 @@ void PairEAM::compute(int eflag, int vflag)
   if (vflag_fdotr) virial_fdotr_compute();
 }
 
+/* ----------------------------------------------------------------------
+   compute densities, embedding terms and forces from a cluster pair list
+   cluster lists are always newton on, so rho of ghosts is reverse comm'd
+   same sequence of operations as compute(), but loops run over the
+     fixed size atom slots of each pair of clusters
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG, int CLUSTERSIZE>
+void PairEAM::eval_cluster()
+{
+  constexpr int CS = CLUSTERSIZE;
+  int m;
+  double r,p,rhoip,rhojp,z2,z2p,recip,phip,psip,phi,fpair;
+  double *coeff;
+  double evdwl = 0.0;
+
+  double **f = atom->f;
+  int *type = atom->type;
+  const int nlocal = atom->nlocal;
+  const int nall = nlocal + atom->nghost;
+
+  list->pack_cluster_x();
+
+  const int nclocal = list->nclocal;
+  const double * _noalias const xcluster = list->xcluster;
+  const int * _noalias const clusteratom = list->clusteratom;
+  const int * _noalias const clustertype = list->clustertype;
+  const int * _noalias const firstcj = list->firstcj;
+  const int * _noalias const numcj = list->numcj;
+  const int * _noalias const cjlist = list->cjlist;
+  const uint64_t * _noalias const cjmask = list->cjmask;
+
+  // zero out density of owned and ghost atoms
+
+  for (int i = 0; i < nall; i++) rho[i] = 0.0;
+
+  // rho = density at each atom
+  // loop over cluster pairs of my clusters
+
+  for (int ci = 0; ci < nclocal; ci++) {
+    const double * _noalias const xi = &xcluster[3*CS*ci];
+    const int * const iatom = &clusteratom[CS*ci];
+    const int * const itype = &clustertype[CS*ci];
+
+    double rhoi[CS];
+    for (int ii = 0; ii < CS; ii++) rhoi[ii] = 0.0;
+
+    for (int k = firstcj[ci]; k < firstcj[ci] + numcj[ci]; k++) {
+      const int cj = cjlist[k];
+      const uint64_t mask = cjmask[k];
+      const double * _noalias const xj = &xcluster[3*CS*cj];
+      const int * const jatom = &clusteratom[CS*cj];
+      const int * const jtype = &clustertype[CS*cj];
+
+      double rhoj[CS];
+      for (int jj = 0; jj < CS; jj++) rhoj[jj] = 0.0;
+
+      for (int ii = 0; ii < CS; ii++) {
+        for (int jj = 0; jj < CS; jj++) {
+          if (!((mask >> (ii*CS + jj)) & 1)) continue;
+          const double delx = xi[ii] - xj[jj];
+          const double dely = xi[CS+ii] - xj[CS+jj];
+          const double delz = xi[2*CS+ii] - xj[2*CS+jj];
+          const double rsq = delx*delx + dely*dely + delz*delz;
+          if (rsq >= cutforcesq) continue;
+
+          p = sqrt(rsq)*rdr + 1.0;
+          m = static_cast<int> (p);
+          m = MIN(m,nr-1);
+          p -= m;
+          p = MIN(p,1.0);
+          coeff = rhor_spline[type2rhor[jtype[jj]][itype[ii]]][m];
+          rhoi[ii] += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+          coeff = rhor_spline[type2rhor[itype[ii]][jtype[jj]]][m];
+          rhoj[jj] += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+        }
+      }
+
+      for (int jj = 0; jj < CS; jj++)
+        if (jatom[jj] >= 0) rho[jatom[jj]] += rhoj[jj];
+    }
+
+    for (int ii = 0; ii < CS; ii++)
+      if (iatom[ii] >= 0) rho[iatom[ii]] += rhoi[ii];
+  }
+
+  // communicate and sum densities
+
+  comm->reverse_comm(this);
+
+  // fp = derivative of embedding energy at each atom
+  // phi = embedding energy at each atom
+
+  for (int ci = 0; ci < nclocal; ci++) {
+    for (int ii = 0; ii < CS; ii++) {
+      const int i = clusteratom[CS*ci+ii];
+      if (i < 0) continue;
+      p = rho[i]*rdrho + 1.0;
+      m = static_cast<int> (p);
+      m = MAX(1,MIN(m,nrho-1));
+      p -= m;
+      p = MIN(p,1.0);
+      coeff = frho_spline[type2frho[type[i]]][m];
+      fp[i] = (coeff[0]*p + coeff[1])*p + coeff[2];
+      if (EFLAG) {
+        phi = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+        if (rho[i] > rhomax) phi += fp[i] * (rho[i]-rhomax);
+        phi *= scale[type[i]][type[i]];
+        if (eflag_global) eng_vdwl += phi;
+        if (eflag_atom) eatom[i] += phi;
+      }
+      numforce[i] = 0;
+    }
+  }
+
+  // communicate derivative of embedding function
+
+  comm->forward_comm(this);
+  embedstep = update->ntimestep;
+
+  // compute forces on each atom
+  // loop over cluster pairs of my clusters
+
+  for (int ci = 0; ci < nclocal; ci++) {
+    const double * _noalias const xi = &xcluster[3*CS*ci];
+    const int * const iatom = &clusteratom[CS*ci];
+    const int * const itype = &clustertype[CS*ci];
+
+    double fpi[CS],fxi[CS],fyi[CS],fzi[CS];
+    for (int ii = 0; ii < CS; ii++) {
+      fpi[ii] = (iatom[ii] >= 0) ? fp[iatom[ii]] : 0.0;
+      fxi[ii] = fyi[ii] = fzi[ii] = 0.0;
+    }
+
+    for (int k = firstcj[ci]; k < firstcj[ci] + numcj[ci]; k++) {
+      const int cj = cjlist[k];
+      const uint64_t mask = cjmask[k];
+      const double * _noalias const xj = &xcluster[3*CS*cj];
+      const int * const jatom = &clusteratom[CS*cj];
+      const int * const jtype = &clustertype[CS*cj];
+
+      double fpj[CS],fxj[CS],fyj[CS],fzj[CS];
+      for (int jj = 0; jj < CS; jj++) {
+        fpj[jj] = (jatom[jj] >= 0) ? fp[jatom[jj]] : 0.0;
+        fxj[jj] = fyj[jj] = fzj[jj] = 0.0;
+      }
+
+      for (int ii = 0; ii < CS; ii++) {
+        const int it = itype[ii];
+        for (int jj = 0; jj < CS; jj++) {
+          if (!((mask >> (ii*CS + jj)) & 1)) continue;
+          const double delx = xi[ii] - xj[jj];
+          const double dely = xi[CS+ii] - xj[CS+jj];
+          const double delz = xi[2*CS+ii] - xj[2*CS+jj];
+          const double rsq = delx*delx + dely*dely + delz*delz;
+          if (rsq >= cutforcesq) continue;
+
+          ++numforce[iatom[ii]];
+          const int jt = jtype[jj];
+          r = sqrt(rsq);
+          p = r*rdr + 1.0;
+          m = static_cast<int> (p);
+          m = MIN(m,nr-1);
+          p -= m;
+          p = MIN(p,1.0);
+
+          coeff = rhor_spline[type2rhor[it][jt]][m];
+          rhoip = (coeff[0]*p + coeff[1])*p + coeff[2];
+          coeff = rhor_spline[type2rhor[jt][it]][m];
+          rhojp = (coeff[0]*p + coeff[1])*p + coeff[2];
+          coeff = z2r_spline[type2z2r[it][jt]][m];
+          z2p = (coeff[0]*p + coeff[1])*p + coeff[2];
+          z2 = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+
+          recip = 1.0/r;
+          phi = z2*recip;
+          phip = z2p*recip - phi*recip;
+          psip = fpi[ii]*rhojp + fpj[jj]*rhoip + phip;
+          fpair = -scale[it][jt]*psip*recip;
+
+          fxi[ii] += delx*fpair;
+          fyi[ii] += dely*fpair;
+          fzi[ii] += delz*fpair;
+          fxj[jj] -= delx*fpair;
+          fyj[jj] -= dely*fpair;
+          fzj[jj] -= delz*fpair;
+
+          if (EFLAG) evdwl = scale[it][jt]*phi;
+          if (EVFLAG) ev_tally(iatom[ii],jatom[jj],nlocal,1,evdwl,0.0,fpair,delx,dely,delz);
+        }
+      }
+
+      for (int jj = 0; jj < CS; jj++) {
+        const int j = jatom[jj];
+        if (j < 0) continue;
+        f[j][0] += fxj[jj];
+        f[j][1] += fyj[jj];
+        f[j][2] += fzj[jj];
+      }
+    }
+
+    for (int ii = 0; ii < CS; ii++) {
+      const int i = iatom[ii];
+      if (i < 0) continue;
+      f[i][0] += fxi[ii];
+      f[i][1] += fyi[ii];
+      f[i][2] += fzi[ii];
+    }
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
 /* ----------------------------------------------------------------------
    allocate all arrays
 ------------------------------------------------------------------------- */
@@ -424,7 +654,8 @@ void PairEAM::init_style()
   file2array();
   array2spline();
 
-  neighbor->add_request(this);
+  if (cluster_enable) neighbor->add_request(this, NeighConst::REQ_CLUSTER);
+  else neighbor->add_request(this);
   embedstep = -1;
 }
 
@@ -107,6 +107,8 @@ class PairEAM : public Pair {
 
   virtual void read_file(char *);
   virtual void file2array();
+
+  template <int EVFLAG, int EFLAG, int CLUSTERSIZE> void eval_cluster();
 };
 
 }    // namespace LAMMPS_NS
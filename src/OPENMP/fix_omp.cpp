@@ -26,6 +26,7 @@
 #include "force.h"
 #include "neighbor.h"
 #include "neigh_request.h"
+#include "output.h"
 #include "universe.h"
 #include "update.h"
 
@@ -63,7 +64,7 @@ static int get_tid()
 FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
   :  Fix(lmp, narg, arg),
      thr(nullptr), last_omp_style(nullptr), last_pair_hybrid(nullptr),
-     _nthr(-1), _neighbor(true), _mixed(false), _reduced(true),
+     _nthr(-1), _neighbor(true), _comm(true), _dump(true), _mixed(false), _reduced(true),
      _pair_compute_flag(false), _kspace_compute_flag(false)
 {
   if (narg < 4) error->all(FLERR,"Illegal package omp command");
@@ -101,9 +102,20 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
       _neighbor = utils::logical(FLERR,arg[iarg+1],false,lmp) != 0;
       iarg += 2;
+    } else if (strcmp(arg[iarg],"comm") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
+      _comm = utils::logical(FLERR,arg[iarg+1],false,lmp) != 0;
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"dump") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
+      _dump = utils::logical(FLERR,arg[iarg+1],false,lmp) != 0;
+      iarg += 2;
     } else error->all(FLERR,"Illegal package omp command");
   }
 
+  comm->pack_threaded = _comm ? 1 : 0;
+  output->dump_threaded = _dump ? 1 : 0;
+
   // print summary of settings
 
   if (comm->me == 0) {
@@ -113,6 +125,8 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
     if (reset_thr)
       utils::logmesg(lmp, "set {} OpenMP thread(s) per MPI task\n", nthreads);
     utils::logmesg(lmp, "using {} neighbor list subroutines\n", nmode);
+    if (_comm) utils::logmesg(lmp, "using multi-threaded comm buffer packing\n");
+    if (_dump) utils::logmesg(lmp, "using multi-threaded dump output formatting\n");
 #else
     error->warning(FLERR,"OpenMP support not enabled during compilation; "
                          "using 1 thread only.");
@@ -139,6 +153,9 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
 
 FixOMP::~FixOMP()
 {
+  comm->pack_threaded = 0;
+  if (output) output->dump_threaded = 0;
+
   for (int i=0; i < _nthr; ++i)
     delete thr[i];
 
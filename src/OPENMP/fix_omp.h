@@ -67,6 +67,8 @@ class FixOMP : public Fix {
  private:
   int _nthr;                    // number of currently active ThrData objects
   bool _neighbor;               // en/disable threads for neighbor list construction
+  bool _comm;                   // en/disable threads for comm buffer pack/unpack
+  bool _dump;                   // en/disable threads for formatting of text dumps
   bool _mixed;                  // whether to prefer mixed precision compute kernels
   bool _reduced;                // whether forces have been reduced for this step
   bool _pair_compute_flag;      // whether pair_compute is called
@@ -396,6 +396,8 @@ void PPPMDispOMP::particle_map(double dxinv, double dyinv,
   int flag_all;
   MPI_Allreduce(&flag,&flag_all,1,MPI_INT,MPI_SUM,world);
   if (flag_all) error->all(FLERR,"Out of range atoms - cannot compute PPPM");
+
+  tile_sort(part2grid,nlw,nup,nylo_o,nyhi_o,nzlo_o,nzhi_o);
 }
 
 /* ----------------------------------------------------------------------
@@ -433,9 +435,11 @@ void PPPMDispOMP::make_rho_c()
     const double boxloy = boxlo[1];
     const double boxloz = boxlo[2];
 
-    // determine range of grid points handled by this thread
-    int i,jfrom,jto,tid;
-    loop_setup_thr(jfrom,jto,tid,ngrid,comm->nthreads);
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
 
     // get per thread data
     ThrData *thr = fix->get_thr(tid);
@@ -446,42 +450,43 @@ void PPPMDispOMP::make_rho_c()
     // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
     // (dx,dy,dz) = distance to "lower left" grid pt
 
-    // loop over all local atoms for all threads
-    for (i = 0; i < nlocal; i++) {
+    // threads spread whole tiles of particles, one color at a time,
+    // stencils of tiles of the same color never overlap
 
-      const int nx = p2g[i].a;
-      const int ny = p2g[i].b;
-      const int nz = p2g[i].t;
+    for (int color = 0; color < 4; color++) {
+      const int ntile = ntile_color(color);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+      for (int k = 0; k < ntile; k++) {
+        const int t = tile_color(color,k);
 
-      // pre-screen whether this atom will ever come within
-      // reach of the data segement this thread is updating.
-      if ( ((nz+nlower-nzlo_out)*ix*iy >= jto)
-           || ((nz+nupper-nzlo_out+1)*ix*iy < jfrom) ) continue;
+        for (int ii = tile_start[t]; ii < tile_start[t+1]; ii++) {
+          const int i = tile_order[ii];
 
-      const FFT_SCALAR dx = nx+shiftone - (x[i].x-boxlox)*delxinv;
-      const FFT_SCALAR dy = ny+shiftone - (x[i].y-boxloy)*delyinv;
-      const FFT_SCALAR dz = nz+shiftone - (x[i].z-boxloz)*delzinv;
+          const int nx = p2g[i].a;
+          const int ny = p2g[i].b;
+          const int nz = p2g[i].t;
 
-      compute_rho1d_thr(r1d,dx,dy,dz,order,rho_coeff);
+          const FFT_SCALAR dx = nx+shiftone - (x[i].x-boxlox)*delxinv;
+          const FFT_SCALAR dy = ny+shiftone - (x[i].y-boxloy)*delyinv;
+          const FFT_SCALAR dz = nz+shiftone - (x[i].z-boxloz)*delzinv;
 
-      const FFT_SCALAR z0 = delvolinv * q[i];
+          compute_rho1d_thr(r1d,dx,dy,dz,order,rho_coeff);
 
-      for (int n = nlower; n <= nupper; ++n) {
-        const int jn = (nz+n-nzlo_out)*ix*iy;
-        const FFT_SCALAR y0 = z0*r1d[2][n];
+          const FFT_SCALAR z0 = delvolinv * q[i];
 
-        for (int m = nlower; m <= nupper; ++m) {
-          const int jm = jn+(ny+m-nylo_out)*ix;
-          const FFT_SCALAR x0 = y0*r1d[1][m];
+          for (int n = nlower; n <= nupper; ++n) {
+            const int jn = (nz+n-nzlo_out)*ix*iy;
+            const FFT_SCALAR y0 = z0*r1d[2][n];
 
-          for (int l = nlower; l <= nupper; ++l) {
-            const int jl = jm+nx+l-nxlo_out;
-            // make sure each thread only updates
-            // "his" elements of the density grid
-            if (jl >= jto) break;
-            if (jl < jfrom) continue;
+            for (int m = nlower; m <= nupper; ++m) {
+              const int jm = jn+(ny+m-nylo_out)*ix+nx-nxlo_out;
+              const FFT_SCALAR x0 = y0*r1d[1][m];
 
-            d[jl] += x0*r1d[0][l];
+              for (int l = nlower; l <= nupper; ++l)
+                d[jm+l] += x0*r1d[0][l];
+            }
           }
         }
       }
@@ -522,9 +527,11 @@ void PPPMDispOMP::make_rho_g()
     const double boxloy = boxlo[1];
     const double boxloz = boxlo[2];
 
-    // determine range of grid points handled by this thread
-    int i,jfrom,jto,tid;
-    loop_setup_thr(jfrom,jto,tid,ngrid_6,comm->nthreads);
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
 
     // get per thread data
     ThrData *thr = fix->get_thr(tid);
@@ -535,44 +542,45 @@ void PPPMDispOMP::make_rho_g()
     // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
     // (dx,dy,dz) = distance to "lower left" grid pt
 
-    // loop over all local atoms for all threads
-    for (i = 0; i < nlocal; i++) {
+    // threads spread whole tiles of particles, one color at a time,
+    // stencils of tiles of the same color never overlap
 
-      const int nx = p2g[i].a;
-      const int ny = p2g[i].b;
-      const int nz = p2g[i].t;
+    for (int color = 0; color < 4; color++) {
+      const int ntile = ntile_color(color);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+      for (int k = 0; k < ntile; k++) {
+        const int t = tile_color(color,k);
 
-      // pre-screen whether this atom will ever come within
-      // reach of the data segement this thread is updating.
-      if ( ((nz+nlower_6-nzlo_out_6)*ix*iy >= jto)
-           || ((nz+nupper_6-nzlo_out_6+1)*ix*iy < jfrom) ) continue;
+        for (int ii = tile_start[t]; ii < tile_start[t+1]; ii++) {
+          const int i = tile_order[ii];
 
-      const FFT_SCALAR dx = nx+shiftone_6 - (x[i].x-boxlox)*delxinv_6;
-      const FFT_SCALAR dy = ny+shiftone_6 - (x[i].y-boxloy)*delyinv_6;
-      const FFT_SCALAR dz = nz+shiftone_6 - (x[i].z-boxloz)*delzinv_6;
+          const int nx = p2g[i].a;
+          const int ny = p2g[i].b;
+          const int nz = p2g[i].t;
 
-      compute_rho1d_thr(r1d,dx,dy,dz,order_6,rho_coeff_6);
+          const FFT_SCALAR dx = nx+shiftone_6 - (x[i].x-boxlox)*delxinv_6;
+          const FFT_SCALAR dy = ny+shiftone_6 - (x[i].y-boxloy)*delyinv_6;
+          const FFT_SCALAR dz = nz+shiftone_6 - (x[i].z-boxloz)*delzinv_6;
 
-      const int type = atom->type[i];
-      const double lj = B[type];
-      const FFT_SCALAR z0 = delvolinv_6 * lj;
+          compute_rho1d_thr(r1d,dx,dy,dz,order_6,rho_coeff_6);
 
-      for (int n = nlower_6; n <= nupper_6; ++n) {
-        const int jn = (nz+n-nzlo_out_6)*ix*iy;
-        const FFT_SCALAR y0 = z0*r1d[2][n];
+          const int type = atom->type[i];
+          const double lj = B[type];
+          const FFT_SCALAR z0 = delvolinv_6 * lj;
 
-        for (int m = nlower_6; m <= nupper_6; ++m) {
-          const int jm = jn+(ny+m-nylo_out_6)*ix;
-          const FFT_SCALAR x0 = y0*r1d[1][m];
+          for (int n = nlower_6; n <= nupper_6; ++n) {
+            const int jn = (nz+n-nzlo_out_6)*ix*iy;
+            const FFT_SCALAR y0 = z0*r1d[2][n];
 
-          for (int l = nlower_6; l <= nupper_6; ++l) {
-            const int jl = jm+nx+l-nxlo_out_6;
-            // make sure each thread only updates
-            // "his" elements of the density grid
-            if (jl >= jto) break;
-            if (jl < jfrom) continue;
+            for (int m = nlower_6; m <= nupper_6; ++m) {
+              const int jm = jn+(ny+m-nylo_out_6)*ix+nx-nxlo_out_6;
+              const FFT_SCALAR x0 = y0*r1d[1][m];
 
-            d[jl] += x0*r1d[0][l];
+              for (int l = nlower_6; l <= nupper_6; ++l)
+                d[jm+l] += x0*r1d[0][l];
+            }
           }
         }
       }
@@ -626,9 +634,11 @@ void PPPMDispOMP::make_rho_a()
     const double boxloy = boxlo[1];
     const double boxloz = boxlo[2];
 
-    // determine range of grid points handled by this thread
-    int i,jfrom,jto,tid;
-    loop_setup_thr(jfrom,jto,tid,ngrid_6,comm->nthreads);
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
 
     // get per thread data
     ThrData *thr = fix->get_thr(tid);
@@ -639,59 +649,62 @@ void PPPMDispOMP::make_rho_a()
     // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
     // (dx,dy,dz) = distance to "lower left" grid pt
 
-    // loop over all local atoms for all threads
-    for (i = 0; i < nlocal; i++) {
-
-      const int nx = p2g[i].a;
-      const int ny = p2g[i].b;
-      const int nz = p2g[i].t;
-
-      // pre-screen whether this atom will ever come within
-      // reach of the data segement this thread is updating.
-      if ( ((nz+nlower_6-nzlo_out_6)*ix*iy >= jto)
-           || ((nz+nupper_6-nzlo_out_6+1)*ix*iy < jfrom) ) continue;
-
-      const FFT_SCALAR dx = nx+shiftone_6 - (x[i].x-boxlox)*delxinv_6;
-      const FFT_SCALAR dy = ny+shiftone_6 - (x[i].y-boxloy)*delyinv_6;
-      const FFT_SCALAR dz = nz+shiftone_6 - (x[i].z-boxloz)*delzinv_6;
-
-      compute_rho1d_thr(r1d,dx,dy,dz,order_6,rho_coeff_6);
-
-      const int type = atom->type[i];
-      const double lj0 = B[7*type];
-      const double lj1 = B[7*type+1];
-      const double lj2 = B[7*type+2];
-      const double lj3 = B[7*type+3];
-      const double lj4 = B[7*type+4];
-      const double lj5 = B[7*type+5];
-      const double lj6 = B[7*type+6];
-
-      const FFT_SCALAR z0 = delvolinv_6;
-
-      for (int n = nlower_6; n <= nupper_6; ++n) {
-        const int jn = (nz+n-nzlo_out_6)*ix*iy;
-        const FFT_SCALAR y0 = z0*r1d[2][n];
-
-        for (int m = nlower_6; m <= nupper_6; ++m) {
-          const int jm = jn+(ny+m-nylo_out_6)*ix;
-          const FFT_SCALAR x0 = y0*r1d[1][m];
-
-          for (int l = nlower_6; l <= nupper_6; ++l) {
-            const int jl = jm+nx+l-nxlo_out_6;
-            // make sure each thread only updates
-            // "his" elements of the density grid
-            if (jl >= jto) break;
-            if (jl < jfrom) continue;
-
-            const double w = x0*r1d[0][l];
-
-            d0[jl] += w*lj0;
-            d1[jl] += w*lj1;
-            d2[jl] += w*lj2;
-            d3[jl] += w*lj3;
-            d4[jl] += w*lj4;
-            d5[jl] += w*lj5;
-            d6[jl] += w*lj6;
+    // threads spread whole tiles of particles, one color at a time,
+    // stencils of tiles of the same color never overlap
+
+    for (int color = 0; color < 4; color++) {
+      const int ntile = ntile_color(color);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+      for (int k = 0; k < ntile; k++) {
+        const int t = tile_color(color,k);
+
+        for (int ii = tile_start[t]; ii < tile_start[t+1]; ii++) {
+          const int i = tile_order[ii];
+
+          const int nx = p2g[i].a;
+          const int ny = p2g[i].b;
+          const int nz = p2g[i].t;
+
+          const FFT_SCALAR dx = nx+shiftone_6 - (x[i].x-boxlox)*delxinv_6;
+          const FFT_SCALAR dy = ny+shiftone_6 - (x[i].y-boxloy)*delyinv_6;
+          const FFT_SCALAR dz = nz+shiftone_6 - (x[i].z-boxloz)*delzinv_6;
+
+          compute_rho1d_thr(r1d,dx,dy,dz,order_6,rho_coeff_6);
+
+          const int type = atom->type[i];
+          const double lj0 = B[7*type];
+          const double lj1 = B[7*type+1];
+          const double lj2 = B[7*type+2];
+          const double lj3 = B[7*type+3];
+          const double lj4 = B[7*type+4];
+          const double lj5 = B[7*type+5];
+          const double lj6 = B[7*type+6];
+
+          const FFT_SCALAR z0 = delvolinv_6;
+
+          for (int n = nlower_6; n <= nupper_6; ++n) {
+            const int jn = (nz+n-nzlo_out_6)*ix*iy;
+            const FFT_SCALAR y0 = z0*r1d[2][n];
+
+            for (int m = nlower_6; m <= nupper_6; ++m) {
+              const int jm = jn+(ny+m-nylo_out_6)*ix+nx-nxlo_out_6;
+              const FFT_SCALAR x0 = y0*r1d[1][m];
+
+              for (int l = nlower_6; l <= nupper_6; ++l) {
+                const int jl = jm+l;
+                const double w = x0*r1d[0][l];
+
+                d0[jl] += w*lj0;
+                d1[jl] += w*lj1;
+                d2[jl] += w*lj2;
+                d3[jl] += w*lj3;
+                d4[jl] += w*lj4;
+                d5[jl] += w*lj5;
+                d6[jl] += w*lj6;
+              }
+            }
           }
         }
       }
@@ -752,7 +765,8 @@ void PPPMDispOMP::fieldforce_c_ik()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid[i][0];
         ny = part2grid[i][1];
@@ -860,7 +874,8 @@ void PPPMDispOMP::fieldforce_c_ad()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid[i][0];
         ny = part2grid[i][1];
@@ -963,7 +978,8 @@ void PPPMDispOMP::fieldforce_c_peratom()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid[i][0];
         ny = part2grid[i][1];
@@ -1065,7 +1081,8 @@ void PPPMDispOMP::fieldforce_g_ik()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid_6[i][0];
         ny = part2grid_6[i][1];
@@ -1172,7 +1189,8 @@ void PPPMDispOMP::fieldforce_g_ad()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid_6[i][0];
         ny = part2grid_6[i][1];
@@ -1278,7 +1296,8 @@ void PPPMDispOMP::fieldforce_g_peratom()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid_6[i][0];
         ny = part2grid_6[i][1];
@@ -1383,7 +1402,8 @@ void PPPMDispOMP::fieldforce_a_ik()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid_6[i][0];
         ny = part2grid_6[i][1];
@@ -1522,7 +1542,8 @@ void PPPMDispOMP::fieldforce_a_ad()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid_6[i][0];
         ny = part2grid_6[i][1];
@@ -1699,7 +1720,8 @@ void PPPMDispOMP::fieldforce_a_peratom()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid_6[i][0];
         ny = part2grid_6[i][1];
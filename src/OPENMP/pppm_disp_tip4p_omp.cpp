@@ -398,6 +398,8 @@ void PPPMDispTIP4POMP::particle_map_c(double dxinv, double dyinv,
   int flag_all;
   MPI_Allreduce(&flag,&flag_all,1,MPI_INT,MPI_SUM,world);
   if (flag_all) error->all(FLERR,"Out of range atoms - cannot compute PPPM");
+
+  tile_sort(part2grid,nlw,nup,nylo_o,nyhi_o,nzlo_o,nzhi_o);
 }
 
 /* ----------------------------------------------------------------------
@@ -466,6 +468,8 @@ void PPPMDispTIP4POMP::particle_map(double dxinv, double dyinv,
   int flag_all;
   MPI_Allreduce(&flag,&flag_all,1,MPI_INT,MPI_SUM,world);
   if (flag_all) error->all(FLERR,"Out of range atoms - cannot compute PPPM");
+
+  tile_sort(part2grid,nlw,nup,nylo_o,nyhi_o,nzlo_o,nzhi_o);
 }
 
 /* ----------------------------------------------------------------------
@@ -505,9 +509,12 @@ void PPPMDispTIP4POMP::make_rho_c()
     const double boxloy = boxlo[1];
     const double boxloz = boxlo[2];
 
-    // determine range of grid points handled by this thread
-    int i,jfrom,jto,tid,iH1,iH2;
-    loop_setup_thr(jfrom,jto,tid,ngrid,comm->nthreads);
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
+    int iH1,iH2;
 
     // get per thread data
     ThrData *thr = fix->get_thr(tid);
@@ -517,47 +524,48 @@ void PPPMDispTIP4POMP::make_rho_c()
     // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
     // (dx,dy,dz) = distance to "lower left" grid pt
 
-    // loop over all local atoms for all threads
-    for (i = 0; i < nlocal; i++) {
+    // threads spread whole tiles of particles, one color at a time,
+    // stencils of tiles of the same color never overlap
 
-      const int nx = p2g[i].a;
-      const int ny = p2g[i].b;
-      const int nz = p2g[i].t;
+    for (int color = 0; color < 4; color++) {
+      const int ntile = ntile_color(color);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+      for (int k = 0; k < ntile; k++) {
+        const int t = tile_color(color,k);
 
-      // pre-screen whether this atom will ever come within
-      // reach of the data segement this thread is updating.
-      if ( ((nz+nlower-nzlo_out)*ix*iy >= jto)
-           || ((nz+nupper-nzlo_out+1)*ix*iy < jfrom) ) continue;
+        for (int ii = tile_start[t]; ii < tile_start[t+1]; ii++) {
+          const int i = tile_order[ii];
 
-      if (type[i] == typeO) {
-        find_M_thr(i,iH1,iH2,xM);
-      } else {
-        xM = x[i];
-      }
-      const FFT_SCALAR dx = nx+shiftone - (xM.x-boxlox)*delxinv;
-      const FFT_SCALAR dy = ny+shiftone - (xM.y-boxloy)*delyinv;
-      const FFT_SCALAR dz = nz+shiftone - (xM.z-boxloz)*delzinv;
+          const int nx = p2g[i].a;
+          const int ny = p2g[i].b;
+          const int nz = p2g[i].t;
 
-      compute_rho1d_thr(r1d,dx,dy,dz,order,rho_coeff);
+          if (type[i] == typeO) {
+            find_M_thr(i,iH1,iH2,xM);
+          } else {
+            xM = x[i];
+          }
+          const FFT_SCALAR dx = nx+shiftone - (xM.x-boxlox)*delxinv;
+          const FFT_SCALAR dy = ny+shiftone - (xM.y-boxloy)*delyinv;
+          const FFT_SCALAR dz = nz+shiftone - (xM.z-boxloz)*delzinv;
 
-      const FFT_SCALAR z0 = delvolinv * q[i];
+          compute_rho1d_thr(r1d,dx,dy,dz,order,rho_coeff);
 
-      for (int n = nlower; n <= nupper; ++n) {
-        const int jn = (nz+n-nzlo_out)*ix*iy;
-        const FFT_SCALAR y0 = z0*r1d[2][n];
+          const FFT_SCALAR z0 = delvolinv * q[i];
 
-        for (int m = nlower; m <= nupper; ++m) {
-          const int jm = jn+(ny+m-nylo_out)*ix;
-          const FFT_SCALAR x0 = y0*r1d[1][m];
+          for (int n = nlower; n <= nupper; ++n) {
+            const int jn = (nz+n-nzlo_out)*ix*iy;
+            const FFT_SCALAR y0 = z0*r1d[2][n];
 
-          for (int l = nlower; l <= nupper; ++l) {
-            const int jl = jm+nx+l-nxlo_out;
-            // make sure each thread only updates
-            // "his" elements of the density grid
-            if (jl >= jto) break;
-            if (jl < jfrom) continue;
+            for (int m = nlower; m <= nupper; ++m) {
+              const int jm = jn+(ny+m-nylo_out)*ix+nx-nxlo_out;
+              const FFT_SCALAR x0 = y0*r1d[1][m];
 
-            d[jl] += x0*r1d[0][l];
+              for (int l = nlower; l <= nupper; ++l)
+                d[jm+l] += x0*r1d[0][l];
+            }
           }
         }
       }
@@ -597,9 +605,11 @@ void PPPMDispTIP4POMP::make_rho_g()
     const double boxloy = boxlo[1];
     const double boxloz = boxlo[2];
 
-    // determine range of grid points handled by this thread
-    int i,jfrom,jto,tid;
-    loop_setup_thr(jfrom,jto,tid,ngrid_6,comm->nthreads);
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
 
     // get per thread data
     ThrData *thr = fix->get_thr(tid);
@@ -609,44 +619,45 @@ void PPPMDispTIP4POMP::make_rho_g()
     // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
     // (dx,dy,dz) = distance to "lower left" grid pt
 
-    // loop over all local atoms for all threads
-    for (i = 0; i < nlocal; i++) {
+    // threads spread whole tiles of particles, one color at a time,
+    // stencils of tiles of the same color never overlap
 
-      const int nx = p2g[i].a;
-      const int ny = p2g[i].b;
-      const int nz = p2g[i].t;
+    for (int color = 0; color < 4; color++) {
+      const int ntile = ntile_color(color);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+      for (int k = 0; k < ntile; k++) {
+        const int t = tile_color(color,k);
 
-      // pre-screen whether this atom will ever come within
-      // reach of the data segement this thread is updating.
-      if ( ((nz+nlower_6-nzlo_out_6)*ix*iy >= jto)
-           || ((nz+nupper_6-nzlo_out_6+1)*ix*iy < jfrom) ) continue;
+        for (int ii = tile_start[t]; ii < tile_start[t+1]; ii++) {
+          const int i = tile_order[ii];
 
-      const FFT_SCALAR dx = nx+shiftone_6 - (x[i].x-boxlox)*delxinv_6;
-      const FFT_SCALAR dy = ny+shiftone_6 - (x[i].y-boxloy)*delyinv_6;
-      const FFT_SCALAR dz = nz+shiftone_6 - (x[i].z-boxloz)*delzinv_6;
+          const int nx = p2g[i].a;
+          const int ny = p2g[i].b;
+          const int nz = p2g[i].t;
 
-      compute_rho1d_thr(r1d,dx,dy,dz,order_6,rho_coeff_6);
+          const FFT_SCALAR dx = nx+shiftone_6 - (x[i].x-boxlox)*delxinv_6;
+          const FFT_SCALAR dy = ny+shiftone_6 - (x[i].y-boxloy)*delyinv_6;
+          const FFT_SCALAR dz = nz+shiftone_6 - (x[i].z-boxloz)*delzinv_6;
 
-      const int type = atom->type[i];
-      const double lj = B[type];
-      const FFT_SCALAR z0 = delvolinv_6 * lj;
+          compute_rho1d_thr(r1d,dx,dy,dz,order_6,rho_coeff_6);
 
-      for (int n = nlower_6; n <= nupper_6; ++n) {
-        const int jn = (nz+n-nzlo_out_6)*ix*iy;
-        const FFT_SCALAR y0 = z0*r1d[2][n];
+          const int type = atom->type[i];
+          const double lj = B[type];
+          const FFT_SCALAR z0 = delvolinv_6 * lj;
 
-        for (int m = nlower_6; m <= nupper_6; ++m) {
-          const int jm = jn+(ny+m-nylo_out_6)*ix;
-          const FFT_SCALAR x0 = y0*r1d[1][m];
+          for (int n = nlower_6; n <= nupper_6; ++n) {
+            const int jn = (nz+n-nzlo_out_6)*ix*iy;
+            const FFT_SCALAR y0 = z0*r1d[2][n];
 
-          for (int l = nlower_6; l <= nupper_6; ++l) {
-            const int jl = jm+nx+l-nxlo_out_6;
-            // make sure each thread only updates
-            // "his" elements of the density grid
-            if (jl >= jto) break;
-            if (jl < jfrom) continue;
+            for (int m = nlower_6; m <= nupper_6; ++m) {
+              const int jm = jn+(ny+m-nylo_out_6)*ix+nx-nxlo_out_6;
+              const FFT_SCALAR x0 = y0*r1d[1][m];
 
-            d[jl] += x0*r1d[0][l];
+              for (int l = nlower_6; l <= nupper_6; ++l)
+                d[jm+l] += x0*r1d[0][l];
+            }
           }
         }
       }
@@ -699,9 +710,11 @@ void PPPMDispTIP4POMP::make_rho_a()
     const double boxloy = boxlo[1];
     const double boxloz = boxlo[2];
 
-    // determine range of grid points handled by this thread
-    int i,jfrom,jto,tid;
-    loop_setup_thr(jfrom,jto,tid,ngrid_6,comm->nthreads);
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
 
     // get per thread data
     ThrData *thr = fix->get_thr(tid);
@@ -711,59 +724,62 @@ void PPPMDispTIP4POMP::make_rho_a()
     // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
     // (dx,dy,dz) = distance to "lower left" grid pt
 
-    // loop over all local atoms for all threads
-    for (i = 0; i < nlocal; i++) {
+    // threads spread whole tiles of particles, one color at a time,
+    // stencils of tiles of the same color never overlap
 
-      const int nx = p2g[i].a;
-      const int ny = p2g[i].b;
-      const int nz = p2g[i].t;
-
-      // pre-screen whether this atom will ever come within
-      // reach of the data segement this thread is updating.
-      if ( ((nz+nlower_6-nzlo_out_6)*ix*iy >= jto)
-           || ((nz+nupper_6-nzlo_out_6+1)*ix*iy < jfrom) ) continue;
-
-      const FFT_SCALAR dx = nx+shiftone_6 - (x[i].x-boxlox)*delxinv_6;
-      const FFT_SCALAR dy = ny+shiftone_6 - (x[i].y-boxloy)*delyinv_6;
-      const FFT_SCALAR dz = nz+shiftone_6 - (x[i].z-boxloz)*delzinv_6;
-
-      compute_rho1d_thr(r1d,dx,dy,dz,order_6,rho_coeff_6);
-
-      const int type = atom->type[i];
-      const double lj0 = B[7*type];
-      const double lj1 = B[7*type+1];
-      const double lj2 = B[7*type+2];
-      const double lj3 = B[7*type+3];
-      const double lj4 = B[7*type+4];
-      const double lj5 = B[7*type+5];
-      const double lj6 = B[7*type+6];
-
-      const FFT_SCALAR z0 = delvolinv_6;
-
-      for (int n = nlower_6; n <= nupper_6; ++n) {
-        const int jn = (nz+n-nzlo_out_6)*ix*iy;
-        const FFT_SCALAR y0 = z0*r1d[2][n];
-
-        for (int m = nlower_6; m <= nupper_6; ++m) {
-          const int jm = jn+(ny+m-nylo_out_6)*ix;
-          const FFT_SCALAR x0 = y0*r1d[1][m];
-
-          for (int l = nlower_6; l <= nupper_6; ++l) {
-            const int jl = jm+nx+l-nxlo_out_6;
-            // make sure each thread only updates
-            // "his" elements of the density grid
-            if (jl >= jto) break;
-            if (jl < jfrom) continue;
-
-            const double w = x0*r1d[0][l];
-
-            d0[jl] += w*lj0;
-            d1[jl] += w*lj1;
-            d2[jl] += w*lj2;
-            d3[jl] += w*lj3;
-            d4[jl] += w*lj4;
-            d5[jl] += w*lj5;
-            d6[jl] += w*lj6;
+    for (int color = 0; color < 4; color++) {
+      const int ntile = ntile_color(color);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+      for (int k = 0; k < ntile; k++) {
+        const int t = tile_color(color,k);
+
+        for (int ii = tile_start[t]; ii < tile_start[t+1]; ii++) {
+          const int i = tile_order[ii];
+
+          const int nx = p2g[i].a;
+          const int ny = p2g[i].b;
+          const int nz = p2g[i].t;
+
+          const FFT_SCALAR dx = nx+shiftone_6 - (x[i].x-boxlox)*delxinv_6;
+          const FFT_SCALAR dy = ny+shiftone_6 - (x[i].y-boxloy)*delyinv_6;
+          const FFT_SCALAR dz = nz+shiftone_6 - (x[i].z-boxloz)*delzinv_6;
+
+          compute_rho1d_thr(r1d,dx,dy,dz,order_6,rho_coeff_6);
+
+          const int type = atom->type[i];
+          const double lj0 = B[7*type];
+          const double lj1 = B[7*type+1];
+          const double lj2 = B[7*type+2];
+          const double lj3 = B[7*type+3];
+          const double lj4 = B[7*type+4];
+          const double lj5 = B[7*type+5];
+          const double lj6 = B[7*type+6];
+
+          const FFT_SCALAR z0 = delvolinv_6;
+
+          for (int n = nlower_6; n <= nupper_6; ++n) {
+            const int jn = (nz+n-nzlo_out_6)*ix*iy;
+            const FFT_SCALAR y0 = z0*r1d[2][n];
+
+            for (int m = nlower_6; m <= nupper_6; ++m) {
+              const int jm = jn+(ny+m-nylo_out_6)*ix+nx-nxlo_out_6;
+              const FFT_SCALAR x0 = y0*r1d[1][m];
+
+              for (int l = nlower_6; l <= nupper_6; ++l) {
+                const int jl = jm+l;
+                const double w = x0*r1d[0][l];
+
+                d0[jl] += w*lj0;
+                d1[jl] += w*lj1;
+                d2[jl] += w*lj2;
+                d3[jl] += w*lj3;
+                d4[jl] += w*lj4;
+                d5[jl] += w*lj5;
+                d6[jl] += w*lj6;
+              }
+            }
           }
         }
       }
@@ -805,7 +821,7 @@ void PPPMDispTIP4POMP::fieldforce_c_ik()
   {
     dbl3_t xM;
     FFT_SCALAR x0,y0,z0,ekx,eky,ekz;
-    int i,ifrom,ito,tid,iH1,iH2,l,m,n,mx,my,mz;
+    int i,ii,ifrom,ito,tid,iH1,iH2,l,m,n,mx,my,mz;
 
     loop_setup_thr(ifrom,ito,tid,nlocal,comm->nthreads);
 
@@ -814,7 +830,8 @@ void PPPMDispTIP4POMP::fieldforce_c_ik()
     auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
 
-    for (i = ifrom; i < ito; ++i) {
+    for (ii = ifrom; ii < ito; ++ii) {
+      i = tile_order[ii];
       if (type[i] == typeO) {
         find_M_thr(i,iH1,iH2,xM);
       } else xM = x[i];
@@ -914,7 +931,7 @@ void PPPMDispTIP4POMP::fieldforce_c_ad()
     double s1,s2,s3,sf;
     dbl3_t xM;
     FFT_SCALAR ekx,eky,ekz;
-    int i,ifrom,ito,tid,iH1,iH2,l,m,n,mx,my,mz;
+    int i,ii,ifrom,ito,tid,iH1,iH2,l,m,n,mx,my,mz;
 
     loop_setup_thr(ifrom,ito,tid,nlocal,comm->nthreads);
 
@@ -924,7 +941,8 @@ void PPPMDispTIP4POMP::fieldforce_c_ad()
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
     FFT_SCALAR * const * const d1d = static_cast<FFT_SCALAR **>(thr->get_drho1d());
 
-    for (i = ifrom; i < ito; ++i) {
+    for (ii = ifrom; ii < ito; ++ii) {
+      i = tile_order[ii];
       if (type[i] == typeO) {
         find_M_thr(i,iH1,iH2,xM);
       } else xM = x[i];
@@ -1050,7 +1068,8 @@ void PPPMDispTIP4POMP::fieldforce_g_ik()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid_6[i][0];
         ny = part2grid_6[i][1];
@@ -1154,7 +1173,8 @@ void PPPMDispTIP4POMP::fieldforce_g_ad()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid_6[i][0];
         ny = part2grid_6[i][1];
@@ -1257,7 +1277,8 @@ void PPPMDispTIP4POMP::fieldforce_g_peratom()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid_6[i][0];
         ny = part2grid_6[i][1];
@@ -1359,7 +1380,8 @@ void PPPMDispTIP4POMP::fieldforce_a_ik()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid_6[i][0];
         ny = part2grid_6[i][1];
@@ -1495,7 +1517,8 @@ void PPPMDispTIP4POMP::fieldforce_a_ad()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (int i = ifrom; i < ito; i++) {
+      for (int ii = ifrom; ii < ito; ii++) {
+        const int i = tile_order[ii];
 
         nx = part2grid_6[i][0];
         ny = part2grid_6[i][1];
@@ -1655,7 +1678,7 @@ void PPPMDispTIP4POMP::fieldforce_a_peratom()
     ThrData *thr = fix->get_thr(tid);
     FFT_SCALAR * const * const r1d =  static_cast<FFT_SCALAR **>(thr->get_rho1d_6());
 
-    int i,l,m,n,nx,ny,nz,mx,my,mz;
+    int i,ii,l,m,n,nx,ny,nz,mx,my,mz;
     FFT_SCALAR dx,dy,dz,x0,y0,z0;
     FFT_SCALAR u0,v00,v10,v20,v30,v40,v50;
     FFT_SCALAR u1,v01,v11,v21,v31,v41,v51;
@@ -1669,7 +1692,8 @@ void PPPMDispTIP4POMP::fieldforce_a_peratom()
 
     // this if protects against having more threads than local atoms
     if (ifrom < nlocal) {
-      for (i = ifrom; i < ito; i++) {
+      for (ii = ifrom; ii < ito; ii++) {
+        i = tile_order[ii];
 
         nx = part2grid_6[i][0];
         ny = part2grid_6[i][1];
@@ -365,9 +365,11 @@ void PPPMOMP::make_rho()
     const double boxloy = boxlo[1];
     const double boxloz = boxlo[2];
 
-    // determine range of grid points handled by this thread
-    int i,jfrom,jto,tid;
-    loop_setup_thr(jfrom,jto,tid,ngrid,comm->nthreads);
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
 
     // get per thread data
     ThrData *thr = fix->get_thr(tid);
@@ -378,42 +380,42 @@ void PPPMOMP::make_rho()
     // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
     // (dx,dy,dz) = distance to "lower left" grid pt
 
-    // loop over all local atoms for all threads
-    for (i = 0; i < nlocal; i++) {
-
-      const int nx = p2g[i].a;
-      const int ny = p2g[i].b;
-      const int nz = p2g[i].t;
+    // threads spread whole tiles of particles, one color at a time,
+    // stencils of tiles of the same color never overlap
 
-      // pre-screen whether this atom will ever come within
-      // reach of the data segement this thread is updating.
-      if ( ((nz+nlower-nzlo_out)*ix*iy >= jto)
-           || ((nz+nupper-nzlo_out+1)*ix*iy < jfrom) ) continue;
+    for (int color = 0; color < 4; color++) {
+      const int ntile = ntile_color(color);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+      for (int k = 0; k < ntile; k++) {
+        const int t = tile_color(color,k);
 
-      const FFT_SCALAR dx = nx+shiftone - (x[i].x-boxlox)*delxinv;
-      const FFT_SCALAR dy = ny+shiftone - (x[i].y-boxloy)*delyinv;
-      const FFT_SCALAR dz = nz+shiftone - (x[i].z-boxloz)*delzinv;
+        for (int ii = tile_start[t]; ii < tile_start[t+1]; ii++) {
+          const int i = tile_order[ii];
 
-      compute_rho1d_thr(r1d,dx,dy,dz);
+          const int nx = p2g[i].a;
+          const int ny = p2g[i].b;
+          const int nz = p2g[i].t;
+          const FFT_SCALAR dx = nx+shiftone - (x[i].x-boxlox)*delxinv;
+          const FFT_SCALAR dy = ny+shiftone - (x[i].y-boxloy)*delyinv;
+          const FFT_SCALAR dz = nz+shiftone - (x[i].z-boxloz)*delzinv;
 
-      const FFT_SCALAR z0 = delvolinv * q[i];
+          compute_rho1d_thr(r1d,dx,dy,dz);
 
-      for (int n = nlower; n <= nupper; ++n) {
-        const int jn = (nz+n-nzlo_out)*ix*iy;
-        const FFT_SCALAR y0 = z0*r1d[2][n];
+          const FFT_SCALAR z0 = delvolinv * q[i];
 
-        for (int m = nlower; m <= nupper; ++m) {
-          const int jm = jn+(ny+m-nylo_out)*ix;
-          const FFT_SCALAR x0 = y0*r1d[1][m];
+          for (int n = nlower; n <= nupper; ++n) {
+            const int jn = (nz+n-nzlo_out)*ix*iy;
+            const FFT_SCALAR y0 = z0*r1d[2][n];
 
-          for (int l = nlower; l <= nupper; ++l) {
-            const int jl = jm+nx+l-nxlo_out;
-            // make sure each thread only updates
-            // "his" elements of the density grid
-            if (jl >= jto) break;
-            if (jl < jfrom) continue;
+            for (int m = nlower; m <= nupper; ++m) {
+              const int jm = jn+(ny+m-nylo_out)*ix+nx-nxlo_out;
+              const FFT_SCALAR x0 = y0*r1d[1][m];
 
-            d[jl] += x0*r1d[0][l];
+              for (int l = nlower; l <= nupper; ++l)
+                d[jm+l] += x0*r1d[0][l];
+            }
           }
         }
       }
@@ -454,8 +456,9 @@ void PPPMOMP::fieldforce_ik()
 #pragma omp parallel LMP_DEFAULT_NONE
 #endif
   {
-    FFT_SCALAR x0,y0,z0,ekx,eky,ekz;
-    int i,ifrom,ito,tid,l,m,n,mx,my,mz;
+    FFT_SCALAR x0,y0,z0;
+    double ekx,eky,ekz;
+    int i,ii,ifrom,ito,tid,l,m,n,mx,my,mz;
 
     loop_setup_thr(ifrom,ito,tid,nlocal,nthreads);
 
@@ -465,7 +468,8 @@ void PPPMOMP::fieldforce_ik()
     auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
 
-    for (i = ifrom; i < ito; ++i) {
+    for (ii = ifrom; ii < ito; ++ii) {
+      i = tile_order[ii];
       const int nx = p2g[i].a;
       const int ny = p2g[i].b;
       const int nz = p2g[i].t;
@@ -540,8 +544,8 @@ void PPPMOMP::fieldforce_ad()
 #endif
   {
     double s1,s2,s3,sf;
-    FFT_SCALAR ekx,eky,ekz;
-    int i,ifrom,ito,tid,l,m,n,mx,my,mz;
+    double ekx,eky,ekz;
+    int i,ii,ifrom,ito,tid,l,m,n,mx,my,mz;
 
     loop_setup_thr(ifrom,ito,tid,nlocal,nthreads);
 
@@ -552,7 +556,8 @@ void PPPMOMP::fieldforce_ad()
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
     FFT_SCALAR * const * const d1d = static_cast<FFT_SCALAR **>(thr->get_drho1d());
 
-    for (i = ifrom; i < ito; ++i) {
+    for (ii = ifrom; ii < ito; ++ii) {
+      i = tile_order[ii];
       const int nx = p2g[i].a;
       const int ny = p2g[i].b;
       const int nz = p2g[i].t;
@@ -633,8 +638,8 @@ void PPPMOMP::fieldforce_peratom()
 #endif
   {
     FFT_SCALAR dx,dy,dz,x0,y0,z0;
-    FFT_SCALAR u,v0,v1,v2,v3,v4,v5;
-    int i,ifrom,ito,tid,l,m,n,nx,ny,nz,mx,my,mz;
+    double u,v0,v1,v2,v3,v4,v5;
+    int i,ii,ifrom,ito,tid,l,m,n,nx,ny,nz,mx,my,mz;
 
     loop_setup_thr(ifrom,ito,tid,nlocal,nthreads);
 
@@ -643,7 +648,8 @@ void PPPMOMP::fieldforce_peratom()
     thr->timer(Timer::START);
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
 
-    for (i = ifrom; i < ito; ++i) {
+    for (ii = ifrom; ii < ito; ++ii) {
+      i = tile_order[ii];
       nx = part2grid[i][0];
       ny = part2grid[i][1];
       nz = part2grid[i][2];
@@ -393,6 +393,8 @@ void PPPMTIP4POMP::particle_map()
   int flag_all;
   MPI_Allreduce(&flag,&flag_all,1,MPI_INT,MPI_SUM,world);
   if (flag_all) error->all(FLERR,"Out of range atoms - cannot compute PPPM");
+
+  tile_sort(part2grid,nlower,nupper,nylo_out,nyhi_out,nzlo_out,nzhi_out);
 }
 
 /* ----------------------------------------------------------------------
@@ -432,9 +434,12 @@ void PPPMTIP4POMP::make_rho()
     const double boxloy = boxlo[1];
     const double boxloz = boxlo[2];
 
-    // determine range of grid points handled by this thread
-    int i,jfrom,jto,tid,iH1,iH2;
-    loop_setup_thr(jfrom,jto,tid,ngrid,comm->nthreads);
+    int iH1,iH2;
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
 
     // get per thread data
     ThrData *thr = fix->get_thr(tid);
@@ -445,47 +450,48 @@ void PPPMTIP4POMP::make_rho()
     // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
     // (dx,dy,dz) = distance to "lower left" grid pt
 
-    // loop over all local atoms for all threads
-    for (i = 0; i < nlocal; i++) {
+    // threads spread whole tiles of particles, one color at a time,
+    // stencils of tiles of the same color never overlap
 
-      const int nx = p2g[i].a;
-      const int ny = p2g[i].b;
-      const int nz = p2g[i].t;
+    for (int color = 0; color < 4; color++) {
+      const int ntile = ntile_color(color);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+      for (int k = 0; k < ntile; k++) {
+        const int t = tile_color(color,k);
 
-      // pre-screen whether this atom will ever come within
-      // reach of the data segement this thread is updating.
-      if ( ((nz+nlower-nzlo_out)*ix*iy >= jto)
-           || ((nz+nupper-nzlo_out+1)*ix*iy < jfrom) ) continue;
+        for (int ii = tile_start[t]; ii < tile_start[t+1]; ii++) {
+          const int i = tile_order[ii];
 
-      if (type[i] == typeO) {
-        find_M_thr(i,iH1,iH2,xM);
-      } else {
-        xM = x[i];
-      }
-      const FFT_SCALAR dx = nx+shiftone - (xM.x-boxlox)*delxinv;
-      const FFT_SCALAR dy = ny+shiftone - (xM.y-boxloy)*delyinv;
-      const FFT_SCALAR dz = nz+shiftone - (xM.z-boxloz)*delzinv;
+          const int nx = p2g[i].a;
+          const int ny = p2g[i].b;
+          const int nz = p2g[i].t;
 
-      compute_rho1d_thr(r1d,dx,dy,dz);
+          if (type[i] == typeO) {
+            find_M_thr(i,iH1,iH2,xM);
+          } else {
+            xM = x[i];
+          }
+          const FFT_SCALAR dx = nx+shiftone - (xM.x-boxlox)*delxinv;
+          const FFT_SCALAR dy = ny+shiftone - (xM.y-boxloy)*delyinv;
+          const FFT_SCALAR dz = nz+shiftone - (xM.z-boxloz)*delzinv;
 
-      const FFT_SCALAR z0 = delvolinv * q[i];
+          compute_rho1d_thr(r1d,dx,dy,dz);
 
-      for (int n = nlower; n <= nupper; ++n) {
-        const int jn = (nz+n-nzlo_out)*ix*iy;
-        const FFT_SCALAR y0 = z0*r1d[2][n];
+          const FFT_SCALAR z0 = delvolinv * q[i];
 
-        for (int m = nlower; m <= nupper; ++m) {
-          const int jm = jn+(ny+m-nylo_out)*ix;
-          const FFT_SCALAR x0 = y0*r1d[1][m];
+          for (int n = nlower; n <= nupper; ++n) {
+            const int jn = (nz+n-nzlo_out)*ix*iy;
+            const FFT_SCALAR y0 = z0*r1d[2][n];
 
-          for (int l = nlower; l <= nupper; ++l) {
-            const int jl = jm+nx+l-nxlo_out;
-            // make sure each thread only updates
-            // "his" elements of the density grid
-            if (jl >= jto) break;
-            if (jl < jfrom) continue;
+            for (int m = nlower; m <= nupper; ++m) {
+              const int jm = jn+(ny+m-nylo_out)*ix+nx-nxlo_out;
+              const FFT_SCALAR x0 = y0*r1d[1][m];
 
-            d[jl] += x0*r1d[0][l];
+              for (int l = nlower; l <= nupper; ++l)
+                d[jm+l] += x0*r1d[0][l];
+            }
           }
         }
       }
@@ -528,8 +534,9 @@ void PPPMTIP4POMP::fieldforce_ik()
 #endif
   {
     dbl3_t xM;
-    FFT_SCALAR x0,y0,z0,ekx,eky,ekz;
-    int i,ifrom,ito,tid,iH1,iH2,l,m,n,mx,my,mz;
+    FFT_SCALAR x0,y0,z0;
+    double ekx,eky,ekz;
+    int i,ii,ifrom,ito,tid,iH1,iH2,l,m,n,mx,my,mz;
 
     loop_setup_thr(ifrom,ito,tid,nlocal,nthreads);
 
@@ -539,7 +546,8 @@ void PPPMTIP4POMP::fieldforce_ik()
     auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
 
-    for (i = ifrom; i < ito; ++i) {
+    for (ii = ifrom; ii < ito; ++ii) {
+      i = tile_order[ii];
       if (type[i] == typeO) {
         find_M_thr(i,iH1,iH2,xM);
       } else xM = x[i];
@@ -640,8 +648,8 @@ void PPPMTIP4POMP::fieldforce_ad()
   {
     double s1,s2,s3,sf;
     dbl3_t xM;
-    FFT_SCALAR ekx,eky,ekz;
-    int i,ifrom,ito,tid,iH1,iH2,l,m,n,mx,my,mz;
+    double ekx,eky,ekz;
+    int i,ii,ifrom,ito,tid,iH1,iH2,l,m,n,mx,my,mz;
 
     loop_setup_thr(ifrom,ito,tid,nlocal,nthreads);
 
@@ -652,7 +660,8 @@ void PPPMTIP4POMP::fieldforce_ad()
     FFT_SCALAR * const * const r1d = static_cast<FFT_SCALAR **>(thr->get_rho1d());
     FFT_SCALAR * const * const d1d = static_cast<FFT_SCALAR **>(thr->get_drho1d());
 
-    for (i = ifrom; i < ito; ++i) {
+    for (ii = ifrom; ii < ito; ++ii) {
+      i = tile_order[ii];
       if (type[i] == typeO) {
         find_M_thr(i,iH1,iH2,xM);
       } else xM = x[i];
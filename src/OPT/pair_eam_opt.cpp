@@ -34,7 +34,10 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-PairEAMOpt::PairEAMOpt(LAMMPS *lmp) : PairEAM(lmp) {}
+PairEAMOpt::PairEAMOpt(LAMMPS *lmp) : PairEAM(lmp)
+{
+  cluster_enable = 0;
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -33,6 +33,7 @@ using namespace LAMMPS_NS;
 PairLJCutCoulLongOpt::PairLJCutCoulLongOpt(LAMMPS *lmp) : PairLJCutCoulLong(lmp)
 {
   respa_enable = 0;
+  cluster_enable = 0;
 }
 
 /* ---------------------------------------------------------------------- */
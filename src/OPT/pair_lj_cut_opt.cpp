@@ -29,7 +29,11 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-PairLJCutOpt::PairLJCutOpt(LAMMPS *lmp) : PairLJCut(lmp) {}
+PairLJCutOpt::PairLJCutOpt(LAMMPS *lmp) : PairLJCut(lmp)
+{
+  cluster_enable = 0;
+  soa_enable = 0;
+}
 
 /* ---------------------------------------------------------------------- */
 
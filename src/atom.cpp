@@ -29,6 +29,7 @@
 #include "modify.h"
 #include "molecule.h"
 #include "neighbor.h"
+#include "pair.h"
 #include "tokenizer.h"
 #include "update.h"
 #include "variable.h"
@@ -37,6 +38,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <vector>
 
 #ifdef LMP_GPU
 #include "fix_gpu.h"
@@ -100,8 +102,12 @@ Atom::Atom(LAMMPS *lmp) : Pointers(lmp)
   sortfreq = 1000;
   nextsort = 0;
   userbinsize = 0.0;
+  sortstyle = SORT_BIN;
+  soa_flag = soa_active = 0;
+  maxsoa = 0;
+  xsoa[0] = xsoa[1] = xsoa[2] = nullptr;
   maxbin = maxnext = 0;
-  binhead = nullptr;
+  binhead = binorder = nullptr;
   next = permute = nullptr;
 
   // --------------------------------------------------------------------
@@ -286,7 +292,9 @@ Atom::~Atom()
 
   delete[] firstgroupname;
   memory->destroy(binhead);
+  memory->destroy(binorder);
   memory->destroy(next);
+  memory->destroy(xsoa[0]);
   memory->destroy(permute);
 
   memory->destroy(tag);
@@ -363,6 +371,8 @@ void Atom::settings(Atom *old)
   map_style = old->map_style;
   sortfreq = old->sortfreq;
   userbinsize = old->userbinsize;
+  sortstyle = old->sortstyle;
+  soa_flag = old->soa_flag;
   if (old->firstgroupname)
     firstgroupname = utils::strdup(old->firstgroupname);
 }
@@ -733,6 +743,18 @@ void Atom::init()
       error->all(FLERR,"Could not find atom_modify first group ID {}", firstgroupname);
   } else firstgroup = -1;
 
+  // structure-of-arrays coords are only maintained if the pair style reads them
+
+  soa_active = (soa_flag && force->pair && force->pair->soa_enable) ? 1 : 0;
+  if (soa_flag && !soa_active) {
+    if (comm->me == 0)
+      error->warning(FLERR,"Atom_modify soa has no effect with pair style {}",
+                     force->pair_style ? force->pair_style : "none");
+    memory->destroy(xsoa[0]);
+    xsoa[0] = xsoa[1] = xsoa[2] = nullptr;
+    maxsoa = 0;
+  }
+
   // init AtomVec
 
   avec->init();
@@ -803,6 +825,16 @@ void Atom::modify_params(int narg, char **arg)
         sortfreq = 0;
       }
       iarg += 2;
+    } else if (strcmp(arg[iarg],"soa") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "atom_modify soa", error);
+      soa_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (!soa_flag) {
+        soa_active = 0;
+        memory->destroy(xsoa[0]);
+        xsoa[0] = xsoa[1] = xsoa[2] = nullptr;
+        maxsoa = 0;
+      }
+      iarg += 2;
     } else if (strcmp(arg[iarg],"sort") == 0) {
       if (iarg+3 > narg) utils::missing_cmd_args(FLERR, "atom_modify sort", error);
       sortfreq = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
@@ -812,6 +844,18 @@ void Atom::modify_params(int narg, char **arg)
       if ((sortfreq >= 0) && firstgroupname)
         error->all(FLERR,"Atom_modify sort and first options cannot be used together");
       iarg += 3;
+      if (iarg < narg) {
+        if (strcmp(arg[iarg],"bin") == 0) {
+          sortstyle = SORT_BIN;
+          iarg++;
+        } else if (strcmp(arg[iarg],"morton") == 0) {
+          sortstyle = SORT_MORTON;
+          iarg++;
+        } else if (strcmp(arg[iarg],"hilbert") == 0) {
+          sortstyle = SORT_HILBERT;
+          iarg++;
+        }
+      }
     } else error->all(FLERR,"Illegal atom_modify command argument: {}", arg[iarg]);
   }
 }
@@ -1024,58 +1068,10 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     error->all(FLERR,"Incorrect atom format in data file: {}", utils::trim(buf));
 
   // set bounds for my proc
-  // if periodic and I am lo/hi proc, adjust bounds by EPSILON
-  // insures all data atoms will be owned even with round-off
 
   int triclinic = domain->triclinic;
-
-  double epsilon[3];
-  if (triclinic) epsilon[0] = epsilon[1] = epsilon[2] = EPSILON;
-  else {
-    epsilon[0] = domain->prd[0] * EPSILON;
-    epsilon[1] = domain->prd[1] * EPSILON;
-    epsilon[2] = domain->prd[2] * EPSILON;
-  }
-
   double sublo[3],subhi[3];
-  if (triclinic == 0) {
-    sublo[0] = domain->sublo[0]; subhi[0] = domain->subhi[0];
-    sublo[1] = domain->sublo[1]; subhi[1] = domain->subhi[1];
-    sublo[2] = domain->sublo[2]; subhi[2] = domain->subhi[2];
-  } else {
-    sublo[0] = domain->sublo_lamda[0]; subhi[0] = domain->subhi_lamda[0];
-    sublo[1] = domain->sublo_lamda[1]; subhi[1] = domain->subhi_lamda[1];
-    sublo[2] = domain->sublo_lamda[2]; subhi[2] = domain->subhi_lamda[2];
-  }
-
-  if (comm->layout != Comm::LAYOUT_TILED) {
-    if (domain->xperiodic) {
-      if (comm->myloc[0] == 0) sublo[0] -= epsilon[0];
-      if (comm->myloc[0] == comm->procgrid[0]-1) subhi[0] += epsilon[0];
-    }
-    if (domain->yperiodic) {
-      if (comm->myloc[1] == 0) sublo[1] -= epsilon[1];
-      if (comm->myloc[1] == comm->procgrid[1]-1) subhi[1] += epsilon[1];
-    }
-    if (domain->zperiodic) {
-      if (comm->myloc[2] == 0) sublo[2] -= epsilon[2];
-      if (comm->myloc[2] == comm->procgrid[2]-1) subhi[2] += epsilon[2];
-    }
-
-  } else {
-    if (domain->xperiodic) {
-      if (comm->mysplit[0][0] == 0.0) sublo[0] -= epsilon[0];
-      if (comm->mysplit[0][1] == 1.0) subhi[0] += epsilon[0];
-    }
-    if (domain->yperiodic) {
-      if (comm->mysplit[1][0] == 0.0) sublo[1] -= epsilon[1];
-      if (comm->mysplit[1][1] == 1.0) subhi[1] += epsilon[1];
-    }
-    if (domain->zperiodic) {
-      if (comm->mysplit[2][0] == 0.0) sublo[2] -= epsilon[2];
-      if (comm->mysplit[2][1] == 1.0) subhi[2] += epsilon[2];
-    }
-  }
+  data_atoms_bounds(sublo,subhi);
 
   // xptr = which word in line starts xyz coords
   // iptr = which word in line starts ix,iy,iz image flags
@@ -1148,6 +1144,64 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
   }
 }
 
+/* ----------------------------------------------------------------------
+   bounds of my sub-domain for assigning atoms read from data files
+   if periodic and I am lo/hi proc, adjust bounds by EPSILON
+   insures all data atoms will be owned even with round-off
+------------------------------------------------------------------------- */
+
+void Atom::data_atoms_bounds(double *sublo, double *subhi)
+{
+  int triclinic = domain->triclinic;
+
+  double epsilon[3];
+  if (triclinic) epsilon[0] = epsilon[1] = epsilon[2] = EPSILON;
+  else {
+    epsilon[0] = domain->prd[0] * EPSILON;
+    epsilon[1] = domain->prd[1] * EPSILON;
+    epsilon[2] = domain->prd[2] * EPSILON;
+  }
+
+  if (triclinic == 0) {
+    sublo[0] = domain->sublo[0]; subhi[0] = domain->subhi[0];
+    sublo[1] = domain->sublo[1]; subhi[1] = domain->subhi[1];
+    sublo[2] = domain->sublo[2]; subhi[2] = domain->subhi[2];
+  } else {
+    sublo[0] = domain->sublo_lamda[0]; subhi[0] = domain->subhi_lamda[0];
+    sublo[1] = domain->sublo_lamda[1]; subhi[1] = domain->subhi_lamda[1];
+    sublo[2] = domain->sublo_lamda[2]; subhi[2] = domain->subhi_lamda[2];
+  }
+
+  if (comm->layout != Comm::LAYOUT_TILED) {
+    if (domain->xperiodic) {
+      if (comm->myloc[0] == 0) sublo[0] -= epsilon[0];
+      if (comm->myloc[0] == comm->procgrid[0]-1) subhi[0] += epsilon[0];
+    }
+    if (domain->yperiodic) {
+      if (comm->myloc[1] == 0) sublo[1] -= epsilon[1];
+      if (comm->myloc[1] == comm->procgrid[1]-1) subhi[1] += epsilon[1];
+    }
+    if (domain->zperiodic) {
+      if (comm->myloc[2] == 0) sublo[2] -= epsilon[2];
+      if (comm->myloc[2] == comm->procgrid[2]-1) subhi[2] += epsilon[2];
+    }
+
+  } else {
+    if (domain->xperiodic) {
+      if (comm->mysplit[0][0] == 0.0) sublo[0] -= epsilon[0];
+      if (comm->mysplit[0][1] == 1.0) subhi[0] += epsilon[0];
+    }
+    if (domain->yperiodic) {
+      if (comm->mysplit[1][0] == 0.0) sublo[1] -= epsilon[1];
+      if (comm->mysplit[1][1] == 1.0) subhi[1] += epsilon[1];
+    }
+    if (domain->zperiodic) {
+      if (comm->mysplit[2][0] == 0.0) sublo[2] -= epsilon[2];
+      if (comm->mysplit[2][1] == 1.0) subhi[2] += epsilon[2];
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    unpack N lines from Velocity section of data file
    check that atom IDs are > 0 and <= map_tag_max
@@ -1538,6 +1592,175 @@ void Atom::data_impropers(int n, char *buf, int *count, tagint id_offset,
   }
 }
 
+/* ----------------------------------------------------------------------
+   unpack N rows from binary Atoms section of data file
+   each row has the values of AtomVec::pack_data() incl. 3 image flags,
+     ints are ubuf encoded
+   rows may be processed by only some procs, so errors are per proc
+------------------------------------------------------------------------- */
+
+void Atom::data_atoms_binary(int n, double *buf, tagint id_offset, tagint mol_offset,
+                             int type_offset, int shiftflag, double *shift)
+{
+  imageint imagedata;
+  double xdata[3],lamda[3];
+  double *coord;
+
+  int triclinic = domain->triclinic;
+  double sublo[3],subhi[3];
+  data_atoms_bounds(sublo,subhi);
+
+  const int ncol = avec->size_data_atom + 3;
+  const int xptr = avec->xcol_data - 1;
+  const int iptr = avec->size_data_atom;
+
+  for (int i = 0; i < n; i++) {
+    double *values = &buf[(bigint) i*ncol];
+
+    int imx = (int) ubuf(values[iptr]).i;
+    int imy = (int) ubuf(values[iptr+1]).i;
+    int imz = (int) ubuf(values[iptr+2]).i;
+    if ((domain->dimension == 2) && (imz != 0))
+      error->one(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+    if ((!domain->xperiodic) && (imx != 0)) { reset_image_flag[0] = true; imx = 0; }
+    if ((!domain->yperiodic) && (imy != 0)) { reset_image_flag[1] = true; imy = 0; }
+    if ((!domain->zperiodic) && (imz != 0)) { reset_image_flag[2] = true; imz = 0; }
+    imagedata = ((imageint) (imx + IMGMAX) & IMGMASK) |
+      (((imageint) (imy + IMGMAX) & IMGMASK) << IMGBITS) |
+      (((imageint) (imz + IMGMAX) & IMGMASK) << IMG2BITS);
+
+    xdata[0] = values[xptr];
+    xdata[1] = values[xptr+1];
+    xdata[2] = values[xptr+2];
+    if (shiftflag) {
+      xdata[0] += shift[0];
+      xdata[1] += shift[1];
+      xdata[2] += shift[2];
+    }
+
+    domain->remap(xdata,imagedata);
+    if (triclinic) {
+      domain->x2lamda(xdata,lamda);
+      coord = lamda;
+    } else coord = xdata;
+
+    if (coord[0] >= sublo[0] && coord[0] < subhi[0] &&
+        coord[1] >= sublo[1] && coord[1] < subhi[1] &&
+        coord[2] >= sublo[2] && coord[2] < subhi[2]) {
+      avec->data_atom_binary(xdata,imagedata,values);
+      if (id_offset) tag[nlocal-1] += id_offset;
+      if (mol_offset) molecule[nlocal-1] += mol_offset;
+      if (type_offset) {
+        type[nlocal-1] += type_offset;
+        if (type[nlocal-1] > ntypes)
+          error->one(FLERR,"Invalid atom type in Atoms section of data file");
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   unpack N rows from binary Velocities section of data file
+   each row has the values of AtomVec::pack_vel(), ints are ubuf encoded
+   check that atom IDs are > 0 and <= map_tag_max
+------------------------------------------------------------------------- */
+
+void Atom::data_vels_binary(int n, double *buf, tagint id_offset)
+{
+  int m;
+  const int ncol = avec->size_data_vel;
+
+  for (int i = 0; i < n; i++) {
+    double *values = &buf[(bigint) i*ncol];
+    tagint tagdata = (tagint) ubuf(values[0]).i + id_offset;
+    if (tagdata <= 0 || tagdata > map_tag_max)
+      error->one(FLERR,"Invalid atom ID {} in Velocities section of data file", tagdata);
+    if ((m = map(tagdata)) >= 0) avec->data_vel_binary(m,values);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   process N rows from binary Bonds (which = 0), Angles (1),
+     Dihedrals (2), or Impropers (3) section of data file
+   each row is the type and 2,3,4 atom IDs, ubuf encoded
+   if count is non-nullptr, just count them per atom
+   else store them with atoms, same as data_bonds() etc
+   check that atom IDs are > 0 and <= map_tag_max
+------------------------------------------------------------------------- */
+
+void Atom::data_topology_binary(int which, int n, double *buf, int *count,
+                                tagint id_offset, int type_offset)
+{
+  static const char *sections[] = {"Bonds","Angles","Dihedrals","Impropers"};
+  static const char *kinds[] = {"bond","angle","dihedral","improper"};
+  const int ntopotypes[] = {nbondtypes,nangletypes,ndihedraltypes,nimpropertypes};
+
+  int m,k,kk;
+  tagint atoms[4];
+  int newton_bond = force->newton_bond;
+  const int natom = (which == 0) ? 2 : ((which == 1) ? 3 : 4);
+  const int ncol = natom + 1;
+
+  // bonds are stored with 1st atom, all others with 2nd atom
+  // with newton_bond off, also with all other atoms
+
+  const int kfirst = (which == 0) ? 0 : 1;
+
+  for (int i = 0; i < n; i++) {
+    double *values = &buf[(bigint) i*ncol];
+    int itype = (int) ubuf(values[0]).i + type_offset;
+    for (k = 0; k < natom; k++) atoms[k] = (tagint) ubuf(values[k+1]).i + id_offset;
+
+    for (k = 0; k < natom; k++) {
+      int flag = (atoms[k] <= 0) || (atoms[k] > map_tag_max);
+      for (kk = k+1; kk < natom; kk++)
+        if (atoms[k] == atoms[kk]) flag = 1;
+      if (flag)
+        error->one(FLERR,"Invalid atom ID {} in {} section of data file",
+                   atoms[k], sections[which]);
+    }
+    if (itype <= 0 || itype > ntopotypes[which])
+      error->one(FLERR,"Invalid {} type {} in {} section of data file",
+                 kinds[which], itype, sections[which]);
+
+    for (k = 0; k < natom; k++) {
+      if ((k != kfirst) && newton_bond) continue;
+      if ((m = map(atoms[k])) < 0) continue;
+      if (count) {
+        count[m]++;
+        continue;
+      }
+
+      if (which == 0) {
+        bond_type[m][num_bond[m]] = itype;
+        bond_atom[m][num_bond[m]] = (k == 0) ? atoms[1] : atoms[0];
+        num_bond[m]++;
+        avec->data_bonds_post(m,num_bond[m],atoms[0],atoms[1],id_offset);
+      } else if (which == 1) {
+        angle_type[m][num_angle[m]] = itype;
+        angle_atom1[m][num_angle[m]] = atoms[0];
+        angle_atom2[m][num_angle[m]] = atoms[1];
+        angle_atom3[m][num_angle[m]] = atoms[2];
+        num_angle[m]++;
+      } else if (which == 2) {
+        dihedral_type[m][num_dihedral[m]] = itype;
+        dihedral_atom1[m][num_dihedral[m]] = atoms[0];
+        dihedral_atom2[m][num_dihedral[m]] = atoms[1];
+        dihedral_atom3[m][num_dihedral[m]] = atoms[2];
+        dihedral_atom4[m][num_dihedral[m]] = atoms[3];
+        num_dihedral[m]++;
+      } else {
+        improper_type[m][num_improper[m]] = itype;
+        improper_atom1[m][num_improper[m]] = atoms[0];
+        improper_atom2[m][num_improper[m]] = atoms[1];
+        improper_atom3[m][num_improper[m]] = atoms[2];
+        improper_atom4[m][num_improper[m]] = atoms[3];
+        num_improper[m]++;
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    unpack N lines from atom-style specific bonus section of data file
    check that atom IDs are > 0 and <= map_tag_max
@@ -2060,10 +2283,11 @@ void Atom::sort()
 
   // permute = desired permutation of atoms
   // permute[I] = J means Ith new atom will be Jth old atom
+  // bins are traversed in linear or space-filling curve order
 
   n = 0;
   for (m = 0; m < nbins; m++) {
-    i = binhead[m];
+    i = (sortstyle == SORT_BIN) ? binhead[m] : binhead[binorder[m]];
     while (i >= 0) {
       permute[n++] = i;
       i = next[i];
@@ -2234,9 +2458,101 @@ void Atom::setup_sort_bins()
 
   if (nbins > maxbin) {
     memory->destroy(binhead);
+    memory->destroy(binorder);
     maxbin = nbins;
     memory->create(binhead,maxbin,"atom:binhead");
+    if (sortstyle != SORT_BIN) memory->create(binorder,maxbin,"atom:binorder");
+  } else if (sortstyle != SORT_BIN && !binorder)
+    memory->create(binorder,maxbin,"atom:binorder");
+
+  if (sortstyle != SORT_BIN) setup_sort_order();
+}
+
+/* ----------------------------------------------------------------------
+   order sort bins along a Morton (Z-order) or Hilbert curve
+   binorder[M] = index of Mth bin along the curve
+   curve key of a bin is built from its ix,iy,(iz) bin indices
+------------------------------------------------------------------------- */
+
+void Atom::setup_sort_order()
+{
+  int ndim = (domain->dimension == 2) ? 2 : 3;
+  int nmax = MAX(nbinx,nbiny);
+  if (ndim == 3) nmax = MAX(nmax,nbinz);
+
+  // nbits = bits per dimension needed to index all bins
+  // coarsen indices if key would not fit into 63 bits
+
+  int nbits = 1;
+  while ((1 << nbits) < nmax) nbits++;
+  int shift = MAX(0,nbits - 63/ndim);
+  nbits -= shift;
+
+  std::vector<bigint> key(nbins);
+  int coord[3];
+  int ibin = 0;
+  for (int iz = 0; iz < nbinz; iz++)
+    for (int iy = 0; iy < nbiny; iy++)
+      for (int ix = 0; ix < nbinx; ix++) {
+        coord[0] = ix >> shift;
+        coord[1] = iy >> shift;
+        coord[2] = iz >> shift;
+        if (sortstyle == SORT_HILBERT) hilbert_transpose(coord,ndim,nbits);
+        key[ibin] = interleave_bits(coord,ndim,nbits);
+        binorder[ibin] = ibin;
+        ibin++;
+      }
+
+  std::stable_sort(binorder,binorder+nbins,
+                   [&key](int i, int j) { return key[i] < key[j]; });
+}
+
+/* ----------------------------------------------------------------------
+   convert ndim coords with nbits each in place to the transposed
+   Hilbert index, using the algorithm of J. Skilling,
+   AIP Conf. Proc. 707, 381 (2004)
+------------------------------------------------------------------------- */
+
+void Atom::hilbert_transpose(int *coord, int ndim, int nbits)
+{
+  int i,p,q,t;
+  int m = 1 << (nbits-1);
+
+  // inverse undo
+
+  for (q = m; q > 1; q >>= 1) {
+    p = q - 1;
+    for (i = 0; i < ndim; i++) {
+      if (coord[i] & q) coord[0] ^= p;
+      else {
+        t = (coord[0] ^ coord[i]) & p;
+        coord[0] ^= t;
+        coord[i] ^= t;
+      }
+    }
   }
+
+  // Gray encode
+
+  for (i = 1; i < ndim; i++) coord[i] ^= coord[i-1];
+  t = 0;
+  for (q = m; q > 1; q >>= 1)
+    if (coord[ndim-1] & q) t ^= q - 1;
+  for (i = 0; i < ndim; i++) coord[i] ^= t;
+}
+
+/* ----------------------------------------------------------------------
+   interleave bits of ndim coords with nbits each into one key
+   most significant bit of 1st coord becomes most significant bit of key
+------------------------------------------------------------------------- */
+
+bigint Atom::interleave_bits(const int *coord, int ndim, int nbits)
+{
+  bigint key = 0;
+  for (int j = nbits-1; j >= 0; j--)
+    for (int i = 0; i < ndim; i++)
+      key = (key << 1) | ((coord[i] >> j) & 1);
+  return key;
 }
 
 /* ----------------------------------------------------------------------
@@ -33,6 +33,7 @@ class Atom : protected Pointers {
   enum { GROW = 0, RESTART = 1, BORDER = 2 };
   enum { ATOMIC = 0, MOLECULAR = 1, TEMPLATE = 2 };
   enum { MAP_NONE = 0, MAP_ARRAY = 1, MAP_HASH = 2, MAP_YES = 3 };
+  enum { SORT_BIN = 0, SORT_MORTON = 1, SORT_HILBERT = 2 };
 
   // atom counts
 
@@ -269,6 +270,16 @@ class Atom : protected Pointers {
   int sortfreq;          // sort atoms every this many steps, 0 = off
   bigint nextsort;       // next timestep to sort on
   double userbinsize;    // requested sort bin size
+  int sortstyle;         // order of bins: SORT_BIN, SORT_MORTON, SORT_HILBERT
+
+  // optional structure-of-arrays copy of coordinates
+  // refreshed by AtomVec::sync_soa() whenever ghost coords are communicated,
+  //   but only if the pair style reads it
+
+  int soa_flag;        // 1 if requested by atom_modify soa yes
+  int soa_active;      // 1 if xsoa is maintained, set in init()
+  int maxsoa;          // padded, aligned length of each xsoa component
+  double *xsoa[3];     // x,y,z coords of owned + ghost atoms, all in one block
 
   // indices of atoms with same ID
 
@@ -321,6 +332,9 @@ class Atom : protected Pointers {
   void data_impropers(int, char *, int *, tagint, int);
   void data_bonus(int, char *, AtomVec *, tagint);
   void data_bodies(int, char *, AtomVec *, tagint);
+  void data_atoms_binary(int, double *, tagint, tagint, int, int, double *);
+  void data_vels_binary(int, double *, tagint);
+  void data_topology_binary(int, int, double *, int *, tagint, int);
   void data_fix_compute_variable(int, int);
 
   virtual void allocate_type_arrays();
@@ -386,6 +400,8 @@ class Atom : protected Pointers {
   int map_find_hash(tagint);
 
  protected:
+  void data_atoms_bounds(double *, double *);
+
   // global to local ID mapping
 
   int *map_array;      // direct map via array that holds map_tag_max
@@ -412,6 +428,7 @@ class Atom : protected Pointers {
   int maxbin;                          // max # of bins
   int maxnext;                         // max size of next,permute
   int *binhead;                        // 1st atom in each bin
+  int *binorder;                       // bins in space-filling curve order
   int *next;                           // next atom in bin
   int *permute;                        // permutation vector
   double bininvx, bininvy, bininvz;    // inverse actual bin sizes
@@ -419,6 +436,9 @@ class Atom : protected Pointers {
 
   void set_atomflag_defaults();
   void setup_sort_bins();
+  void setup_sort_order();
+  static void hilbert_transpose(int *, int, int);
+  static bigint interleave_bits(const int *, int, int);
   int next_prime(int);
 };
 
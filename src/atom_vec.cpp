@@ -28,6 +28,9 @@
 
 using namespace LAMMPS_NS;
 
+static constexpr int SOA_PAD = 8;             // pad xsoa components to multiple of 8 doubles
+static constexpr int PACK_THREAD_MIN = 1024;    // min # of atoms for threaded pack/unpack
+
 // peratom variables that are auto-included in corresponding child style field lists
 // these fields cannot be specified in the fields strings
 
@@ -260,6 +263,36 @@ void AtomVec::grow(int n)
   grow_pointers();
 }
 
+/* ----------------------------------------------------------------------
+   refresh structure-of-arrays copy of coords of owned and ghost atoms
+   each component is padded to a multiple of SOA_PAD doubles,
+     so all 3 start on a cache line if the block is 64-byte aligned
+------------------------------------------------------------------------- */
+
+void AtomVec::sync_soa()
+{
+  const int nall = atom->nlocal + atom->nghost;
+
+  if (nall > atom->maxsoa) {
+    memory->destroy(atom->xsoa[0]);
+    atom->maxsoa = (MAX(atom->nmax,nall) + SOA_PAD - 1) / SOA_PAD * SOA_PAD;
+    memory->create(atom->xsoa[0], 3 * atom->maxsoa, "atom:xsoa");
+    atom->xsoa[1] = atom->xsoa[0] + atom->maxsoa;
+    atom->xsoa[2] = atom->xsoa[1] + atom->maxsoa;
+  }
+
+  const double *const *const xx = atom->x;
+  double *_noalias const xs = atom->xsoa[0];
+  double *_noalias const ys = atom->xsoa[1];
+  double *_noalias const zs = atom->xsoa[2];
+
+  for (int i = 0; i < nall; i++) {
+    xs[i] = xx[i][0];
+    ys[i] = xx[i][1];
+    zs[i] = xx[i][2];
+  }
+}
+
 /* ----------------------------------------------------------------------
    copy atom I info to atom J
 ------------------------------------------------------------------------- */
@@ -355,13 +388,19 @@ int AtomVec::pack_comm(int n, int *list, double *buf, int pbc_flag, int *pbc)
   double dx, dy, dz;
   void *pdata;
 
-  m = 0;
+  // coords are packed by multiple threads if enabled by package omp
+
+  const int threadflag = comm->pack_threaded && (n >= PACK_THREAD_MIN);
+
   if (pbc_flag == 0) {
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) private(j) if(threadflag)
+#endif
     for (i = 0; i < n; i++) {
       j = list[i];
-      buf[m++] = x[j][0];
-      buf[m++] = x[j][1];
-      buf[m++] = x[j][2];
+      buf[3*i] = x[j][0];
+      buf[3*i+1] = x[j][1];
+      buf[3*i+2] = x[j][2];
     }
   } else {
     if (domain->triclinic == 0) {
@@ -373,14 +412,19 @@ int AtomVec::pack_comm(int n, int *list, double *buf, int pbc_flag, int *pbc)
       dy = pbc[1] * domain->yprd + pbc[3] * domain->yz;
       dz = pbc[2] * domain->zprd;
     }
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) private(j) if(threadflag)
+#endif
     for (i = 0; i < n; i++) {
       j = list[i];
-      buf[m++] = x[j][0] + dx;
-      buf[m++] = x[j][1] + dy;
-      buf[m++] = x[j][2] + dz;
+      buf[3*i] = x[j][0] + dx;
+      buf[3*i+1] = x[j][1] + dy;
+      buf[3*i+2] = x[j][2] + dz;
     }
   }
 
+  m = 3*n;
+
   if (ncomm) {
     for (nn = 0; nn < ncomm; nn++) {
       pdata = mcomm.pdata[nn];
@@ -561,14 +605,20 @@ void AtomVec::unpack_comm(int n, int first, double *buf)
   int i, m, last, mm, nn, datatype, cols;
   void *pdata;
 
-  m = 0;
+  const int threadflag = comm->pack_threaded && (n >= PACK_THREAD_MIN);
+
   last = first + n;
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) if(threadflag)
+#endif
   for (i = first; i < last; i++) {
-    x[i][0] = buf[m++];
-    x[i][1] = buf[m++];
-    x[i][2] = buf[m++];
+    x[i][0] = buf[3*(i-first)];
+    x[i][1] = buf[3*(i-first)+1];
+    x[i][2] = buf[3*(i-first)+2];
   }
 
+  m = 3*n;
+
   if (ncomm) {
     for (nn = 0; nn < ncomm; nn++) {
       pdata = mcomm.pdata[nn];
@@ -672,14 +722,20 @@ int AtomVec::pack_reverse(int n, int first, double *buf)
   int i, m, last, mm, nn, datatype, cols;
   void *pdata;
 
-  m = 0;
+  const int threadflag = comm->pack_threaded && (n >= PACK_THREAD_MIN);
+
   last = first + n;
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) if(threadflag)
+#endif
   for (i = first; i < last; i++) {
-    buf[m++] = f[i][0];
-    buf[m++] = f[i][1];
-    buf[m++] = f[i][2];
+    buf[3*(i-first)] = f[i][0];
+    buf[3*(i-first)+1] = f[i][1];
+    buf[3*(i-first)+2] = f[i][2];
   }
 
+  m = 3*n;
+
   if (nreverse) {
     for (nn = 0; nn < nreverse; nn++) {
       pdata = mreverse.pdata[nn];
@@ -729,14 +785,22 @@ void AtomVec::unpack_reverse(int n, int *list, double *buf)
   int i, j, m, mm, nn, datatype, cols;
   void *pdata;
 
-  m = 0;
+  // atoms in list are unique, so threads update distinct forces
+
+  const int threadflag = comm->pack_threaded && (n >= PACK_THREAD_MIN);
+
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) private(j) if(threadflag)
+#endif
   for (i = 0; i < n; i++) {
     j = list[i];
-    f[j][0] += buf[m++];
-    f[j][1] += buf[m++];
-    f[j][2] += buf[m++];
+    f[j][0] += buf[3*i];
+    f[j][1] += buf[3*i+1];
+    f[j][2] += buf[3*i+2];
   }
 
+  m = 3*n;
+
   if (nreverse) {
     for (nn = 0; nn < nreverse; nn++) {
       pdata = mreverse.pdata[nn];
@@ -797,16 +861,20 @@ int AtomVec::pack_border(int n, int *list, double *buf, int pbc_flag, int *pbc)
   double dx, dy, dz;
   void *pdata;
 
-  m = 0;
+  const int threadflag = comm->pack_threaded && (n >= PACK_THREAD_MIN);
+
   if (pbc_flag == 0) {
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) private(j) if(threadflag)
+#endif
     for (i = 0; i < n; i++) {
       j = list[i];
-      buf[m++] = x[j][0];
-      buf[m++] = x[j][1];
-      buf[m++] = x[j][2];
-      buf[m++] = ubuf(tag[j]).d;
-      buf[m++] = ubuf(type[j]).d;
-      buf[m++] = ubuf(mask[j]).d;
+      buf[6*i] = x[j][0];
+      buf[6*i+1] = x[j][1];
+      buf[6*i+2] = x[j][2];
+      buf[6*i+3] = ubuf(tag[j]).d;
+      buf[6*i+4] = ubuf(type[j]).d;
+      buf[6*i+5] = ubuf(mask[j]).d;
     }
   } else {
     if (domain->triclinic == 0) {
@@ -818,17 +886,22 @@ int AtomVec::pack_border(int n, int *list, double *buf, int pbc_flag, int *pbc)
       dy = pbc[1];
       dz = pbc[2];
     }
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) private(j) if(threadflag)
+#endif
     for (i = 0; i < n; i++) {
       j = list[i];
-      buf[m++] = x[j][0] + dx;
-      buf[m++] = x[j][1] + dy;
-      buf[m++] = x[j][2] + dz;
-      buf[m++] = ubuf(tag[j]).d;
-      buf[m++] = ubuf(type[j]).d;
-      buf[m++] = ubuf(mask[j]).d;
+      buf[6*i] = x[j][0] + dx;
+      buf[6*i+1] = x[j][1] + dy;
+      buf[6*i+2] = x[j][2] + dz;
+      buf[6*i+3] = ubuf(tag[j]).d;
+      buf[6*i+4] = ubuf(type[j]).d;
+      buf[6*i+5] = ubuf(mask[j]).d;
     }
   }
 
+  m = 6*n;
+
   if (nborder) {
     for (nn = 0; nn < nborder; nn++) {
       pdata = mborder.pdata[nn];
@@ -1026,19 +1099,26 @@ void AtomVec::unpack_border(int n, int first, double *buf)
   int i, m, last, mm, nn, datatype, cols;
   void *pdata;
 
-  m = 0;
+  const int threadflag = comm->pack_threaded && (n >= PACK_THREAD_MIN);
+
   last = first + n;
   while (last > nmax) grow(0);
 
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) if(threadflag)
+#endif
   for (i = first; i < last; i++) {
-    x[i][0] = buf[m++];
-    x[i][1] = buf[m++];
-    x[i][2] = buf[m++];
-    tag[i] = (tagint) ubuf(buf[m++]).i;
-    type[i] = (int) ubuf(buf[m++]).i;
-    mask[i] = (int) ubuf(buf[m++]).i;
+    const double *ibuf = &buf[6*(i-first)];
+    x[i][0] = ibuf[0];
+    x[i][1] = ibuf[1];
+    x[i][2] = ibuf[2];
+    tag[i] = (tagint) ubuf(ibuf[3]).i;
+    type[i] = (int) ubuf(ibuf[4]).i;
+    mask[i] = (int) ubuf(ibuf[5]).i;
   }
 
+  m = 6*n;
+
   if (nborder) {
     for (nn = 0; nn < nborder; nn++) {
       pdata = mborder.pdata[nn];
@@ -1723,6 +1803,77 @@ void AtomVec::data_atom(double *coord, imageint imagetmp, const std::vector<std:
   atom->nlocal++;
 }
 
+/* ----------------------------------------------------------------------
+   unpack one row from binary Atoms section of data file
+   values are in the same order as from pack_data(), ints are ubuf encoded
+------------------------------------------------------------------------- */
+
+void AtomVec::data_atom_binary(double *coord, imageint imagetmp, double *values)
+{
+  int m, n, datatype, cols;
+  void *pdata;
+
+  int nlocal = atom->nlocal;
+  if (nlocal == nmax) grow(0);
+
+  x[nlocal][0] = coord[0];
+  x[nlocal][1] = coord[1];
+  x[nlocal][2] = coord[2];
+  mask[nlocal] = 1;
+  image[nlocal] = imagetmp;
+  v[nlocal][0] = 0.0;
+  v[nlocal][1] = 0.0;
+  v[nlocal][2] = 0.0;
+
+  int ivalue = 0;
+  for (n = 0; n < ndata_atom; n++) {
+    pdata = mdata_atom.pdata[n];
+    datatype = mdata_atom.datatype[n];
+    cols = mdata_atom.cols[n];
+    if (datatype == Atom::DOUBLE) {
+      if (cols == 0) {
+        double *vec = *((double **) pdata);
+        vec[nlocal] = values[ivalue++];
+      } else {
+        double **array = *((double ***) pdata);
+        if (array == atom->x) {    // x was already set by coord arg
+          ivalue += cols;
+          continue;
+        }
+        for (m = 0; m < cols; m++) array[nlocal][m] = values[ivalue++];
+      }
+    } else if (datatype == Atom::INT) {
+      if (cols == 0) {
+        int *vec = *((int **) pdata);
+        vec[nlocal] = (int) ubuf(values[ivalue++]).i;
+      } else {
+        int **array = *((int ***) pdata);
+        for (m = 0; m < cols; m++) array[nlocal][m] = (int) ubuf(values[ivalue++]).i;
+      }
+    } else if (datatype == Atom::BIGINT) {
+      if (cols == 0) {
+        bigint *vec = *((bigint **) pdata);
+        vec[nlocal] = (bigint) ubuf(values[ivalue++]).i;
+      } else {
+        bigint **array = *((bigint ***) pdata);
+        for (m = 0; m < cols; m++) array[nlocal][m] = (bigint) ubuf(values[ivalue++]).i;
+      }
+    }
+  }
+
+  // error checks applicable to all styles
+
+  if (tag[nlocal] <= 0) error->one(FLERR, "Invalid atom ID in Atoms section of data file");
+  if (type[nlocal] <= 0 || type[nlocal] > atom->ntypes)
+    error->one(FLERR, "Invalid atom type in Atoms section of data file");
+
+  // if needed, modify unpacked values or initialize other peratom values
+
+  data_atom_post(nlocal);
+
+  atom->nlocal++;
+}
+
 /* ----------------------------------------------------------------------
    pack atom info for data file including 3 image flags
 ------------------------------------------------------------------------- */
@@ -1875,6 +2026,77 @@ void AtomVec::data_vel(int ilocal, const std::vector<std::string> &values)
   }
 }
 
+/* ----------------------------------------------------------------------
+   unpack one row from binary Velocities section of data file
+   values are in the same order as from pack_vel(), ints are ubuf encoded
+------------------------------------------------------------------------- */
+
+void AtomVec::data_vel_binary(int ilocal, double *values)
+{
+  int m, n, datatype, cols;
+  void *pdata;
+
+  double **v = atom->v;
+  int ivalue = 1;
+  v[ilocal][0] = values[ivalue++];
+  v[ilocal][1] = values[ivalue++];
+  v[ilocal][2] = values[ivalue++];
+
+  if (ndata_vel > 2) {
+    for (n = 2; n < ndata_vel; n++) {
+      pdata = mdata_vel.pdata[n];
+      datatype = mdata_vel.datatype[n];
+      cols = mdata_vel.cols[n];
+      if (datatype == Atom::DOUBLE) {
+        if (cols == 0) {
+          double *vec = *((double **) pdata);
+          vec[ilocal] = values[ivalue++];
+        } else {
+          double **array = *((double ***) pdata);
+          for (m = 0; m < cols; m++) array[ilocal][m] = values[ivalue++];
+        }
+      } else if (datatype == Atom::INT) {
+        if (cols == 0) {
+          int *vec = *((int **) pdata);
+          vec[ilocal] = (int) ubuf(values[ivalue++]).i;
+        } else {
+          int **array = *((int ***) pdata);
+          for (m = 0; m < cols; m++) array[ilocal][m] = (int) ubuf(values[ivalue++]).i;
+        }
+      } else if (datatype == Atom::BIGINT) {
+        if (cols == 0) {
+          bigint *vec = *((bigint **) pdata);
+          vec[ilocal] = (bigint) ubuf(values[ivalue++]).i;
+        } else {
+          bigint **array = *((bigint ***) pdata);
+          for (m = 0; m < cols; m++) array[ilocal][m] = (bigint) ubuf(values[ivalue++]).i;
+        }
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   datatype of each value in a row of pack_data() (velflag = 0),
+     including 3 image flags, or of pack_vel() (velflag = 1)
+   used to label columns of binary data files
+------------------------------------------------------------------------- */
+
+void AtomVec::data_columns(int velflag, std::vector<int> &types)
+{
+  Method &mdata = velflag ? mdata_vel : mdata_atom;
+  int ndata = velflag ? ndata_vel : ndata_atom;
+
+  types.clear();
+  for (int n = 0; n < ndata; n++) {
+    int datatype = (mdata.datatype[n] == Atom::DOUBLE) ? Atom::DOUBLE : Atom::INT;
+    int cols = mdata.cols[n];
+    if (cols == 0) types.push_back(datatype);
+    else types.insert(types.end(),cols,datatype);
+  }
+  if (!velflag) types.insert(types.end(),3,Atom::INT);
+}
+
 /* ----------------------------------------------------------------------
    pack velocity info for data file
 ------------------------------------------------------------------------- */
@@ -78,6 +78,7 @@ class AtomVec : protected Pointers {
 
   virtual void grow(int);
   virtual void grow_pointers() {}
+  void sync_soa();
   virtual void copy(int, int, int);
 
   virtual void copy_bonus(int, int, int) {}
@@ -124,6 +125,7 @@ class AtomVec : protected Pointers {
   virtual void create_atom_post(int) {}
 
   virtual void data_atom(double *, imageint, const std::vector<std::string> &);
+  virtual void data_atom_binary(double *, imageint, double *);
   virtual void data_atom_post(int) {}
   virtual void data_atom_bonus(int, const std::vector<std::string> &) {}
   virtual void data_body(int, int, int, int *, double *) {}
@@ -136,6 +138,8 @@ class AtomVec : protected Pointers {
   virtual void pack_data_post(int) {}
 
   virtual void data_vel(int, const std::vector<std::string> &);
+  virtual void data_vel_binary(int, double *);
+  void data_columns(int, std::vector<int> &);
   virtual void pack_vel(double **);
   virtual void write_vel(FILE *, int, double **);
 
@@ -62,6 +62,10 @@ Balance::Balance(LAMMPS *lmp) : Command(lmp)
   proccost = allproccost = nullptr;
 
   rcb = nullptr;
+  graphflag = 0;
+  graphtol = 0.0;
+  maxspan = 0;
+  span = nullptr;
 
   nimbalance = 0;
   imbalances = nullptr;
@@ -95,6 +99,7 @@ Balance::~Balance()
   }
 
   delete rcb;
+  memory->destroy(span);
 
   for (int i = 0; i < nimbalance; i++) delete imbalances[i];
   delete [] imbalances;
@@ -209,6 +214,13 @@ void Balance::command(int narg, char **arg)
       style = BISECTION;
       iarg++;
 
+    } else if (strcmp(arg[iarg],"graph") == 0) {
+      if (style != -1) error->all(FLERR,"Illegal balance command");
+      if (iarg+2 > narg) error->all(FLERR,"Illegal balance command");
+      style = BISECTION;
+      graph_setup(utils::numeric(FLERR,arg[iarg+1],false,lmp));
+      iarg += 2;
+
     } else break;
   }
 
@@ -251,6 +263,7 @@ void Balance::command(int narg, char **arg)
   // process remaining optional args
 
   options(iarg,narg,arg);
+  if (adaptflag) error->all(FLERR,"Balance adaptive keyword can only be used with fix balance");
   if (wtflag) weight_storage(nullptr);
 
   // insure particles are in current box & update box via shrink-wrap
@@ -268,8 +281,9 @@ void Balance::command(int narg, char **arg)
   domain->reset_box();
   comm->setup();
   comm->exchange();
-  if (atom->map_style != Atom::MAP_NONE) atom->map_set();
-  if (domain->triclinic) domain->lamda2x(atom->nlocal);
+  if (graphflag) comm->borders();
+  else if (atom->map_style != Atom::MAP_NONE) atom->map_set();
+  if (domain->triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
 
   // imbinit = initial imbalance
 
@@ -428,6 +442,7 @@ void Balance::options(int iarg, int narg, char **arg)
   varflag = 0;
   oldrcb = 0;
   outflag = 0;
+  adaptflag = 0;
   int outarg = 0;
   fp = nullptr;
 
@@ -470,6 +485,10 @@ void Balance::options(int iarg, int narg, char **arg)
       outflag = 1;
       outarg = iarg+1;
       iarg += 2;
+    } else if (strcmp(arg[iarg],"adaptive") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal (fix) balance command");
+      adaptflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else error->all(FLERR,"Illegal (fix) balance command");
   }
 
@@ -594,6 +613,9 @@ int *Balance::bisection(int sortflag)
   double **x = atom->x;
   int nlocal = atom->nlocal;
 
+  // bond extents must be computed while ghost atoms are in box coords
+
+  if (graphflag) graph_spans();
   if (triclinic) domain->x2lamda(nlocal);
 
   for (int i = 0; i < nlocal; i++) {
@@ -643,8 +665,8 @@ int *Balance::bisection(int sortflag)
   } else {
     if (wtflag) {
       weight = fixstore->vstore;
-      rcb->compute(dim,atom->nlocal,atom->x,weight,shrinklo,shrinkhi);
-    } else rcb->compute(dim,atom->nlocal,atom->x,nullptr,shrinklo,shrinkhi);
+      rcb->compute(dim,atom->nlocal,atom->x,weight,shrinklo,shrinkhi,span,graphtol);
+    } else rcb->compute(dim,atom->nlocal,atom->x,nullptr,shrinklo,shrinkhi,span,graphtol);
   }
 
   if (triclinic) domain->lamda2x(nlocal);
@@ -695,6 +717,76 @@ int *Balance::bisection(int sortflag)
   return rcb->sendproc;
 }
 
+/* ----------------------------------------------------------------------
+   setup RCB balancing that avoids cutting bonds
+   called from fix balance and balance command
+   tol = allowed shift of each cut, as fraction of weight per proc
+------------------------------------------------------------------------- */
+
+void Balance::graph_setup(double tol)
+{
+  if (tol < 0.0) error->all(FLERR,"Illegal balance graph tolerance {}",tol);
+  if (atom->molecular != Atom::MOLECULAR)
+    error->all(FLERR,"Balance graph requires a molecular atom style");
+
+  graphflag = 1;
+  graphtol = tol;
+}
+
+/* ----------------------------------------------------------------------
+   compute bounding box of each owned atom and its 1-2 special neighbors
+   partners are found via atom map, using closest image
+   partners that are not owned or ghost atoms are ignored
+   if triclinic, span is converted to lamda coords like RCB input
+------------------------------------------------------------------------- */
+
+void Balance::graph_spans()
+{
+  // allocate also on procs without atoms, RCB uses spans only if all procs pass them
+
+  int nlocal = atom->nlocal;
+  if (!span || nlocal > maxspan) {
+    maxspan = MAX(atom->nmax,1);
+    memory->destroy(span);
+    memory->create(span,maxspan,6,"balance:span");
+  }
+
+  double **x = atom->x;
+  int **nspecial = atom->nspecial;
+  tagint **special = atom->special;
+  int triclinic = domain->triclinic;
+  double lamda[3];
+  double *xj;
+
+  for (int i = 0; i < nlocal; i++) {
+    if (triclinic) {
+      domain->x2lamda(x[i],lamda);
+      xj = lamda;
+    } else xj = x[i];
+
+    span[i][0] = span[i][3] = xj[0];
+    span[i][1] = span[i][4] = xj[1];
+    span[i][2] = span[i][5] = xj[2];
+
+    for (int k = 0; k < nspecial[i][0]; k++) {
+      int j = atom->map(special[i][k]);
+      if (j < 0) continue;
+      j = domain->closest_image(i,j);
+      if (triclinic) {
+        domain->x2lamda(x[j],lamda);
+        xj = lamda;
+      } else xj = x[j];
+
+      span[i][0] = MIN(span[i][0],xj[0]);
+      span[i][1] = MIN(span[i][1],xj[1]);
+      span[i][2] = MIN(span[i][2],xj[2]);
+      span[i][3] = MAX(span[i][3],xj[0]);
+      span[i][4] = MAX(span[i][4],xj[1]);
+      span[i][5] = MAX(span[i][5],xj[2]);
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    setup static load balance operations
    called from command and indirectly initially from fix balance
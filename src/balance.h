@@ -31,6 +31,7 @@ class Balance : public Command {
   int wtflag;                  // 1 if particle weighting is used
   int varflag;                 // 1 if weight style var(iable) is used
   int outflag;                 // 1 for output of balance results to file
+  int adaptflag;               // 1 if fix balance decides via cost model
 
   Balance(class LAMMPS *);
   ~Balance() override;
@@ -41,6 +42,7 @@ class Balance : public Command {
   void set_weights();
   double imbalance_factor(double &);
   void shift_setup(char *, int, double);
+  void graph_setup(double);
   int shift();
   int *bisection(int sortflag = 0);
   void dumpout(bigint);
@@ -56,6 +58,11 @@ class Balance : public Command {
   double *user_xsplit, *user_ysplit, *user_zsplit;    // params for xyz LB
   int oldrcb;                                         // use old-style RCB compute
 
+  int graphflag;      // 1 if RCB cuts avoid splitting bonds
+  double graphtol;    // allowed deviation of cut weight, fraction of ave/proc
+  int maxspan;
+  double **span;      // lo/hi extent of each atom and its bond partners
+
   int nitermax;    // params for shift LB
   double stopthresh;
   char bstr[BSTR_SIZE + 1];
@@ -83,6 +90,7 @@ class Balance : public Command {
   int firststep;
 
   double imbalance_splits();
+  void graph_spans();
   void shift_setup_static(char *);
   void tally(int, int, double *);
   int adjust(int, double *);
@@ -62,6 +62,12 @@ Comm::Comm(LAMMPS *lmp) : Pointers(lmp)
   ncollections = 0;
   ncollections_cutoff = 0;
   ghost_velocity = 0;
+  overlap = 0;
+  persistent = 0;
+  zerocopy = 0;
+  precision = DOUBLE;
+  nbx_minprocs = Irregular::NBX_MINPROCS;
+  nbx_parity = 0;
 
   user_procgrid[0] = user_procgrid[1] = user_procgrid[2] = 0;
   coregrid[0] = coregrid[1] = coregrid[2] = 1;
@@ -89,6 +95,7 @@ Comm::Comm(LAMMPS *lmp) : Pointers(lmp)
   // as many threads as there are (virtual) CPU cores by default.
 
   nthreads = 1;
+  pack_threaded = 0;
 #ifdef _OPENMP
   if (lmp->kokkos) {
     nthreads = lmp->kokkos->nthreads * lmp->kokkos->numa;
@@ -396,6 +403,29 @@ void Comm::modify_params(int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal comm_modify command");
       ghost_velocity = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"overlap") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal comm_modify command");
+      overlap = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"persistent") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal comm_modify command");
+      persistent = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"zerocopy") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal comm_modify command");
+      zerocopy = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"precision") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal comm_modify command");
+      if (strcmp(arg[iarg+1],"double") == 0) precision = DOUBLE;
+      else if (strcmp(arg[iarg+1],"mixed") == 0) precision = MIXED;
+      else error->all(FLERR,"Illegal comm_modify command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"nbx") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal comm_modify command");
+      nbx_minprocs = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (nbx_minprocs < 1) error->all(FLERR,"Illegal comm_modify nbx value: {}",nbx_minprocs);
+      iarg += 2;
     } else error->all(FLERR,"Illegal comm_modify command");
   }
 }
@@ -963,6 +993,7 @@ void Comm::ring(int n, int nper, void *inbuf, int messtag,
      second comm sends outbuf from rvous decomp back to caller decomp
    inputs:
      which = perform (0) irregular or (1) MPI_All2allv communication
+             irregular is always used with nbx_minprocs or more procs
      n = # of datums in inbuf
      inbuf = vector of input datums
      insize = byte size of each input datum
@@ -997,7 +1028,9 @@ rendezvous(int which, int n, char *inbuf, int insize,
            int (*callback)(int, char *, int &, int *&, char *&, void *),
            int outorder, char *&outbuf, int outsize, void *ptr, int statflag)
 {
-  if (which == 0)
+  // all2all is O(P) per proc, use sparse irregular comm with many procs
+
+  if (which == 0 || nprocs >= nbx_minprocs)
     return rendezvous_irregular(n,inbuf,insize,inorder,procs,callback,
                                 outorder,outbuf,outsize,ptr,statflag);
   else
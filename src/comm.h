@@ -30,6 +30,13 @@ class Comm : protected Pointers {
 
   int me, nprocs;               // proc info
   int ghost_velocity;           // 1 if ghost atoms have velocity, 0 if not
+  int overlap;                  // 1 if forward comm may overlap with pair compute
+  int persistent;               // 1 if forward/reverse comm use persistent requests
+  int zerocopy;                 // 1 if forward comm sends coords via MPI datatypes
+  int precision;                // DOUBLE or MIXED precision for ghost coords and forces
+  enum { DOUBLE, MIXED };
+  int nbx_minprocs;             // procs needed to use sparse NBX exchanges in Irregular
+  int nbx_parity;               // 0/1 tag offset of next NBX exchange in Irregular
   double cutghost[3];           // cutoffs used for acquiring ghost atoms
   double cutghostuser;          // user-specified ghost cutoff (mode == SINGLE)
   double *cutusermulti;         // per collection user ghost cutoff (mode == MULTI)
@@ -42,7 +49,8 @@ class Comm : protected Pointers {
   int other_partition_style;    // 0 = recv layout dims must be multiple of
                                 //     my layout dims
 
-  int nthreads;    // OpenMP threads per MPI process
+  int nthreads;         // OpenMP threads per MPI process
+  int pack_threaded;    // 1 if AtomVec pack/unpack of comm buffers uses threads
 
   // public settings specific to layout = UNIFORM, NONUNIFORM
 
@@ -80,6 +88,12 @@ class Comm : protected Pointers {
   virtual void exchange() = 0;                     // move atoms to new procs
   virtual void borders() = 0;                      // setup list of atoms to comm
 
+  // split-phase forward comm of atom coords
+  // default is a blocking forward comm in start and nothing in finish
+
+  virtual void forward_comm_start() { forward_comm(); }
+  virtual void forward_comm_finish() {}
+
   // forward/reverse comm from a Pair, Bond, Fix, Compute, Dump
 
   virtual void forward_comm(class Pair *) = 0;
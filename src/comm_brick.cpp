@@ -48,7 +48,9 @@ CommBrick::CommBrick(LAMMPS *lmp) :
   slablo(nullptr), slabhi(nullptr), multilo(nullptr), multihi(nullptr),
   multioldlo(nullptr), multioldhi(nullptr), cutghostmulti(nullptr), cutghostmultiold(nullptr),
   pbc_flag(nullptr), pbc(nullptr), firstrecv(nullptr), sendlist(nullptr),
-  localsendlist(nullptr), maxsendlist(nullptr), buf_send(nullptr), buf_recv(nullptr)
+  localsendlist(nullptr), maxsendlist(nullptr), sendghost(nullptr), overlap_request(nullptr),
+  buf_overlap(nullptr), persist_request(nullptr), buf_persist(nullptr), sendtype(nullptr),
+  sendorigin(nullptr), recvorigin(nullptr), recvpbc(nullptr), buf_send(nullptr), buf_recv(nullptr)
 {
   style = 0;
   layout = Comm::LAYOUT_UNIFORM;
@@ -76,6 +78,21 @@ CommBrick::~CommBrick()
   memory->sfree(sendlist);
   memory->destroy(maxsendlist);
 
+  memory->destroy(sendghost);
+  memory->sfree(overlap_request);
+  memory->destroy(buf_overlap);
+
+  free_persistent();
+  memory->sfree(persist_request);
+  memory->destroy(buf_persist);
+
+  free_sendtypes();
+  memory->sfree(sendtype);
+
+  memory->destroy(sendorigin);
+  memory->destroy(recvorigin);
+  memory->destroy(recvpbc);
+
   memory->destroy(buf_send);
   memory->destroy(buf_recv);
 }
@@ -110,6 +127,25 @@ void CommBrick::init_buffers()
   multioldlo = multioldhi = nullptr;
   cutghostmultiold = nullptr;
 
+  maxoverlap = maxbuf_overlap = 0;
+  overlap_active = 0;
+  sendghost = nullptr;
+  overlap_request = nullptr;
+  buf_overlap = nullptr;
+
+  maxpersist = maxbuf_persist = 0;
+  persist_forward = persist_reverse = 0;
+  persist_request = nullptr;
+  persist_x = persist_f = nullptr;
+  buf_persist = nullptr;
+
+  maxsendtype = 0;
+  sendtype = nullptr;
+
+  maxorigin = originflag = 0;
+  sendorigin = recvorigin = nullptr;
+  recvpbc = nullptr;
+
   buf_send = buf_recv = nullptr;
   maxsend = maxrecv = BUFMIN;
   CommBrick::grow_send(maxsend,2);
@@ -542,20 +578,51 @@ void CommBrick::forward_comm(int /*dummy*/)
   AtomVec *avec = atom->avec;
   double **x = atom->x;
   double *buf;
+  MPI_Request *req;
+
+  // persistent requests point into x, recreate them if it was reallocated
+  // mixed precision needs reference points once after each borders()
+
+  int mixedflag = (precision == MIXED);
+  int persistflag = persistent && persist_forward && !mixedflag;
+  if (persistflag && (x != persist_x || atom->f != persist_f)) setup_persistent();
+  if (mixedflag && !originflag) setup_origin();
 
   // exchange data with another proc
   // if other proc is self, just copy
   // if comm_x_only set, exchange or copy directly to x, don't unpack
+  // if mixed precision, send coords as float offsets from a reference point
+  // if persistent requests are set up, restart them instead of re-posting
 
   for (int iswap = 0; iswap < nswap; iswap++) {
     if (sendproc[iswap] != me) {
-      if (comm_x_only) {
+      if (comm_x_only && mixedflag) {
+        if (size_forward_recv[iswap])
+          MPI_Irecv(buf_recv,size_forward_recv[iswap],MPI_FLOAT,recvproc[iswap],0,world,&request);
+        n = pack_comm_mixed(iswap,(float *) buf_send);
+        if (n) MPI_Send(buf_send,n,MPI_FLOAT,sendproc[iswap],0,world);
+        if (size_forward_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        unpack_comm_mixed(iswap,(float *) buf_recv);
+      } else if (comm_x_only && persistflag) {
+        req = &persist_request[4*iswap];
+        if (size_forward_recv[iswap]) MPI_Start(&req[0]);
+        if (sendnum[iswap]) {
+          if (!sendtype || sendtype[iswap] == MPI_DATATYPE_NULL)
+            avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_persist,pbc_flag[iswap],pbc[iswap]);
+          MPI_Start(&req[1]);
+        }
+        MPI_Waitall(2,req,MPI_STATUS_IGNORE);
+      } else if (comm_x_only) {
         if (size_forward_recv[iswap]) {
           buf = x[firstrecv[iswap]];
           MPI_Irecv(buf,size_forward_recv[iswap],MPI_DOUBLE,recvproc[iswap],0,world,&request);
         }
-        n = avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
-        if (n) MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
+        if (sendtype && sendtype[iswap] != MPI_DATATYPE_NULL)
+          MPI_Send(x[0],1,sendtype[iswap],sendproc[iswap],0,world);
+        else {
+          n = avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+          if (n) MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
+        }
         if (size_forward_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
       } else if (ghost_velocity) {
         if (size_forward_recv[iswap])
@@ -588,6 +655,95 @@ void CommBrick::forward_comm(int /*dummy*/)
       }
     }
   }
+
+  if (atom->soa_active) avec->sync_soa();
+}
+
+/* ----------------------------------------------------------------------
+   split-phase forward communication of atom coords
+   start posts recvs of all swaps directly into ghost coords,
+     and sends or copies all swaps that only send owned atoms
+   finish performs the remaining swaps in order, once the ghost atoms
+     they send have arrived, then waits for all messages to complete
+   messages are tagged by swap, since swaps complete out of order
+   only for comm of coords, else start does a blocking forward_comm()
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_start()
+{
+  int iswap,n,offset;
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+
+  overlap_active = 0;
+  if (!comm_x_only || precision == MIXED || !sendghost || nswap > maxoverlap) {
+    forward_comm();
+    return;
+  }
+
+  MPI_Request *recv_request = overlap_request;
+  MPI_Request *send_request = overlap_request + nswap;
+
+  for (iswap = 0; iswap < nswap; iswap++) {
+    recv_request[iswap] = send_request[iswap] = MPI_REQUEST_NULL;
+    if (sendproc[iswap] != me && size_forward_recv[iswap])
+      MPI_Irecv(x[firstrecv[iswap]],size_forward_recv[iswap],MPI_DOUBLE,
+                recvproc[iswap],iswap,world,&recv_request[iswap]);
+  }
+
+  offset = 0;
+  for (iswap = 0; iswap < nswap; iswap++) {
+    if (sendghost[iswap]) continue;
+    if (sendproc[iswap] != me && sendtype && sendtype[iswap] != MPI_DATATYPE_NULL) {
+      MPI_Isend(x[0],1,sendtype[iswap],sendproc[iswap],iswap,world,&send_request[iswap]);
+    } else if (sendproc[iswap] != me) {
+      n = avec->pack_comm(sendnum[iswap],sendlist[iswap],&buf_overlap[offset],
+                          pbc_flag[iswap],pbc[iswap]);
+      if (n) MPI_Isend(&buf_overlap[offset],n,MPI_DOUBLE,sendproc[iswap],iswap,world,
+                       &send_request[iswap]);
+      offset += n;
+    } else if (sendnum[iswap])
+      avec->pack_comm(sendnum[iswap],sendlist[iswap],x[firstrecv[iswap]],
+                      pbc_flag[iswap],pbc[iswap]);
+  }
+
+  overlap_active = 1;
+
+  // owned coords are current, ghost coords will be refreshed by finish
+
+  if (atom->soa_active) avec->sync_soa();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_finish()
+{
+  int iswap,n;
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+
+  if (!overlap_active) return;
+  overlap_active = 0;
+
+  MPI_Request *recv_request = overlap_request;
+  MPI_Request *send_request = overlap_request + nswap;
+
+  for (iswap = 0; iswap < nswap; iswap++) {
+    if (!sendghost[iswap]) continue;
+    MPI_Waitall(iswap,recv_request,MPI_STATUS_IGNORE);
+    if (sendproc[iswap] != me && sendtype && sendtype[iswap] != MPI_DATATYPE_NULL) {
+      MPI_Send(x[0],1,sendtype[iswap],sendproc[iswap],iswap,world);
+    } else if (sendproc[iswap] != me) {
+      n = avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+      if (n) MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],iswap,world);
+    } else if (sendnum[iswap])
+      avec->pack_comm(sendnum[iswap],sendlist[iswap],x[firstrecv[iswap]],
+                      pbc_flag[iswap],pbc[iswap]);
+  }
+
+  MPI_Waitall(2*nswap,overlap_request,MPI_STATUS_IGNORE);
+
+  if (atom->soa_active) avec->sync_soa();
 }
 
 /* ----------------------------------------------------------------------
@@ -602,14 +758,36 @@ void CommBrick::reverse_comm()
   AtomVec *avec = atom->avec;
   double **f = atom->f;
   double *buf;
+  MPI_Request *req;
+
+  // persistent requests point into f, recreate them if it was reallocated
+
+  int mixedflag = (precision == MIXED);
+  int persistflag = persistent && persist_reverse && !mixedflag;
+  if (persistflag && (atom->x != persist_x || f != persist_f)) setup_persistent();
 
   // exchange data with another proc
   // if other proc is self, just copy
   // if comm_f_only set, exchange or copy directly from f, don't pack
+  // if mixed precision, send forces as floats
+  // if persistent requests are set up, restart them instead of re-posting
 
   for (int iswap = nswap-1; iswap >= 0; iswap--) {
     if (sendproc[iswap] != me) {
-      if (comm_f_only) {
+      if (comm_f_only && mixedflag) {
+        if (size_reverse_recv[iswap])
+          MPI_Irecv(buf_recv,size_reverse_recv[iswap],MPI_FLOAT,sendproc[iswap],0,world,&request);
+        n = pack_reverse_mixed(iswap,(float *) buf_send);
+        if (n) MPI_Send(buf_send,n,MPI_FLOAT,recvproc[iswap],0,world);
+        if (size_reverse_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        unpack_reverse_mixed(iswap,(float *) buf_recv);
+      } else if (comm_f_only && persistflag) {
+        req = &persist_request[4*iswap+2];
+        if (size_reverse_recv[iswap]) MPI_Start(&req[0]);
+        if (size_reverse_send[iswap]) MPI_Start(&req[1]);
+        MPI_Waitall(2,req,MPI_STATUS_IGNORE);
+        avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_persist);
+      } else if (comm_f_only) {
         if (size_reverse_recv[iswap])
           MPI_Irecv(buf_recv,size_reverse_recv[iswap],MPI_DOUBLE,sendproc[iswap],0,world,&request);
         if (size_reverse_send[iswap]) {
@@ -617,14 +795,15 @@ void CommBrick::reverse_comm()
           MPI_Send(buf,size_reverse_send[iswap],MPI_DOUBLE,recvproc[iswap],0,world);
         }
         if (size_reverse_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_recv);
       } else {
         if (size_reverse_recv[iswap])
           MPI_Irecv(buf_recv,size_reverse_recv[iswap],MPI_DOUBLE,sendproc[iswap],0,world,&request);
         n = avec->pack_reverse(recvnum[iswap],firstrecv[iswap],buf_send);
         if (n) MPI_Send(buf_send,n,MPI_DOUBLE,recvproc[iswap],0,world);
         if (size_reverse_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_recv);
       }
-      avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_recv);
 
     } else {
       if (comm_f_only) {
@@ -976,6 +1155,312 @@ void CommBrick::borders()
   // reset global->local map
 
   if (map_style != Atom::MAP_NONE) atom->map_set();
+
+  // setup for split-phase forward comm:
+  // flag swaps that send ghost atoms, they must wait for prior swaps
+  // other swaps are posted at once and need their own send buffer space
+
+  if (overlap) {
+    if (nswap > maxoverlap) {
+      maxoverlap = nswap;
+      memory->destroy(sendghost);
+      memory->sfree(overlap_request);
+      memory->create(sendghost,maxoverlap,"comm:sendghost");
+      overlap_request = (MPI_Request *)
+        memory->smalloc(2*maxoverlap*sizeof(MPI_Request),"comm:overlap_request");
+    }
+
+    int nlocal = atom->nlocal;
+    bigint noverlap = 0;
+    for (iswap = 0; iswap < nswap; iswap++) {
+      sendghost[iswap] = 0;
+      for (i = 0; i < sendnum[iswap]; i++)
+        if (sendlist[iswap][i] >= nlocal) {
+          sendghost[iswap] = 1;
+          break;
+        }
+      if (!sendghost[iswap] && sendproc[iswap] != me)
+        noverlap += (bigint) size_forward*sendnum[iswap];
+    }
+    if (noverlap > MAXSMALLINT)
+      error->one(FLERR,"Too many atoms in forward comm overlap buffer");
+    if (noverlap > maxbuf_overlap) {
+      maxbuf_overlap = static_cast<int> (BUFFACTOR * noverlap);
+      memory->destroy(buf_overlap);
+      memory->create(buf_overlap,maxbuf_overlap,"comm:buf_overlap");
+    }
+  }
+
+  // swap pattern is now fixed until next reneighboring
+  // (re)create persistent requests for forward and reverse comm
+
+  if (zerocopy || sendtype) setup_sendtypes();
+  originflag = 0;
+  if (persistent || persist_forward || persist_reverse) setup_persistent();
+
+  // refresh structure-of-arrays copy of coords
+
+  if (atom->soa_active) atom->avec->sync_soa();
+}
+
+/* ----------------------------------------------------------------------
+   create persistent requests for forward comm of coords and
+     reverse comm of forces with the current swap pattern
+   forward recvs go directly into ghost coords, reverse sends come
+     directly from ghost forces, the other side uses buf_persist
+   only for comm_x_only and comm_f_only, else regular comm is used
+   requests stay valid until next borders() or until x or f is reallocated
+------------------------------------------------------------------------- */
+
+void CommBrick::setup_persistent()
+{
+  free_persistent();
+  if (!persistent || (!comm_x_only && !comm_f_only)) return;
+
+  if (nswap > maxpersist) {
+    memory->sfree(persist_request);
+    maxpersist = nswap;
+    persist_request = (MPI_Request *)
+      memory->smalloc(4*maxpersist*sizeof(MPI_Request),"comm:persist_request");
+    for (int i = 0; i < 4*maxpersist; i++) persist_request[i] = MPI_REQUEST_NULL;
+  }
+
+  int nmax = 0;
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    if (sendproc[iswap] == me) continue;
+    if (comm_x_only) nmax = MAX(nmax,size_forward*sendnum[iswap]);
+    if (comm_f_only) nmax = MAX(nmax,size_reverse_recv[iswap]);
+  }
+  if (nmax > maxbuf_persist) {
+    maxbuf_persist = static_cast<int> (BUFFACTOR * nmax);
+    memory->destroy(buf_persist);
+    memory->create(buf_persist,maxbuf_persist,"comm:buf_persist");
+  }
+
+  double **x = atom->x;
+  double **f = atom->f;
+  MPI_Request *req;
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    if (sendproc[iswap] == me) continue;
+    req = &persist_request[4*iswap];
+    if (comm_x_only) {
+      if (size_forward_recv[iswap])
+        MPI_Recv_init(x[firstrecv[iswap]],size_forward_recv[iswap],MPI_DOUBLE,
+                      recvproc[iswap],0,world,&req[0]);
+      if (sendnum[iswap] && sendtype && sendtype[iswap] != MPI_DATATYPE_NULL)
+        MPI_Send_init(x[0],1,sendtype[iswap],sendproc[iswap],0,world,&req[1]);
+      else if (sendnum[iswap])
+        MPI_Send_init(buf_persist,size_forward*sendnum[iswap],MPI_DOUBLE,
+                      sendproc[iswap],0,world,&req[1]);
+    }
+    if (comm_f_only) {
+      if (size_reverse_recv[iswap])
+        MPI_Recv_init(buf_persist,size_reverse_recv[iswap],MPI_DOUBLE,
+                      sendproc[iswap],0,world,&req[2]);
+      if (size_reverse_send[iswap])
+        MPI_Send_init(f[firstrecv[iswap]],size_reverse_send[iswap],MPI_DOUBLE,
+                      recvproc[iswap],0,world,&req[3]);
+    }
+  }
+
+  persist_forward = comm_x_only;
+  persist_reverse = comm_f_only;
+  persist_x = x;
+  persist_f = f;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CommBrick::free_persistent()
+{
+  for (int i = 0; i < 4*maxpersist; i++)
+    if (persist_request[i] != MPI_REQUEST_NULL) {
+      MPI_Request_free(&persist_request[i]);
+      persist_request[i] = MPI_REQUEST_NULL;
+    }
+  persist_forward = persist_reverse = 0;
+}
+
+/* ----------------------------------------------------------------------
+   create one MPI datatype per swap which selects the coords of the
+     sendlist atoms directly from x, so they are sent without packing
+   only for comm_x_only and swaps to other procs without a PBC shift,
+     since the shift has to be applied to a copy of the coords
+   datatypes are relative to x[0] and stay valid until next borders()
+------------------------------------------------------------------------- */
+
+void CommBrick::setup_sendtypes()
+{
+  free_sendtypes();
+
+  if (nswap > maxsendtype) {
+    memory->sfree(sendtype);
+    maxsendtype = nswap;
+    sendtype = (MPI_Datatype *)
+      memory->smalloc(maxsendtype*sizeof(MPI_Datatype),"comm:sendtype");
+    for (int i = 0; i < maxsendtype; i++) sendtype[i] = MPI_DATATYPE_NULL;
+  }
+
+  if (!zerocopy || !comm_x_only) return;
+  if ((bigint) 3*(atom->nlocal+atom->nghost) > MAXSMALLINT) return;
+
+  int *displace;
+  memory->create(displace,MAX(smax,1),"comm:displace");
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    if (sendproc[iswap] == me || pbc_flag[iswap] || sendnum[iswap] == 0) continue;
+    for (int i = 0; i < sendnum[iswap]; i++) displace[i] = 3*sendlist[iswap][i];
+    MPI_Type_create_indexed_block(sendnum[iswap],3,displace,MPI_DOUBLE,&sendtype[iswap]);
+    MPI_Type_commit(&sendtype[iswap]);
+  }
+
+  memory->destroy(displace);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CommBrick::free_sendtypes()
+{
+  for (int i = 0; i < maxsendtype; i++)
+    if (sendtype[i] != MPI_DATATYPE_NULL) {
+      MPI_Type_free(&sendtype[i]);
+      sendtype[i] = MPI_DATATYPE_NULL;
+    }
+}
+
+/* ----------------------------------------------------------------------
+   set reference points for mixed precision forward comm
+   sender uses coords of its 1st send atom, receiver gets them and the PBC flags
+   done on 1st forward comm after borders(), since borders() may operate
+     in lamda coords, while forward comm is always in box coords
+------------------------------------------------------------------------- */
+
+void CommBrick::setup_origin()
+{
+  double **x = atom->x;
+
+  if (nswap > maxorigin) {
+    maxorigin = nswap;
+    memory->destroy(sendorigin);
+    memory->destroy(recvorigin);
+    memory->destroy(recvpbc);
+    memory->create(sendorigin,maxorigin,3,"comm:sendorigin");
+    memory->create(recvorigin,maxorigin,3,"comm:recvorigin");
+    memory->create(recvpbc,maxorigin,6,"comm:recvpbc");
+  }
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    if (sendproc[iswap] == me) continue;
+
+    if (sendnum[iswap]) {
+      int j = sendlist[iswap][0];
+      sendorigin[iswap][0] = x[j][0];
+      sendorigin[iswap][1] = x[j][1];
+      sendorigin[iswap][2] = x[j][2];
+    } else sendorigin[iswap][0] = sendorigin[iswap][1] = sendorigin[iswap][2] = 0.0;
+
+    MPI_Sendrecv(sendorigin[iswap],3,MPI_DOUBLE,sendproc[iswap],0,
+                 recvorigin[iswap],3,MPI_DOUBLE,recvproc[iswap],0,world,MPI_STATUS_IGNORE);
+    MPI_Sendrecv(pbc[iswap],6,MPI_INT,sendproc[iswap],0,
+                 recvpbc[iswap],6,MPI_INT,recvproc[iswap],0,world,MPI_STATUS_IGNORE);
+  }
+
+  originflag = 1;
+}
+
+/* ----------------------------------------------------------------------
+   pack coords of one swap as single precision offsets from its sendorigin
+   PBC shift is added by the receiver
+------------------------------------------------------------------------- */
+
+int CommBrick::pack_comm_mixed(int iswap, float *buf)
+{
+  int i,j,m;
+  double **x = atom->x;
+  int *list = sendlist[iswap];
+  double *origin = sendorigin[iswap];
+  int n = sendnum[iswap];
+
+  m = 0;
+  for (i = 0; i < n; i++) {
+    j = list[i];
+    buf[m++] = static_cast<float>(x[j][0] - origin[0]);
+    buf[m++] = static_cast<float>(x[j][1] - origin[1]);
+    buf[m++] = static_cast<float>(x[j][2] - origin[2]);
+  }
+  return m;
+}
+
+/* ----------------------------------------------------------------------
+   unpack coords of one swap relative to the sender's reference point
+   PBC shift uses the current box, since it may change between borders()
+------------------------------------------------------------------------- */
+
+void CommBrick::unpack_comm_mixed(int iswap, float *buf)
+{
+  int i,m,last;
+  double origin[3];
+  double **x = atom->x;
+  int *pbcswap = recvpbc[iswap];
+
+  origin[0] = recvorigin[iswap][0];
+  origin[1] = recvorigin[iswap][1];
+  origin[2] = recvorigin[iswap][2];
+  if (domain->triclinic == 0) {
+    origin[0] += pbcswap[0] * domain->xprd;
+    origin[1] += pbcswap[1] * domain->yprd;
+    origin[2] += pbcswap[2] * domain->zprd;
+  } else {
+    origin[0] += pbcswap[0] * domain->xprd + pbcswap[5] * domain->xy + pbcswap[4] * domain->xz;
+    origin[1] += pbcswap[1] * domain->yprd + pbcswap[3] * domain->yz;
+    origin[2] += pbcswap[2] * domain->zprd;
+  }
+
+  m = 0;
+  last = firstrecv[iswap] + recvnum[iswap];
+  for (i = firstrecv[iswap]; i < last; i++) {
+    x[i][0] = origin[0] + buf[m++];
+    x[i][1] = origin[1] + buf[m++];
+    x[i][2] = origin[2] + buf[m++];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   pack ghost forces of one swap in single precision
+------------------------------------------------------------------------- */
+
+int CommBrick::pack_reverse_mixed(int iswap, float *buf)
+{
+  int i,m,last;
+  double **f = atom->f;
+
+  m = 0;
+  last = firstrecv[iswap] + recvnum[iswap];
+  for (i = firstrecv[iswap]; i < last; i++) {
+    buf[m++] = static_cast<float>(f[i][0]);
+    buf[m++] = static_cast<float>(f[i][1]);
+    buf[m++] = static_cast<float>(f[i][2]);
+  }
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CommBrick::unpack_reverse_mixed(int iswap, float *buf)
+{
+  int i,j,m;
+  double **f = atom->f;
+  int *list = sendlist[iswap];
+  int n = sendnum[iswap];
+
+  m = 0;
+  for (i = 0; i < n; i++) {
+    j = list[i];
+    f[j][0] += buf[m++];
+    f[j][1] += buf[m++];
+    f[j][2] += buf[m++];
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -1703,5 +2188,7 @@ double CommBrick::memory_usage()
     bytes += memory->usage(sendlist[i],maxsendlist[i]);
   bytes += memory->usage(buf_send,maxsend+bufextra);
   bytes += memory->usage(buf_recv,maxrecv);
+  bytes += memory->usage(buf_overlap,maxbuf_overlap);
+  bytes += memory->usage(buf_persist,maxbuf_persist);
   return bytes;
 }
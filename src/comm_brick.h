@@ -31,6 +31,8 @@ class CommBrick : public Comm {
   void reverse_comm() override;                 // reverse comm of forces
   void exchange() override;                     // move atoms to new procs
   void borders() override;                      // setup list of atoms to comm
+  void forward_comm_start() override;           // post split-phase forward comm
+  void forward_comm_finish() override;          // complete split-phase forward comm
 
   void forward_comm(class Pair *) override;                 // forward comm from a Pair
   void reverse_comm(class Pair *) override;                 // reverse comm from a Pair
@@ -73,6 +75,30 @@ class CommBrick : public Comm {
   int *localsendlist;    // indexed list of local sendlist atoms
   int *maxsendlist;      // max size of send list for each swap
 
+  int maxoverlap;                  // # of swaps overlap arrays are allocated for
+  int overlap_active;              // 1 if a split-phase forward comm is pending
+  int *sendghost;                  // 1 if swap sends ghost atoms of prior swaps
+  MPI_Request *overlap_request;    // recv requests, then send requests, of each swap
+  double *buf_overlap;             // send buffer for swaps posted in start
+  int maxbuf_overlap;              // current size of buf_overlap
+
+  int maxpersist;                  // # of swaps persistent requests are allocated for
+  int persist_forward;             // 1 if forward comm requests are set up
+  int persist_reverse;             // 1 if reverse comm requests are set up
+  MPI_Request *persist_request;    // fwd recv, fwd send, rev recv, rev send of each swap
+  double **persist_x, **persist_f; // coord and force arrays the requests point into
+  double *buf_persist;             // send/recv buffer bound to the requests
+  int maxbuf_persist;              // current size of buf_persist
+
+  int maxsendtype;                 // # of swaps sendtype is allocated for
+  MPI_Datatype *sendtype;          // datatype selecting sendlist coords in x, per swap
+
+  int maxorigin;                   // # of swaps origin arrays are allocated for
+  int originflag;                  // 1 if origins are set for current swaps
+  double **sendorigin;             // reference point for coord offsets sent in each swap
+  double **recvorigin;             // sender's reference point, per swap
+  int **recvpbc;                   // sender's PBC flags, per swap
+
   double *buf_send;        // send buffer for all comm
   double *buf_recv;        // recv buffer for all comm
   int maxsend, maxrecv;    // current size of send/recv buffer
@@ -82,6 +108,15 @@ class CommBrick : public Comm {
   void init_buffers();
 
   int updown(int, int, int, double, int, double *);
+  void setup_persistent();    // create persistent requests for current swaps
+  void free_persistent();     // release persistent requests
+  void setup_sendtypes();     // create datatypes for zero-copy forward comm
+  void free_sendtypes();      // release datatypes
+  void setup_origin();        // exchange reference points for mixed precision
+  int pack_comm_mixed(int, float *);
+  void unpack_comm_mixed(int, float *);
+  int pack_reverse_mixed(int, float *);
+  void unpack_reverse_mixed(int, float *);
   // compare cutoff to procs
   virtual void grow_send(int, int);       // reallocate send buffer
   virtual void grow_recv(int);            // free/allocate recv buffer
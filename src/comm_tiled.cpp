@@ -801,6 +801,8 @@ void CommTiled::forward_comm(int /*dummy*/)
       }
     }
   }
+
+  if (atom->soa_active) avec->sync_soa();
 }
 
 /* ----------------------------------------------------------------------
@@ -1341,6 +1343,10 @@ void CommTiled::borders()
   // reset global->local map
 
   if (map_style != Atom::MAP_NONE) atom->map_set();
+
+  // refresh structure-of-arrays copy of coords
+
+  if (atom->soa_active) atom->avec->sync_soa();
 }
 
 /* ----------------------------------------------------------------------
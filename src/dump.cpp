@@ -26,6 +26,7 @@
 #include "output.h"
 #include "update.h"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace LAMMPS_NS;
@@ -35,8 +36,11 @@ using namespace LAMMPS_NS;
 Dump *Dump::dumpptr;
 #endif
 
-#define BIG 1.0e20
 #define EPSILON 1.0e-6
+#define SORTSAMPLE 16          // samples per proc to choose sort splitters
+#define RADIXBITS 11           // bits per digit in radix sort on IDs
+#define RADIXSIZE (1 << RADIXBITS)
+#define RADIXMASK (RADIXSIZE - 1)
 
 enum{ASCEND,DESCEND};
 
@@ -79,6 +83,9 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) : Pointers(lmp)
   append_flag = 0;
   buffer_allow = 0;
   buffer_flag = 0;
+  async_allow = 0;
+  async_flag = 0;
+  asyncrequest = MPI_REQUEST_NULL;
   padflag = 0;
   pbcflag = 0;
   time_flag = 0;
@@ -95,7 +102,7 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) : Pointers(lmp)
   maxbuf = maxids = maxsort = maxproc = 0;
   buf = bufsort = nullptr;
   ids = idsort = nullptr;
-  index = proclist = nullptr;
+  index = proclist = radixindex = nullptr;
   irregular = nullptr;
 
   maxsbuf = 0;
@@ -172,6 +179,7 @@ Dump::~Dump()
   memory->destroy(idsort);
   memory->destroy(index);
   memory->destroy(proclist);
+  memory->destroy(radixindex);
   delete irregular;
 
   memory->destroy(sbuf);
@@ -208,6 +216,9 @@ Dump::~Dump()
 
 void Dump::init()
 {
+  // init_style() may change formats used by a pending asynchronous write
+
+  wait_async();
   init_style();
 
   if (!sort_flag) {
@@ -216,19 +227,17 @@ void Dump::init()
     memory->destroy(idsort);
     memory->destroy(index);
     memory->destroy(proclist);
+    memory->destroy(radixindex);
     delete irregular;
 
     maxids = maxsort = maxproc = 0;
     bufsort = nullptr;
     ids = idsort = nullptr;
-    index = proclist = nullptr;
+    index = proclist = radixindex = nullptr;
     irregular = nullptr;
   }
 
   if (sort_flag) {
-    if (multiproc > 1)
-      error->all(FLERR,
-                 "Cannot dump sort when 'nfile' or 'fileper' keywords are set to non-default values");
     if (sortcol == 0 && atom->tag_enable == 0)
       error->all(FLERR,"Cannot dump sort on atom IDs with no atom IDs defined");
     if (sortcol && sortcol > size_one)
@@ -328,6 +337,10 @@ void Dump::write()
 
   if (delay_flag && update->ntimestep < delaystep) return;
 
+  // previous snapshot must be written and sent before buf and file are reused
+
+  wait_async();
+
   // if file per timestep, open new file
 
   if (multifile) openfile();
@@ -459,9 +472,14 @@ void Dump::write()
   MPI_Status status;
   MPI_Request request;
 
+  // async output, filewriters write data of their cluster on a helper thread
+
+  if (async_flag) {
+    write_async();
+
   // comm and output buf of doubles
 
-  if (buffer_flag == 0 || binary) {
+  } else if (buffer_flag == 0 || binary) {
     if (filewriter) {
       for (int iproc = 0; iproc < nclusterprocs; iproc++) {
         if (iproc) {
@@ -517,8 +535,9 @@ void Dump::write()
   if (refreshflag) modify->compute[irefresh]->refresh();
 
   // if file per timestep, close file if I am filewriter
+  // unless helper thread is still writing to it, then wait_async() closes it
 
-  if (multifile) {
+  if (multifile && !asyncthread.joinable()) {
     if (compressed) {
       if (filewriter && fp != nullptr) platform::pclose(fp);
     } else {
@@ -584,6 +603,71 @@ void Dump::openfile()
   if (multifile) delete[] filecurrent;
 }
 
+/* ----------------------------------------------------------------------
+   asynchronous output of one snapshot, packed into buf or sbuf
+   non-filewriters send their data with a non-blocking send and return
+   filewriter receives data of all procs in its cluster into abuf,
+     then a helper thread writes it in proc order while the run continues
+   helper thread only calls write_data(), which must not use MPI or errors
+------------------------------------------------------------------------- */
+
+void Dump::write_async()
+{
+  int stringflag = (buffer_flag && !binary) ? 1 : 0;
+  char *mybuf = stringflag ? sbuf : (char *) buf;
+  int mysize = stringflag ? nsme : nme*size_one;
+  int maxsize = stringflag ? maxsbuf : maxbuf*size_one;
+  int nbytes = stringflag ? sizeof(char) : sizeof(double);
+  MPI_Datatype datatype = stringflag ? MPI_CHAR : MPI_DOUBLE;
+
+  if (!filewriter) {
+    MPI_Isend(mybuf,mysize,datatype,fileproc,0,world,&asyncrequest);
+    return;
+  }
+
+  bigint nslot = (bigint) maxsize*nbytes;
+  abuf.resize(nclusterprocs*nslot);
+  acounts.resize(nclusterprocs);
+
+  std::vector<MPI_Request> requests(nclusterprocs,MPI_REQUEST_NULL);
+  std::vector<MPI_Status> statuses(nclusterprocs);
+  for (int iproc = 1; iproc < nclusterprocs; iproc++)
+    MPI_Irecv(&abuf[iproc*nslot],maxsize,datatype,me+iproc,0,world,&requests[iproc]);
+  memcpy(abuf.data(),mybuf,(bigint) mysize*nbytes);
+  MPI_Waitall(nclusterprocs,requests.data(),statuses.data());
+
+  acounts[0] = mysize;
+  for (int iproc = 1; iproc < nclusterprocs; iproc++)
+    MPI_Get_count(&statuses[iproc],datatype,&acounts[iproc]);
+  if (!stringflag)
+    for (int iproc = 0; iproc < nclusterprocs; iproc++) acounts[iproc] /= size_one;
+
+  asyncthread = std::thread([this,nslot]() {
+    for (int iproc = 0; iproc < nclusterprocs; iproc++)
+      write_data(acounts[iproc],(double *) &abuf[iproc*nslot]);
+    if (flush_flag && fp) fflush(fp);
+  });
+}
+
+/* ----------------------------------------------------------------------
+   complete asynchronous output of previous snapshot
+   wait for helper thread on filewriter or send on other procs
+   if file per timestep, close file the helper thread wrote to
+------------------------------------------------------------------------- */
+
+void Dump::wait_async()
+{
+  if (asyncthread.joinable()) {
+    asyncthread.join();
+    if (multifile && fp) {
+      if (compressed) platform::pclose(fp);
+      else fclose(fp);
+      fp = nullptr;
+    }
+  }
+  if (asyncrequest != MPI_REQUEST_NULL) MPI_Wait(&asyncrequest,MPI_STATUS_IGNORE);
+}
+
 /* ----------------------------------------------------------------------
    parallel sort of buf across all procs
    changes nme, reorders datums in buf, grows buf if necessary
@@ -591,9 +675,13 @@ void Dump::openfile()
 
 void Dump::sort()
 {
-  int i,iproc;
+  int i;
   double value;
 
+  // reordering requires all atoms of the group to be in the snapshot
+
+  if (reorderflag && ntotal != ntotal_reorder) reorderflag = 0;
+
   // if single proc, swap ptrs to buf,ids <-> bufsort,idsort
 
   if (nprocs == 1) {
@@ -606,6 +694,8 @@ void Dump::sort()
       if (sortcol == 0) {
         memory->destroy(idsort);
         memory->create(idsort,maxsort,"dump:idsort");
+        memory->destroy(radixindex);
+        memory->create(radixindex,maxsort,"dump:radixindex");
       }
     }
 
@@ -632,8 +722,14 @@ void Dump::sort()
     }
 
     // proclist[i] = which proc Ith datum will be sent to
-
-    if (sortcol == 0) {
+    // procs receive consecutive ranges of the sorted order,
+    //   so each nfile or fileper cluster writes a contiguous range to its file
+    // if reordering is possible, IDs are consecutive,
+    //   split ID range evenly so that counts match nme_reorder
+    // else sample sort: partition by splitters chosen from a regular
+    //   sample of all keys, so per-proc counts are balanced for any key values
+
+    if (sortcol == 0 && reorderflag) {
       tagint min = MAXTAGINT;
       tagint max = 0;
       for (i = 0; i < nme; i++) {
@@ -649,32 +745,51 @@ void Dump::sort()
       // then iproc == nprocs for largest ID, causing irregular to crash
 
       double range = maxall-minall + 0.5;
-      for (i = 0; i < nme; i++) {
-        iproc = static_cast<int> ((ids[i]-minall)/range * nprocs);
-        proclist[i] = iproc;
-      }
+      for (i = 0; i < nme; i++)
+        proclist[i] = static_cast<int> ((ids[i]-minall)/range * nprocs);
 
     } else {
-      double min = BIG;
-      double max = -BIG;
-      for (i = 0; i < nme; i++) {
-        value = buf[i*size_one + sortcolm1];
-        min = MIN(min,value);
-        max = MAX(max,value);
-      }
-      double minall,maxall;
-      MPI_Allreduce(&min,&minall,1,MPI_DOUBLE,MPI_MIN,world);
-      MPI_Allreduce(&max,&maxall,1,MPI_DOUBLE,MPI_MAX,world);
-      double range = maxall-minall + EPSILON*(maxall-minall);
-      if (range == 0.0) range = EPSILON;
 
-      // proc assignment is inverted if sortorder = DESCEND
+      // stride between samples is the same on all procs,
+      //   so each proc contributes samples in proportion to its nme
 
-      for (i = 0; i < nme; i++) {
-        value = buf[i*size_one + sortcolm1];
-        iproc = static_cast<int> ((value-minall)/range * nprocs);
-        if (sortorder == DESCEND) iproc = nprocs-1 - iproc;
-        proclist[i] = iproc;
+      bigint stride = MAX(1,ntotal/((bigint) nprocs*SORTSAMPLE));
+      int nsample = static_cast<int> (nme/stride);
+      int first = static_cast<int> (stride/2);
+
+      if (sortcol == 0) {
+        std::vector<tagint> samples(nsample),splitters;
+        for (i = 0; i < nsample; i++) samples[i] = ids[first + i*stride];
+        sort_splitters(samples,splitters);
+
+        for (i = 0; i < nme; i++)
+          proclist[i] = std::upper_bound(splitters.begin(),splitters.end(),ids[i]) -
+            splitters.begin();
+
+      } else {
+
+        // key = column value, negated if sortorder = DESCEND
+        // ties are broken by global position of datum before the sort,
+        //   so many identical values are still spread across procs
+
+        bigint offset;
+        bigint bnme = nme;
+        MPI_Scan(&bnme,&offset,1,MPI_LMP_BIGINT,MPI_SUM,world);
+        offset -= nme;
+        double sign = (sortorder == DESCEND) ? -1.0 : 1.0;
+
+        std::vector<std::pair<double,bigint>> samples(nsample),splitters;
+        for (i = 0; i < nsample; i++) {
+          int j = first + i*stride;
+          samples[i] = {sign*buf[j*size_one + sortcolm1], offset+j};
+        }
+        sort_splitters(samples,splitters);
+
+        for (i = 0; i < nme; i++) {
+          value = sign*buf[i*size_one + sortcolm1];
+          proclist[i] = std::upper_bound(splitters.begin(),splitters.end(),
+                                         std::make_pair(value,offset+i)) - splitters.begin();
+        }
       }
     }
 
@@ -693,6 +808,8 @@ void Dump::sort()
       if (sortcol == 0) {
         memory->destroy(idsort);
         memory->create(idsort,maxsort,"dump:idsort");
+        memory->destroy(radixindex);
+        memory->create(radixindex,maxsort,"dump:radixindex");
       }
     }
 
@@ -705,10 +822,9 @@ void Dump::sort()
 
   // if reorder flag is set & total/per-proc counts match pre-computed values,
   // then create index directly from idsort
-  // else quicksort of index using IDs or buf column as comparator
+  // else radix sort of index on IDs or sort of index using buf column as comparator
 
   if (reorderflag) {
-    if (ntotal != ntotal_reorder) reorderflag = 0;
     int flag = 0;
     if (nme != nme_reorder) flag = 1;
     int flagall;
@@ -720,19 +836,19 @@ void Dump::sort()
         index[idsort[i]-idlo] = i;
   }
 
+  if (!reorderflag && sortcol == 0) sort_radix();
+
 #if defined(LMP_QSORT)
-  if (!reorderflag) {
+  if (!reorderflag && sortcol) {
     dumpptr = this;
     for (i = 0; i < nme; i++) index[i] = i;
-    if (sortcol == 0) qsort(index,nme,sizeof(int),idcompare);
-    else if (sortorder == ASCEND) qsort(index,nme,sizeof(int),bufcompare);
+    if (sortorder == ASCEND) qsort(index,nme,sizeof(int),bufcompare);
     else qsort(index,nme,sizeof(int),bufcompare_reverse);
   }
 #else
-  if (!reorderflag) {
+  if (!reorderflag && sortcol) {
     for (i = 0; i < nme; i++) index[i] = i;
-    if (sortcol == 0) utils::merge_sort(index,nme,(void *)this,idcompare);
-    else if (sortorder == ASCEND) utils::merge_sort(index,nme,(void *)this,bufcompare);
+    if (sortorder == ASCEND) utils::merge_sort(index,nme,(void *)this,bufcompare);
     else utils::merge_sort(index,nme,(void *)this,bufcompare_reverse);
   }
 #endif
@@ -744,6 +860,8 @@ void Dump::sort()
   MPI_Allreduce(&nme,&nmax,1,MPI_INT,MPI_MAX,world);
 
   if (nmax > maxbuf) {
+    if ((bigint) nmax * size_one > MAXSMALLINT)
+      error->all(FLERR,"Too much per-proc info for dump");
     maxbuf = nmax;
     memory->destroy(buf);
     memory->create(buf,maxbuf*size_one,"dump:buf");
@@ -756,26 +874,90 @@ void Dump::sort()
     memcpy(&buf[i*size_one],&bufsort[index[i]*size_one],nbytes);
 }
 
-#if defined(LMP_QSORT)
+/* ----------------------------------------------------------------------
+   choose nprocs-1 splitters for a sample sort from samples of all procs
+   samples are gathered and sorted on proc 0, splitters are evenly spaced
+     in the sorted samples and broadcast to all procs
+   datum with key K goes to proc = # of splitters <= K
+------------------------------------------------------------------------- */
+
+template <typename T>
+void Dump::sort_splitters(std::vector<T> &samples, std::vector<T> &splitters)
+{
+  int nsample = samples.size();
+  int nbytes = nsample*sizeof(T);
+
+  std::vector<int> recvcounts,displs;
+  if (me == 0) recvcounts.resize(nprocs);
+  MPI_Gather(&nbytes,1,MPI_INT,recvcounts.data(),1,MPI_INT,0,world);
+
+  std::vector<T> allsamples;
+  if (me == 0) {
+    displs.resize(nprocs);
+    int ntotal_bytes = 0;
+    for (int iproc = 0; iproc < nprocs; iproc++) {
+      displs[iproc] = ntotal_bytes;
+      ntotal_bytes += recvcounts[iproc];
+    }
+    allsamples.resize(ntotal_bytes/sizeof(T));
+  }
+  MPI_Gatherv(samples.data(),nbytes,MPI_CHAR,allsamples.data(),recvcounts.data(),
+              displs.data(),MPI_CHAR,0,world);
+
+  splitters.resize(nprocs-1);
+  if (me == 0) {
+    std::sort(allsamples.begin(),allsamples.end());
+    bigint nall = allsamples.size();
+    if (nall)
+      for (int iproc = 1; iproc < nprocs; iproc++)
+        splitters[iproc-1] = allsamples[iproc*nall/nprocs];
+  }
+  MPI_Bcast(splitters.data(),(nprocs-1)*sizeof(T),MPI_CHAR,0,world);
+}
 
 /* ----------------------------------------------------------------------
-   compare two atom IDs
-   called via qsort() in sort() method
-   is a static method so access data via dumpptr
+   set index to the order of idsort via LSD radix sort
+   digits are taken from ID - min ID, so only as many passes are done
+     as there are RADIXBITS digits in the range of my IDs
 ------------------------------------------------------------------------- */
 
-int Dump::idcompare(const void *pi, const void *pj)
+void Dump::sort_radix()
 {
-  tagint *idsort = dumpptr->idsort;
+  int i;
+  int count[RADIXSIZE+1];
 
-  int i = *((int *) pi);
-  int j = *((int *) pj);
+  for (i = 0; i < nme; i++) index[i] = i;
+  if (nme < 2) return;
 
-  if (idsort[i] < idsort[j]) return -1;
-  if (idsort[i] > idsort[j]) return 1;
-  return 0;
+  tagint min = idsort[0];
+  tagint max = idsort[0];
+  for (i = 1; i < nme; i++) {
+    min = MIN(min,idsort[i]);
+    max = MAX(max,idsort[i]);
+  }
+  auto range = (uint64_t) max - (uint64_t) min;
+
+  int *src = index;
+  int *dest = radixindex;
+
+  for (int shift = 0; shift < 64 && (range >> shift); shift += RADIXBITS) {
+    for (i = 0; i <= RADIXSIZE; i++) count[i] = 0;
+    for (i = 0; i < nme; i++)
+      count[(((uint64_t) idsort[src[i]] - (uint64_t) min) >> shift & RADIXMASK) + 1]++;
+    for (i = 0; i < RADIXSIZE; i++) count[i+1] += count[i];
+    for (i = 0; i < nme; i++)
+      dest[count[((uint64_t) idsort[src[i]] - (uint64_t) min) >> shift & RADIXMASK]++] = src[i];
+
+    int *tmp = src;
+    src = dest;
+    dest = tmp;
+  }
+
+  if (src != index) memcpy(index,src,nme*sizeof(int));
 }
 
+#if defined(LMP_QSORT)
+
 /* ----------------------------------------------------------------------
    compare two buffer values with size_one stride
    called via qsort() in sort() method
@@ -820,19 +1002,6 @@ int Dump::bufcompare_reverse(const void *pi, const void *pj)
 
 #else
 
-/* ----------------------------------------------------------------------
-   compare two atom IDs
-   called via merge_sort() in sort() method
-------------------------------------------------------------------------- */
-
-int Dump::idcompare(const int i, const int j, void *ptr)
-{
-  tagint *idsort = ((Dump *)ptr)->idsort;
-  if (idsort[i] < idsort[j]) return -1;
-  else if (idsort[i] > idsort[j]) return 1;
-  else return 0;
-}
-
 /* ----------------------------------------------------------------------
    compare two buffer values with size_one stride
    called via merge_sort() in sort() method
@@ -1031,6 +1200,8 @@ void Dump::modify_params(int narg, char **arg)
 {
   if (narg == 0) error->all(FLERR,"Illegal dump_modify command");
 
+  wait_async();
+
   int iarg = 0;
   while (iarg < narg) {
     if (strcmp(arg[iarg],"append") == 0) {
@@ -1038,6 +1209,13 @@ void Dump::modify_params(int narg, char **arg)
       append_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal dump_modify command");
+      async_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (async_flag && async_allow == 0)
+        error->all(FLERR,"Dump_modify async yes not allowed for this style");
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"buffer") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal dump_modify command");
       buffer_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
@@ -1320,11 +1498,13 @@ double Dump::memory_usage()
 {
   double bytes = memory->usage(buf,size_one*maxbuf);
   bytes += memory->usage(sbuf,maxsbuf);
+  bytes += (double) abuf.capacity();
   if (sort_flag) {
     if (sortcol == 0) bytes += memory->usage(ids,maxids);
     bytes += memory->usage(bufsort,size_one*maxsort);
     if (sortcol == 0) bytes += memory->usage(idsort,maxsort);
     bytes += memory->usage(index,maxsort);
+    if (sortcol == 0) bytes += memory->usage(radixindex,maxsort);
     bytes += memory->usage(proclist,maxproc);
     if (irregular) bytes += (double)irregular->memory_usage();
   }
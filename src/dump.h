@@ -17,6 +17,8 @@
 #include "pointers.h"    // IWYU pragma: export
 
 #include <map>
+#include <thread>
+#include <vector>
 
 namespace LAMMPS_NS {
 
@@ -44,6 +46,7 @@ class Dump : protected Pointers {
   ~Dump() override;
   void init();
   virtual void write();
+  void wait_async();
 
   virtual int pack_forward_comm(int, int *, double *, int, int *) { return 0; }
   virtual void unpack_forward_comm(int, int, double *) {}
@@ -73,6 +76,8 @@ class Dump : protected Pointers {
   int append_flag;          // 1 if open file in append mode, 0 if not
   int buffer_allow;         // 1 if style allows for buffer_flag, 0 if not
   int buffer_flag;          // 1 if buffer output as one big string, 0 if not
+  int async_allow;          // 1 if style allows for async_flag, 0 if not
+  int async_flag;           // 1 if filewriters write on a helper thread, 0 if not
   int padflag;              // timestep padding in filename
   int pbcflag;              // 1 if remap dumped atoms via PBC, 0 if not
   int singlefile_opened;    // 1 = one big file, already opened, else 0
@@ -132,12 +137,13 @@ class Dump : protected Pointers {
   char *sbuf;     // memory for atom quantities in string format
 
   int maxids;     // size of ids
-  int maxsort;    // size of bufsort, idsort, index
+  int maxsort;    // size of bufsort, idsort, index, radixindex
   int maxproc;    // size of proclist
   tagint *ids;    // list of atom IDs, if sorting on IDs
   double *bufsort;
   tagint *idsort;
   int *index, *proclist;
+  int *radixindex;    // scratch permutation for radix sort on IDs
 
   double **xpbc, **vpbc;
   imageint *imagepbc;
@@ -145,6 +151,13 @@ class Dump : protected Pointers {
 
   class Irregular *irregular;
 
+  // asynchronous output
+
+  std::thread asyncthread;       // helper thread of filewriter writing last snapshot
+  MPI_Request asyncrequest;      // send of my data to fileproc
+  std::vector<char> abuf;        // data of all procs in my cluster, on filewriter
+  std::vector<int> acounts;      // # of lines or chars from each proc in my cluster
+
   virtual void init_style() = 0;
   virtual void openfile();
   virtual int modify_param(int, char **) { return 0; }
@@ -157,16 +170,17 @@ class Dump : protected Pointers {
   double compute_time();
 
   void sort();
+  template <typename T> void sort_splitters(std::vector<T> &, std::vector<T> &);
+  void sort_radix();
 #if defined(LMP_QSORT)
-  static int idcompare(const void *, const void *);
   static int bufcompare(const void *, const void *);
   static int bufcompare_reverse(const void *, const void *);
 #else
-  static int idcompare(const int, const int, void *);
   static int bufcompare(const int, const int, void *);
   static int bufcompare_reverse(const int, const int, void *);
 #endif
   void balance();
+  void write_async();
 };
 
 }    // namespace LAMMPS_NS
@@ -37,6 +37,10 @@ DumpAtom::DumpAtom(LAMMPS *lmp, int narg, char **arg) : Dump(lmp, narg, arg)
   image_flag = 0;
   buffer_allow = 1;
   buffer_flag = 1;
+
+  // derived styles that post-process the file in write() cannot be async
+
+  async_allow = (strcmp(style,"atom") == 0) ? 1 : 0;
   format_default = nullptr;
   key2col = { { "id", 0 }, { "type", 1 }, { "x", 2 }, { "y", 3 },
               { "z", 4 }, { "ix", 5 }, { "iy", 6 }, { "iz", 7 } };
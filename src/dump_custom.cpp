@@ -16,6 +16,7 @@
 
 #include "arg_info.h"
 #include "atom.h"
+#include "comm.h"
 #include "compute.h"
 #include "domain.h"
 #include "error.h"
@@ -25,10 +26,12 @@
 #include "input.h"
 #include "memory.h"
 #include "modify.h"
+#include "output.h"
 #include "region.h"
 #include "update.h"
 #include "variable.h"
 
+#include <cctype>
 #include <cstring>
 
 using namespace LAMMPS_NS;
@@ -49,13 +52,88 @@ enum{LT,LE,GT,GE,EQ,NEQ,XOR};
 
 #define ONEFIELD 32
 #define DELTA 1048576
+#define FORMAT_THREAD_MIN 4096    // min # of lines to format with threads
+
+/* ----------------------------------------------------------------------
+   convert printf() style format with one conversion for a column of type
+     vtype to an fmt format string that produces identical output
+   return empty string if format uses a feature without such an equivalent
+------------------------------------------------------------------------- */
+
+std::string DumpCustom::printf2fmt(const char *format, int vtype)
+{
+  std::string result;
+  int nconvert = 0;
+
+  for (const char *ptr = format; *ptr; ++ptr) {
+    if ((*ptr == '{') || (*ptr == '}')) {
+      result += *ptr;
+      result += *ptr;
+      continue;
+    }
+    if (*ptr != '%') {
+      result += *ptr;
+      continue;
+    }
+    if (*++ptr == '%') {
+      result += '%';
+      continue;
+    }
+    if (nconvert++) return "";
+
+    // flags, width, precision, and length modifier of conversion
+
+    bool left = false, plus = false, space = false, zero = false;
+    for (;; ++ptr) {
+      if (*ptr == '-') left = true;
+      else if (*ptr == '+') plus = true;
+      else if (*ptr == ' ') space = true;
+      else if (*ptr == '0') zero = true;
+      else break;
+    }
+    std::string width, precision;
+    while (isdigit(*ptr)) width += *ptr++;
+    if (*ptr == '.') {
+      precision += *ptr++;
+      while (isdigit(*ptr)) precision += *ptr++;
+      if (precision.size() == 1) precision += '0';
+    }
+    while (*ptr == 'l') ++ptr;
+
+    // conversion must match the type of the column
+    // printf() right aligns all values, fmt left aligns strings and inf/nan
+
+    char conversion = *ptr;
+    if ((vtype == Dump::INT) || (vtype == Dump::BIGINT)) {
+      if (((conversion != 'd') && (conversion != 'i')) || precision.size()) return "";
+      conversion = 'd';
+    } else if (vtype == Dump::DOUBLE) {
+      if (!conversion || !strchr("eEfFgG",conversion)) return "";
+    } else if (vtype == Dump::STRING) {
+      if ((conversion != 's') || precision.size() || plus || space || zero) return "";
+    } else return "";
+
+    result += "{:";
+    if (left) result += '<';
+    else if (!zero) result += '>';
+    if (plus) result += '+';
+    else if (space) result += ' ';
+    if (zero && !left) result += '0';
+    result += width + precision;
+    if (conversion != 's') result += conversion;
+    result += '}';
+  }
+
+  if (nconvert != 1) return "";
+  return result;
+}
 
 /* ---------------------------------------------------------------------- */
 
 DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
   Dump(lmp, narg, arg), idregion(nullptr), thresh_array(nullptr), thresh_op(nullptr),
   thresh_value(nullptr), thresh_last(nullptr), thresh_fix(nullptr), thresh_fixID(nullptr),
-  thresh_first(nullptr), earg(nullptr), vtype(nullptr), vformat(nullptr), columns(nullptr),
+  thresh_first(nullptr), earg(nullptr), vtype(nullptr), vformat(nullptr), fmtflag(0), columns(nullptr),
   columns_default(nullptr), choose(nullptr), dchoose(nullptr), clist(nullptr),
   field2index(nullptr), argindex(nullptr), id_compute(nullptr), compute(nullptr), id_fix(nullptr),
   fix(nullptr), id_variable(nullptr), variable(nullptr), vbuf(nullptr), id_custom(nullptr),
@@ -87,6 +165,10 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
   buffer_allow = 1;
   buffer_flag = 1;
 
+  // derived styles that post-process the file in write() cannot be async
+
+  async_allow = (strcmp(style,"custom") == 0) ? 1 : 0;
+
   nthresh = 0;
   nthreshlast = 0;
 
@@ -284,6 +366,16 @@ void DumpCustom::init_style()
     ++i;
   }
 
+  // convert formats to fmt format strings for faster text output
+  // fall back to printf() style output if any format has no fmt equivalent
+
+  fmtflag = 1;
+  fmtformat.resize(nfield);
+  for (i = 0; i < nfield; i++) {
+    fmtformat[i] = printf2fmt(vformat[i],vtype[i]);
+    if (fmtformat[i].empty()) fmtflag = 0;
+  }
+
   // setup boundary string
 
   domain->boundary_string(boundstr);
@@ -1165,6 +1257,24 @@ int DumpCustom::convert_string(int n, double *mybuf)
 {
   int i,j;
 
+  if (fmtflag) {
+    int nchunk = format_chunks(n,mybuf);
+    bigint nchars = 0;
+    for (i = 0; i < nchunk; i++) nchars += fmtbuf[i].size();
+    if (nchars > MAXSMALLINT) return -1;
+    if (nchars > maxsbuf) {
+      maxsbuf = MIN((nchars/DELTA + 1)*DELTA,MAXSMALLINT);
+      memory->grow(sbuf,maxsbuf,"dump:sbuf");
+    }
+
+    int offset = 0;
+    for (i = 0; i < nchunk; i++) {
+      memcpy(&sbuf[offset],fmtbuf[i].data(),fmtbuf[i].size());
+      offset += fmtbuf[i].size();
+    }
+    return offset;
+  }
+
   int offset = 0;
   int m = 0;
   for (i = 0; i < n; i++) {
@@ -1222,6 +1332,13 @@ void DumpCustom::write_lines(int n, double *mybuf)
 {
   int i,j;
 
+  if (fmtflag) {
+    int nchunk = format_chunks(n,mybuf);
+    for (i = 0; i < nchunk; i++)
+      fwrite(fmtbuf[i].data(),sizeof(char),fmtbuf[i].size(),fp);
+    return;
+  }
+
   int m = 0;
   for (i = 0; i < n; i++) {
     for (j = 0; j < nfield; j++) {
@@ -1237,6 +1354,58 @@ void DumpCustom::write_lines(int n, double *mybuf)
   }
 }
 
+/* ----------------------------------------------------------------------
+   format n lines of mybuf with fmt into fmtbuf, one chunk per thread
+   chunks are formatted concurrently if enabled by package omp
+   return # of chunks
+------------------------------------------------------------------------- */
+
+int DumpCustom::format_chunks(int n, double *mybuf)
+{
+  int nchunk = 1;
+#if defined(_OPENMP)
+  if (output->dump_threaded && (n >= FORMAT_THREAD_MIN)) nchunk = comm->nthreads;
+#endif
+  if ((int) fmtbuf.size() < nchunk) fmtbuf.resize(nchunk);
+
+#if defined(_OPENMP)
+#pragma omp parallel for default(shared) num_threads(nchunk) if(nchunk > 1)
+#endif
+  for (int ichunk = 0; ichunk < nchunk; ichunk++) {
+    int ilo = static_cast<int> ((bigint) ichunk*n/nchunk);
+    int ihi = static_cast<int> ((bigint) (ichunk+1)*n/nchunk);
+    fmtbuf[ichunk].clear();
+    format_lines(ilo,ihi,mybuf,fmtbuf[ichunk]);
+  }
+
+  return nchunk;
+}
+
+/* ----------------------------------------------------------------------
+   append lines ilo to ihi-1 of mybuf formatted with fmtformat to out
+------------------------------------------------------------------------- */
+
+void DumpCustom::format_lines(int ilo, int ihi, double *mybuf, fmt::memory_buffer &out)
+{
+  auto it = std::back_inserter(out);
+
+  int m = ilo*nfield;
+  for (int i = ilo; i < ihi; i++) {
+    for (int j = 0; j < nfield; j++) {
+      if (vtype[j] == Dump::INT)
+        fmt::format_to(it,fmt::runtime(fmtformat[j]),static_cast<int> (mybuf[m]));
+      else if (vtype[j] == Dump::DOUBLE)
+        fmt::format_to(it,fmt::runtime(fmtformat[j]),mybuf[m]);
+      else if (vtype[j] == Dump::STRING)
+        fmt::format_to(it,fmt::runtime(fmtformat[j]),typenames[(int) mybuf[m]]);
+      else if (vtype[j] == Dump::BIGINT)
+        fmt::format_to(it,fmt::runtime(fmtformat[j]),static_cast<bigint> (mybuf[m]));
+      m++;
+    }
+    out.push_back('\n');
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 int DumpCustom::parse_fields(int narg, char **arg)
@@ -2034,6 +2203,7 @@ double DumpCustom::memory_usage()
   bytes += memory->usage(dchoose,maxlocal);
   bytes += memory->usage(clist,maxlocal);
   bytes += memory->usage(vbuf,nvariable,maxlocal);
+  for (const auto &chunk : fmtbuf) bytes += (double) chunk.capacity();
   return bytes;
 }
 
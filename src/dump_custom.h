@@ -58,6 +58,10 @@ class DumpCustom : public Dump {
   int *vtype;        // type of each vector (INT, DOUBLE)
   char **vformat;    // format string for each vector element
                      //
+  int fmtflag;                             // 1 if all vformat have an fmt equivalent
+  std::vector<std::string> fmtformat;      // fmt format string for each vector element
+  std::vector<fmt::memory_buffer> fmtbuf;  // formatted lines of each chunk, reused
+                                           //
   char *columns;     // column labels
   char *columns_default;
   //
@@ -137,6 +141,9 @@ class DumpCustom : public Dump {
   void write_binary(int, double *);
   void write_string(int, double *);
   void write_lines(int, double *);
+  static std::string printf2fmt(const char *, int);
+  int format_chunks(int, double *);
+  void format_lines(int, int, double *, fmt::memory_buffer &);
 
   // customize by adding a method prototype
 
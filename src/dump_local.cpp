@@ -66,6 +66,10 @@ DumpLocal::DumpLocal(LAMMPS *lmp, int narg, char **arg) :
   buffer_allow = 1;
   buffer_flag = 1;
 
+  // derived styles that post-process the file in write() cannot be async
+
+  async_allow = (strcmp(style,"local") == 0) ? 1 : 0;
+
   // computes & fixes which the dump accesses
 
   field2index = new int[nfield];
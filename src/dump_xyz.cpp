@@ -38,6 +38,10 @@ DumpXYZ::DumpXYZ(LAMMPS *lmp, int narg, char **arg) : Dump(lmp, narg, arg),
 
   buffer_allow = 1;
   buffer_flag = 1;
+
+  // derived styles that post-process the file in write() cannot be async
+
+  async_allow = (strcmp(style,"xyz") == 0) ? 1 : 0;
   sort_flag = 1;
   sortcol = 0;
 
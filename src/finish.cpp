@@ -522,6 +522,8 @@ void Finish::end(int flag)
       if ((atom->molecular != Atom::ATOMIC) && (atom->natoms > 0))
         mesg += fmt::format("Ave special neighs/atom = {:.8}\n",nspec_all/atom->natoms);
       mesg += fmt::format("Neighbor list builds = {}\n",neighbor->ncalls);
+      if (neighbor->incremental > 0.0)
+        mesg += fmt::format("Incremental builds = {}\n",neighbor->nincremental);
       if (neighbor->dist_check)
         mesg += fmt::format("Dangerous builds = {}\n",neighbor->ndanger);
       else mesg += "Dangerous builds not checked\n";
@@ -26,6 +26,7 @@
 #include "modify.h"
 #include "neighbor.h"
 #include "rcb.h"
+#include "timer.h"
 #include "update.h"
 
 #include <cstring>
@@ -59,9 +60,15 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
   if (nevery < 0) error->all(FLERR,"Illegal fix balance command");
   thresh = utils::numeric(FLERR,arg[4],false,lmp);
 
+  int graphflag = 0;
+  double graphtol = 0.0;
+
   if (strcmp(arg[5],"shift") == 0) lbstyle = SHIFT;
   else if (strcmp(arg[5],"rcb") == 0) lbstyle = BISECTION;
-  else error->all(FLERR,"Illegal fix balance command");
+  else if (strcmp(arg[5],"graph") == 0) {
+    lbstyle = BISECTION;
+    graphflag = 1;
+  } else error->all(FLERR,"Illegal fix balance command");
 
   int iarg = 5;
   if (lbstyle == SHIFT) {
@@ -77,6 +84,11 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
 
   } else if (lbstyle == BISECTION) {
     iarg++;
+    if (graphflag) {
+      if (iarg+1 > narg) error->all(FLERR,"Illegal fix balance command");
+      graphtol = utils::numeric(FLERR,arg[iarg],false,lmp);
+      iarg++;
+    }
   }
 
   // error checks
@@ -103,12 +115,19 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
 
   balance = new Balance(lmp);
   if (lbstyle == SHIFT) balance->shift_setup(bstr,nitermax,thresh);
+  if (graphflag) balance->graph_setup(graphtol);
   balance->options(iarg,narg,arg);
   wtflag = balance->wtflag;
 
   if (balance->varflag && nevery == 0)
     error->all(FLERR,"Fix balance nevery = 0 cannot be used with weight var");
 
+  adaptflag = balance->adaptflag;
+  if (adaptflag && nevery == 0)
+    error->all(FLERR,"Fix balance nevery = 0 cannot be used with adaptive");
+  if (adaptflag && lbstyle != SHIFT)
+    error->all(FLERR,"Fix balance adaptive requires balance style shift");
+
   // create instance of Irregular class
 
   irregular = new Irregular(lmp);
@@ -124,6 +143,12 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
   itercount = 0;
   pending = 0;
   imbfinal = imbprev = maxloadperproc = 0.0;
+
+  lastcheck = -1;
+  lastbusy = 0.0;
+  wasteprev = -1.0;
+  wasteresid = balancecost = 0.0;
+  residflag = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -198,6 +223,15 @@ void FixBalance::setup_pre_exchange()
   imbnow = balance->imbalance_factor(maxloadperproc);
   if (imbnow > thresh) rebalance();
 
+  // timers are reset at start of run, restart adaptive measurements
+
+  if (adaptflag) {
+    lastcheck = update->ntimestep;
+    lastbusy = busy_time();
+    wasteprev = -1.0;
+    residflag = 1;
+  }
+
   // next timestep to rebalance
 
   if (nevery) next_reneighbor = (update->ntimestep/nevery)*nevery + nevery;
@@ -235,13 +269,82 @@ void FixBalance::pre_exchange()
   if (balance->varflag) modify->addstep_compute(update->ntimestep + nevery);
 
   imbnow = balance->imbalance_factor(maxloadperproc);
-  if (imbnow > thresh) rebalance();
+
+  // adaptive: rebalance only if predicted gain exceeds measured cost
+  // time the rebalance so the cost model uses the actual migration cost
+
+  if (adaptflag) {
+    if (adapt_check() && imbnow > thresh) {
+      double start = platform::walltime();
+      rebalance();
+      double cost = platform::walltime() - start;
+      MPI_Allreduce(&cost,&balancecost,1,MPI_DOUBLE,MPI_MAX,world);
+      residflag = 1;
+    }
+  } else if (imbnow > thresh) rebalance();
 
   // next timestep to rebalance
 
   if (nevery) next_reneighbor = (update->ntimestep/nevery)*nevery + nevery;
 }
 
+/* ----------------------------------------------------------------------
+   compute time on this proc from the same timers as weight time
+------------------------------------------------------------------------- */
+
+double FixBalance::busy_time()
+{
+  if (!timer->has_normal()) return 0.0;
+
+  double busy = timer->get_wall(Timer::PAIR);
+  busy += timer->get_wall(Timer::NEIGH);
+  busy += timer->get_wall(Timer::BOND);
+  busy += timer->get_wall(Timer::KSPACE);
+  return busy;
+}
+
+/* ----------------------------------------------------------------------
+   cost model for adaptive rebalancing
+   waste = time per step lost to imbalance in last interval = max - ave
+   its growth rate is extrapolated linearly from the previous interval
+   gain = waste expected over next Nevery steps beyond the residual waste
+     measured right after the last rebalance
+   return 1 if gain exceeds the measured time of the last rebalance
+   return 1 if timers are not available, then thresh alone decides
+------------------------------------------------------------------------- */
+
+int FixBalance::adapt_check()
+{
+  if (!timer->has_normal()) return 1;
+
+  bigint nsteps = update->ntimestep - lastcheck;
+  double busy = busy_time();
+  double delta = busy - lastbusy;
+  lastbusy = busy;
+  lastcheck = update->ntimestep;
+  if (nsteps <= 0) return 0;
+
+  double maxbusy,sumbusy;
+  MPI_Allreduce(&delta,&maxbusy,1,MPI_DOUBLE,MPI_MAX,world);
+  MPI_Allreduce(&delta,&sumbusy,1,MPI_DOUBLE,MPI_SUM,world);
+  double waste = (maxbusy - sumbusy/comm->nprocs) / nsteps;
+
+  // 1st interval after a rebalance measures what it could not remove
+
+  if (residflag) {
+    wasteresid = waste;
+    residflag = 0;
+  }
+
+  double rate = 0.0;
+  if (wasteprev >= 0.0) rate = (waste - wasteprev) / nsteps;
+  wasteprev = waste;
+
+  double horizon = nevery;
+  double gain = horizon * (waste - wasteresid) + 0.5 * rate * horizon * horizon;
+  return (gain > balancecost) ? 1 : 0;
+}
+
 /* ----------------------------------------------------------------------
    compute final imbalance factor based on nlocal after comm->exchange()
    only do this if rebalancing just occurred
@@ -54,10 +54,20 @@ class FixBalance : public Fix {
   int pending;
   bigint lastbalance;    // last timestep balancing was attempted
 
+  int adaptflag;          // 1 if rebalancing is decided by cost model
+  bigint lastcheck;       // timestep of last adaptive check
+  double lastbusy;        // compute time on this proc at last check
+  double wasteprev;       // wasted time per step in previous interval, -1 if none
+  double wasteresid;      // wasted time per step right after last rebalance
+  double balancecost;     // measured time of last rebalance
+  int residflag;          // 1 if next check sets wasteresid
+
   class Balance *balance;
   class Irregular *irregular;
 
   void rebalance();
+  double busy_time();
+  int adapt_check();
 };
 
 }    // namespace LAMMPS_NS
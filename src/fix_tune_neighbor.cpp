@@ -0,0 +1,315 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_tune_neighbor.h"
+
+#include "comm.h"
+#include "error.h"
+#include "neighbor.h"
+#include "timer.h"
+#include "update.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+#define FACTOR 1.2
+#define FACTOR_MIN 1.02
+
+/* ---------------------------------------------------------------------- */
+
+FixTuneNeighbor::FixTuneNeighbor(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg)
+{
+  if (narg < 4) error->all(FLERR,"Illegal fix tune/neighbor command");
+
+  scalar_flag = 1;
+  extscalar = 0;
+  vector_flag = 1;
+  size_vector = 3;
+  extvector = 0;
+  global_freq = 1;
+  nevery = 1;
+
+  period = utils::inumeric(FLERR,arg[3],false,lmp);
+  if (period <= 0) error->all(FLERR,"Illegal fix tune/neighbor command");
+
+  // optional args
+
+  skinmin = 0.25*neighbor->skin;
+  skinmax = 4.0*neighbor->skin;
+  factor = FACTOR;
+  factor_min = FACTOR_MIN;
+
+  int iarg = 4;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"skin") == 0) {
+      if (iarg+3 > narg) error->all(FLERR,"Illegal fix tune/neighbor command");
+      skinmin = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      skinmax = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      iarg += 3;
+    } else if (strcmp(arg[iarg],"factor") == 0) {
+      if (iarg+3 > narg) error->all(FLERR,"Illegal fix tune/neighbor command");
+      factor = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      factor_min = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      if (factor_min <= 1.0 || factor < factor_min)
+        error->all(FLERR,"Illegal fix tune/neighbor factor values");
+      iarg += 3;
+    } else error->all(FLERR,"Illegal fix tune/neighbor command");
+  }
+
+  if (skinmin <= 0.0 || skinmax < skinmin)
+    error->all(FLERR,"Illegal fix tune/neighbor skin range");
+
+  reset = 1;
+  first = 1;
+  converged = 0;
+  direction = 1;
+  nfail = 0;
+  best_skin = neighbor->skin;
+  best_cost = 0.0;
+  interval = 0.0;
+  last_step = last_build = -1;
+  last_time = 0.0;
+  last_ncalls = last_ndanger = 0;
+  next_check = -1;
+  min_interval = 0;
+
+  // force reneighboring at end of each sample, so skin can change
+
+  force_reneighbor = 1;
+  next_reneighbor = -1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixTuneNeighbor::setmask()
+{
+  int mask = 0;
+  mask |= PRE_EXCHANGE;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixTuneNeighbor::init()
+{
+  if (!neighbor->dist_check)
+    error->all(FLERR,"Fix tune/neighbor requires neigh_modify check yes");
+  if (neighbor->skin <= 0.0)
+    error->all(FLERR,"Fix tune/neighbor requires a neighbor skin > 0.0");
+  if (!timer->has_normal() && comm->me == 0)
+    error->warning(FLERR,"Fix tune/neighbor uses total time per step with timer level < normal");
+}
+
+/* ----------------------------------------------------------------------
+   timers are reset after setup, so store baseline after first step
+------------------------------------------------------------------------- */
+
+void FixTuneNeighbor::setup(int /*vflag*/)
+{
+  reset = 1;
+  if (converged) {
+    next_reneighbor = -1;
+    next_check = update->ntimestep + period;
+  } else next_reneighbor = update->ntimestep + period;
+}
+
+/* ----------------------------------------------------------------------
+   record shortest interval between neighbor list builds
+   intervals ending at a build forced by this fix are ignored
+------------------------------------------------------------------------- */
+
+void FixTuneNeighbor::end_of_step()
+{
+  bigint ntimestep = update->ntimestep;
+
+  if (reset) {
+    last_time = get_time();
+    last_step = ntimestep;
+    last_ncalls = neighbor->ncalls;
+    last_ndanger = neighbor->ndanger;
+    last_build = neighbor->lastcall;
+    min_interval = MAXSMALLINT;
+    reset = 0;
+    return;
+  }
+
+  if (neighbor->lastcall == ntimestep) {
+    if (ntimestep != next_reneighbor - period || converged)
+      min_interval = MIN(min_interval,ntimestep - last_build);
+    last_build = ntimestep;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   sample cost per step of pair, neighbor, and comm since last sample
+   and adjust skin, delay, and every
+   skin is optimized by a line search with shrinking relative steps
+------------------------------------------------------------------------- */
+
+void FixTuneNeighbor::pre_exchange()
+{
+  bigint ntimestep = update->ntimestep;
+  if (reset) return;
+  if (converged) {
+    if (ntimestep < next_check) return;
+  } else if (ntimestep != next_reneighbor) return;
+
+  double time = get_time();
+  bigint nsteps = ntimestep - last_step;
+  bigint nbuild = neighbor->ncalls - last_ncalls;
+  bigint ndanger = neighbor->ndanger - last_ndanger;
+  if (nsteps <= 0) return;
+
+  double cost = (time - last_time) / nsteps;
+  interval = (nbuild > 0) ? (double) nsteps / nbuild : (double) nsteps;
+
+  double skin = neighbor->skin;
+  double newskin = skin;
+
+  if (comm->me == 0)
+    utils::logmesg(lmp,"Fix tune/neighbor: skin = {:.8g}, time/step = {:.8g}, "
+                   "steps/build = {:.4g}, dangerous builds = {}\n",
+                   skin,cost,interval,ndanger);
+
+  if (ndanger > 0) {
+
+    // atoms moved more than half the skin before the first check
+    // check every step without delay, else increase skin and never go lower
+
+    if (neighbor->delay > 0 || neighbor->every > 1) {
+      neighbor->delay = 0;
+      neighbor->every = 1;
+    } else {
+      newskin = MIN(skin*FACTOR,skinmax);
+      skinmin = MAX(skinmin,newskin);
+      best_skin = newskin;
+      first = 1;
+    }
+
+  } else if (!converged) {
+    if (first) {
+      best_skin = skin;
+      best_cost = cost;
+      first = 0;
+    } else if (cost < best_cost) {
+      best_skin = skin;
+      best_cost = cost;
+      nfail = 0;
+    } else {
+      direction = -direction;
+      if (++nfail >= 2) {
+        factor = sqrt(factor);
+        nfail = 0;
+      }
+    }
+
+    // next trial skin, reverse direction at bounds of the skin range
+
+    if (factor < factor_min) converged = 1;
+    else {
+      newskin = best_skin * pow(factor,direction);
+      if (newskin < skinmin || newskin > skinmax) {
+        direction = -direction;
+        newskin = best_skin * pow(factor,direction);
+      }
+      newskin = MAX(newskin,skinmin);
+      newskin = MIN(newskin,skinmax);
+      if (newskin == best_skin) converged = 1;
+    }
+    if (converged) {
+      newskin = best_skin;
+      if (comm->me == 0)
+        utils::logmesg(lmp,"Fix tune/neighbor: converged to skin = {:.8g}\n",newskin);
+    }
+
+  } else if (min_interval < MAXSMALLINT) {
+
+    // skin is final: delay first check by half the shortest interval
+
+    neighbor->every = 1;
+    neighbor->delay = MAX(0,min_interval/2);
+  }
+
+  if (newskin != skin) {
+    neighbor->delay = 0;
+    neighbor->every = 1;
+    set_skin(newskin);
+  }
+
+  if (converged) {
+    next_reneighbor = -1;
+    next_check = ntimestep + period;
+  } else next_reneighbor = ntimestep + period;
+
+  last_time = get_time();
+  last_step = ntimestep;
+  last_ncalls = neighbor->ncalls;
+  last_ndanger = neighbor->ndanger;
+  min_interval = MAXSMALLINT;
+}
+
+/* ----------------------------------------------------------------------
+   time spent in pair, neighbor, and comm averaged over procs
+   these are the parts of a timestep that depend on the skin
+------------------------------------------------------------------------- */
+
+double FixTuneNeighbor::get_time()
+{
+  double mytime;
+  if (timer->has_normal())
+    mytime = timer->get_wall(Timer::PAIR) + timer->get_wall(Timer::NEIGH)
+      + timer->get_wall(Timer::COMM);
+  else mytime = timer->elapsed(Timer::TOTAL);
+
+  double time;
+  MPI_Allreduce(&mytime,&time,1,MPI_DOUBLE,MPI_SUM,world);
+  return time/comm->nprocs;
+}
+
+/* ----------------------------------------------------------------------
+   change skin and reinitialize neighbor lists, bins, and ghost cutoff
+   called from pre_exchange() so atoms are exchanged with the new cutoff
+------------------------------------------------------------------------- */
+
+void FixTuneNeighbor::set_skin(double newskin)
+{
+  neighbor->reset_skin(newskin);
+  comm->setup();
+  neighbor->setup_bins();
+}
+
+/* ----------------------------------------------------------------------
+   return current skin
+------------------------------------------------------------------------- */
+
+double FixTuneNeighbor::compute_scalar()
+{
+  return neighbor->skin;
+}
+
+/* ----------------------------------------------------------------------
+   return mean steps between builds in last sample, delay, and converged flag
+------------------------------------------------------------------------- */
+
+double FixTuneNeighbor::compute_vector(int n)
+{
+  if (n == 0) return interval;
+  if (n == 1) return neighbor->delay;
+  return converged;
+}
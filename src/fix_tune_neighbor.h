@@ -0,0 +1,69 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+// clang-format off
+FixStyle(tune/neighbor,FixTuneNeighbor);
+// clang-format on
+#else
+
+#ifndef LMP_FIX_TUNE_NEIGHBOR_H
+#define LMP_FIX_TUNE_NEIGHBOR_H
+
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixTuneNeighbor : public Fix {
+ public:
+  FixTuneNeighbor(class LAMMPS *, int, char **);
+
+  int setmask() override;
+  void init() override;
+  void setup(int) override;
+  void end_of_step() override;
+  void pre_exchange() override;
+  double compute_scalar() override;
+  double compute_vector(int) override;
+
+ private:
+  int period;                 // # of steps between samples
+  double skinmin, skinmax;    // allowed range of skin distance
+  double factor;              // current relative change of skin per trial
+  double factor_min;          // converged when factor drops below this
+
+  bigint last_step;       // timestep of previous sample
+  double last_time;       // pair + neigh + comm time at previous sample
+  bigint last_ncalls;     // # of neighbor list builds at previous sample
+  bigint last_ndanger;    // # of dangerous builds at previous sample
+  bigint next_check;      // next timestep to sample when converged
+  bigint last_build;      // timestep of last neighbor list build
+  int min_interval;       // shortest # of steps between builds in sample
+
+  int reset;          // 1 if baseline for next sample must be stored
+  int first;          // 1 if no sample was taken yet
+  int converged;      // 1 if skin is no longer changed
+  int direction;      // +1 = increase skin, -1 = decrease skin
+  int nfail;          // # of consecutive trials without improvement
+  double best_skin;   // skin with lowest cost so far
+  double best_cost;   // lowest cost per step so far
+  double interval;    // mean # of steps between builds in last sample
+
+  double get_time();
+  void set_skin(double);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -16,13 +16,17 @@
 
 #include "citeme.h"
 #include "compute.h"
+#include "error.h"
 #include "force.h"
 #include "kspace.h"
+#include "kspace_concurrent.h"
 #include "modify.h"
 #include "pair.h"
 #include "output.h"
 #include "update.h"
 
+#include <cstring>
+
 using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
@@ -32,6 +36,7 @@ Integrate::Integrate(LAMMPS *lmp, int /*narg*/, char ** /*arg*/) : Pointers(lmp)
   elist_global = elist_atom = nullptr;
   vlist_global = vlist_atom = cvlist_atom = nullptr;
   external_force_clear = 0;
+  kspace_concurrent = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -43,6 +48,7 @@ Integrate::~Integrate()
   delete [] vlist_global;
   delete [] vlist_atom;
   delete [] cvlist_atom;
+  delete kspace_concurrent;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -59,6 +65,29 @@ void Integrate::init()
   if (force->kspace && force->kspace->compute_flag) kspace_compute_flag = 1;
   else kspace_compute_flag = 0;
 
+  // with kspace_modify concurrent, KSpace is solved on the 2nd partition
+  // only the integrators with hooks for it can be used
+
+  delete kspace_concurrent;
+  kspace_concurrent = nullptr;
+  if (force->kspace && force->kspace->concurrent_flag) {
+    if ((strcmp(update->integrate_style,"verlet") != 0) &&
+        (strcmp(update->integrate_style,"respa") != 0))
+      error->universe_all(FLERR,"Kspace_modify concurrent requires run_style verlet or respa");
+    kspace_concurrent = new KSpaceConcurrent(lmp);
+  }
+
+  // kspace_modify interval N is only implemented for run_style verlet
+
+  if (force->kspace && force->kspace->interval > 1) {
+    if (strcmp(update->integrate_style,"verlet") != 0)
+      error->all(FLERR,"Kspace_modify interval > 1 requires run_style verlet");
+    if (force->kspace->concurrent_flag)
+      error->all(FLERR,"Kspace_modify interval > 1 cannot be used with kspace_modify concurrent");
+    if (force->kspace->dispersionflag)
+      error->all(FLERR,"Kspace_modify interval > 1 is not supported by dispersion KSpace styles");
+  }
+
   // should add checks:
   // for any acceleration package that has its own integrate/minimize
   // in case input script has reset the run or minimize style explicitly
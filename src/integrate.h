@@ -46,6 +46,8 @@ class Integrate : protected Pointers {
   int pair_compute_flag;      // 0 if pair->compute is skipped
   int kspace_compute_flag;    // 0 if kspace->compute is skipped
 
+  class KSpaceConcurrent *kspace_concurrent;    // KSpace on other partition, if requested
+
   void ev_setup();
   void ev_set(bigint);
 };
@@ -23,6 +23,7 @@
 #include "modify.h"
 
 #include <cstring>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
@@ -39,6 +40,7 @@ static int compare_standalone(const int, const int, void *);
 #define BUFFACTOR 1.5
 #define BUFMIN 1024
 #define BUFEXTRA 1024
+#define NBXTAG 27182
 
 /* ---------------------------------------------------------------------- */
 
@@ -320,27 +322,32 @@ int Irregular::create_atom(int n, int *sizes, int *proclist, int sortflag)
   work1[me] = 0;
 
   // nrecv_proc = # of procs I receive messages from, not including self
+  // if many procs, sparse_counts() finds it below without a collective
   // options for performing ReduceScatter operation
   // some are more efficient on some machines at big sizes
 
+  int nbxflag = (nprocs >= comm->nbx_minprocs);
+
+  if (!nbxflag) {
 #ifdef LAMMPS_RS_ALLREDUCE_INPLACE
-  MPI_Allreduce(MPI_IN_PLACE,work1,nprocs,MPI_INT,MPI_SUM,world);
-  nrecv_proc = work1[me];
+    MPI_Allreduce(MPI_IN_PLACE,work1,nprocs,MPI_INT,MPI_SUM,world);
+    nrecv_proc = work1[me];
 #else
 #ifdef LAMMPS_RS_ALLREDUCE
-  MPI_Allreduce(work1,work2,nprocs,MPI_INT,MPI_SUM,world);
-  nrecv_proc = work2[me];
+    MPI_Allreduce(work1,work2,nprocs,MPI_INT,MPI_SUM,world);
+    nrecv_proc = work2[me];
 #else
-  MPI_Reduce_scatter(work1,&nrecv_proc,work2,MPI_INT,MPI_SUM,world);
+    MPI_Reduce_scatter(work1,&nrecv_proc,work2,MPI_INT,MPI_SUM,world);
 #endif
 #endif
 
-  // allocate receive arrays
+    // allocate receive arrays
 
-  proc_recv = new int[nrecv_proc];
-  length_recv = new int[nrecv_proc];
-  request = new MPI_Request[nrecv_proc];
-  status = new MPI_Status[nrecv_proc];
+    proc_recv = new int[nrecv_proc];
+    length_recv = new int[nrecv_proc];
+    request = new MPI_Request[nrecv_proc];
+    status = new MPI_Status[nrecv_proc];
+  }
 
   // nsend_proc = # of messages I send
 
@@ -407,11 +414,16 @@ int Irregular::create_atom(int n, int *sizes, int *proclist, int sortflag)
   // sendmax_proc = # of doubles I send in largest single message
 
   sendmax_proc = 0;
-  for (i = 0; i < nsend_proc; i++) {
-    MPI_Request tmpReq; // Use non-blocking send to avoid possible deadlock
-    MPI_Isend(&length_send[i],1,MPI_INT,proc_send[i],0,world,&tmpReq);
-    MPI_Request_free(&tmpReq); // the MPI_Barrier below marks completion
+  for (i = 0; i < nsend_proc; i++)
     sendmax_proc = MAX(sendmax_proc,length_send[i]);
+
+  if (nbxflag) sparse_counts(length_send,length_recv);
+  else {
+    for (i = 0; i < nsend_proc; i++) {
+      MPI_Request tmpReq; // Use non-blocking send to avoid possible deadlock
+      MPI_Isend(&length_send[i],1,MPI_INT,proc_send[i],0,world,&tmpReq);
+      MPI_Request_free(&tmpReq); // the MPI_Barrier below marks completion
+    }
   }
 
   // receive incoming messages
@@ -421,8 +433,10 @@ int Irregular::create_atom(int n, int *sizes, int *proclist, int sortflag)
 
   int nrecvsize = 0;
   for (i = 0; i < nrecv_proc; i++) {
-    MPI_Recv(&length_recv[i],1,MPI_INT,MPI_ANY_SOURCE,0,world,status);
-    proc_recv[i] = status->MPI_SOURCE;
+    if (!nbxflag) {
+      MPI_Recv(&length_recv[i],1,MPI_INT,MPI_ANY_SOURCE,0,world,status);
+      proc_recv[i] = status->MPI_SOURCE;
+    }
     nrecvsize += length_recv[i];
   }
 
@@ -460,8 +474,9 @@ int Irregular::create_atom(int n, int *sizes, int *proclist, int sortflag)
 
   // barrier to insure all MPI_ANY_SOURCE messages are received
   // else another proc could proceed to exchange_atom() and send to me
+  // not needed for NBX, its non-blocking barrier already insured that
 
-  MPI_Barrier(world);
+  if (!nbxflag) MPI_Barrier(world);
 
   // return size of atom data I will receive
 
@@ -593,27 +608,32 @@ int Irregular::create_data(int n, int *proclist, int sortflag)
   work1[me] = 0;
 
   // nrecv_proc = # of procs I receive messages from, not including self
+  // if many procs, sparse_counts() finds it below without a collective
   // options for performing ReduceScatter operation
   // some are more efficient on some machines at big sizes
 
+  int nbxflag = (nprocs >= comm->nbx_minprocs);
+
+  if (!nbxflag) {
 #ifdef LAMMPS_RS_ALLREDUCE_INPLACE
-  MPI_Allreduce(MPI_IN_PLACE,work1,nprocs,MPI_INT,MPI_SUM,world);
-  nrecv_proc = work1[me];
+    MPI_Allreduce(MPI_IN_PLACE,work1,nprocs,MPI_INT,MPI_SUM,world);
+    nrecv_proc = work1[me];
 #else
 #ifdef LAMMPS_RS_ALLREDUCE
-  MPI_Allreduce(work1,work2,nprocs,MPI_INT,MPI_SUM,world);
-  nrecv_proc = work2[me];
+    MPI_Allreduce(work1,work2,nprocs,MPI_INT,MPI_SUM,world);
+    nrecv_proc = work2[me];
 #else
-  MPI_Reduce_scatter(work1,&nrecv_proc,work2,MPI_INT,MPI_SUM,world);
+    MPI_Reduce_scatter(work1,&nrecv_proc,work2,MPI_INT,MPI_SUM,world);
 #endif
 #endif
 
-  // allocate receive arrays
+    // allocate receive arrays
 
-  proc_recv = new int[nrecv_proc];
-  num_recv = new int[nrecv_proc];
-  request = new MPI_Request[nrecv_proc];
-  status = new MPI_Status[nrecv_proc];
+    proc_recv = new int[nrecv_proc];
+    num_recv = new int[nrecv_proc];
+    request = new MPI_Request[nrecv_proc];
+    status = new MPI_Status[nrecv_proc];
+  }
 
   // work1 = # of datums I send to each proc, including self
   // nsend_proc = # of procs I send messages to, not including self
@@ -681,11 +701,16 @@ int Irregular::create_data(int n, int *proclist, int sortflag)
   // sendmax_proc = largest # of datums I send in a single message
 
   sendmax_proc = 0;
-  for (i = 0; i < nsend_proc; i++) {
-    MPI_Request tmpReq; // Use non-blocking send to avoid possible deadlock
-    MPI_Isend(&num_send[i],1,MPI_INT,proc_send[i],0,world,&tmpReq);
-    MPI_Request_free(&tmpReq); // the MPI_Barrier below marks completion
+  for (i = 0; i < nsend_proc; i++)
     sendmax_proc = MAX(sendmax_proc,num_send[i]);
+
+  if (nbxflag) sparse_counts(num_send,num_recv);
+  else {
+    for (i = 0; i < nsend_proc; i++) {
+      MPI_Request tmpReq; // Use non-blocking send to avoid possible deadlock
+      MPI_Isend(&num_send[i],1,MPI_INT,proc_send[i],0,world,&tmpReq);
+      MPI_Request_free(&tmpReq); // the MPI_Barrier below marks completion
+    }
   }
 
   // receive incoming messages
@@ -695,8 +720,10 @@ int Irregular::create_data(int n, int *proclist, int sortflag)
 
   int nrecvdatum = 0;
   for (i = 0; i < nrecv_proc; i++) {
-    MPI_Recv(&num_recv[i],1,MPI_INT,MPI_ANY_SOURCE,0,world,status);
-    proc_recv[i] = status->MPI_SOURCE;
+    if (!nbxflag) {
+      MPI_Recv(&num_recv[i],1,MPI_INT,MPI_ANY_SOURCE,0,world,status);
+      proc_recv[i] = status->MPI_SOURCE;
+    }
     nrecvdatum += num_recv[i];
   }
   nrecvdatum += num_self;
@@ -734,8 +761,9 @@ int Irregular::create_data(int n, int *proclist, int sortflag)
 
   // barrier to insure all MPI_ANY_SOURCE messages are received
   // else another proc could proceed to exchange_data() and send to me
+  // not needed for NBX, its non-blocking barrier already insured that
 
-  MPI_Barrier(world);
+  if (!nbxflag) MPI_Barrier(world);
 
   // return # of datums I will receive
 
@@ -755,37 +783,42 @@ int Irregular::create_data_grouped(int n, int *procs, int sortflag)
   int i,j,k,m;
 
   // setup for collective comm
-  // work1 = # of datums I send to each proc, set self to 0
+  // work1 = 1 for procs I send a message to, set self to 0
   // work2 = 1 for all procs, used for ReduceScatter
 
   for (i = 0; i < nprocs; i++) {
-    work1[i] = procs[i];
+    work1[i] = procs[i] ? 1 : 0;
     work2[i] = 1;
   }
   work1[me] = 0;
 
   // nrecv_proc = # of procs I receive messages from, not including self
+  // if many procs, sparse_counts() finds it below without a collective
   // options for performing ReduceScatter operation
   // some are more efficient on some machines at big sizes
 
+  int nbxflag = (nprocs >= comm->nbx_minprocs);
+
+  if (!nbxflag) {
 #ifdef LAMMPS_RS_ALLREDUCE_INPLACE
-  MPI_Allreduce(MPI_IN_PLACE,work1,nprocs,MPI_INT,MPI_SUM,world);
-  nrecv_proc = work1[me];
+    MPI_Allreduce(MPI_IN_PLACE,work1,nprocs,MPI_INT,MPI_SUM,world);
+    nrecv_proc = work1[me];
 #else
 #ifdef LAMMPS_RS_ALLREDUCE
-  MPI_Allreduce(work1,work2,nprocs,MPI_INT,MPI_SUM,world);
-  nrecv_proc = work2[me];
+    MPI_Allreduce(work1,work2,nprocs,MPI_INT,MPI_SUM,world);
+    nrecv_proc = work2[me];
 #else
-  MPI_Reduce_scatter(work1,&nrecv_proc,work2,MPI_INT,MPI_SUM,world);
+    MPI_Reduce_scatter(work1,&nrecv_proc,work2,MPI_INT,MPI_SUM,world);
 #endif
 #endif
 
-  // allocate receive arrays
+    // allocate receive arrays
 
-  proc_recv = new int[nrecv_proc];
-  num_recv = new int[nrecv_proc];
-  request = new MPI_Request[nrecv_proc];
-  status = new MPI_Status[nrecv_proc];
+    proc_recv = new int[nrecv_proc];
+    num_recv = new int[nrecv_proc];
+    request = new MPI_Request[nrecv_proc];
+    status = new MPI_Status[nrecv_proc];
+  }
 
   // work1 = # of datums I send to each proc, including self
   // nsend_proc = # of procs I send messages to, not including self
@@ -855,11 +888,16 @@ int Irregular::create_data_grouped(int n, int *procs, int sortflag)
   // sendmax_proc = largest # of datums I send in a single message
 
   sendmax_proc = 0;
-  for (i = 0; i < nsend_proc; i++) {
-    MPI_Request tmpReq; // Use non-blocking send to avoid possible deadlock
-    MPI_Isend(&num_send[i],1,MPI_INT,proc_send[i],0,world,&tmpReq);
-    MPI_Request_free(&tmpReq); // the MPI_Barrier below marks completion
+  for (i = 0; i < nsend_proc; i++)
     sendmax_proc = MAX(sendmax_proc,num_send[i]);
+
+  if (nbxflag) sparse_counts(num_send,num_recv);
+  else {
+    for (i = 0; i < nsend_proc; i++) {
+      MPI_Request tmpReq; // Use non-blocking send to avoid possible deadlock
+      MPI_Isend(&num_send[i],1,MPI_INT,proc_send[i],0,world,&tmpReq);
+      MPI_Request_free(&tmpReq); // the MPI_Barrier below marks completion
+    }
   }
 
   // receive incoming messages
@@ -869,8 +907,10 @@ int Irregular::create_data_grouped(int n, int *procs, int sortflag)
 
   int nrecvdatum = 0;
   for (i = 0; i < nrecv_proc; i++) {
-    MPI_Recv(&num_recv[i],1,MPI_INT,MPI_ANY_SOURCE,0,world,status);
-    proc_recv[i] = status->MPI_SOURCE;
+    if (!nbxflag) {
+      MPI_Recv(&num_recv[i],1,MPI_INT,MPI_ANY_SOURCE,0,world,status);
+      proc_recv[i] = status->MPI_SOURCE;
+    }
     nrecvdatum += num_recv[i];
   }
   nrecvdatum += num_self;
@@ -907,14 +947,80 @@ int Irregular::create_data_grouped(int n, int *procs, int sortflag)
 
   // barrier to insure all MPI_ANY_SOURCE messages are received
   // else another proc could proceed to exchange_data() and send to me
+  // not needed for NBX, its non-blocking barrier already insured that
 
-  MPI_Barrier(world);
+  if (!nbxflag) MPI_Barrier(world);
 
   // return # of datums I will receive
 
   return nrecvdatum;
 }
 
+/* ----------------------------------------------------------------------
+   sparse exchange of one int with each proc I send to via NBX algorithm
+     (Hoefler, Siebert, Lumsdaine, PPoPP 2010)
+   synchronous sends complete only when received,
+     once mine are done, enter non-blocking barrier and keep receiving
+     barrier completes when all sends of all procs have been received
+   cost scales with # of messages, not with # of procs
+   counts = values to send to each of nsend_proc procs in proc_send
+   allocates proc_recv, recvcounts, request, status for nrecv_proc messages
+   return nrecv_proc
+------------------------------------------------------------------------- */
+
+int Irregular::sparse_counts(int *counts, int *&recvcounts)
+{
+  // alternate between 2 tags, a proc can be at most one exchange ahead
+  // since it cannot leave the next barrier before I enter it
+  // parity is kept in Comm, since the next exchange may use another Irregular
+
+  const int tag = NBXTAG + comm->nbx_parity;
+  comm->nbx_parity = 1 - comm->nbx_parity;
+
+  auto sendreq = new MPI_Request[nsend_proc];
+  for (int i = 0; i < nsend_proc; i++)
+    MPI_Issend(&counts[i],1,MPI_INT,proc_send[i],tag,world,&sendreq[i]);
+
+  std::vector<int> procs,values;
+  MPI_Request barrier;
+  MPI_Status probe;
+  int flag,value;
+  int inbarrier = 0;
+  int done = 0;
+
+  while (!done) {
+    MPI_Iprobe(MPI_ANY_SOURCE,tag,world,&flag,&probe);
+    if (flag) {
+      MPI_Recv(&value,1,MPI_INT,probe.MPI_SOURCE,tag,world,MPI_STATUS_IGNORE);
+      procs.push_back(probe.MPI_SOURCE);
+      values.push_back(value);
+    }
+    if (inbarrier) MPI_Test(&barrier,&done,MPI_STATUS_IGNORE);
+    else {
+      MPI_Testall(nsend_proc,sendreq,&flag,MPI_STATUSES_IGNORE);
+      if (flag) {
+        MPI_Ibarrier(world,&barrier);
+        inbarrier = 1;
+      }
+    }
+  }
+
+  delete[] sendreq;
+
+  nrecv_proc = procs.size();
+  proc_recv = new int[nrecv_proc];
+  recvcounts = new int[nrecv_proc];
+  request = new MPI_Request[nrecv_proc];
+  status = new MPI_Status[nrecv_proc];
+
+  for (int i = 0; i < nrecv_proc; i++) {
+    proc_recv[i] = procs[i];
+    recvcounts[i] = values[i];
+  }
+
+  return nrecv_proc;
+}
+
 /* ----------------------------------------------------------------------
    communicate datums via PlanData
    sendbuf = list of datums to send
@@ -26,6 +26,16 @@ class Irregular : protected Pointers {
   static int *proc_recv_copy;
 #endif
 
+  // default procs needed to use sparse NBX exchange of message counts
+  // instead of ReduceScatter, or Alltoall in Comm::rendezvous()
+  // can be changed at run time via comm_modify nbx
+
+#if defined(LAMMPS_NBX_MINPROCS)
+  static constexpr int NBX_MINPROCS = LAMMPS_NBX_MINPROCS;
+#else
+  static constexpr int NBX_MINPROCS = 1024;
+#endif
+
   Irregular(class LAMMPS *);
   ~Irregular() override;
   void migrate_atoms(int sortflag = 0, int preassign = 0, int *procassign = nullptr);
@@ -88,6 +98,7 @@ class Irregular : protected Pointers {
   void exchange_atom(double *, int *, double *);
   void destroy_atom();
 
+  int sparse_counts(int *, int *&);
   int binary(double, int, double *);
 
   void init_exchange();        // reset bufxtra
@@ -23,6 +23,7 @@
 #include "memory.h"
 #include "pair.h"
 #include "suffix.h"
+#include "update.h"
 
 #include <cmath>
 #include <cstring>
@@ -60,6 +61,9 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
 #else
   collective_flag = 0;
 #endif
+  pipeline = 0;
+  concurrent_flag = 0;
+  interval = 1;
 
   kewaldflag = 0;
 
@@ -91,6 +95,10 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   maxeatom = maxvatom = 0;
   eatom = nullptr;
   vatom = nullptr;
+
+  tile_order = tile_start = nullptr;
+  ntile_y = ntile_z = 0;
+  maxtile_order = maxtile_start = 0;
   centroidstressflag = CENTROID_NOTAVAIL;
 
   execution_space = Host;
@@ -158,6 +166,8 @@ KSpace::~KSpace()
   memory->destroy(vatom);
   memory->destroy(gcons);
   memory->destroy(dgcons);
+  memory->destroy(tile_order);
+  memory->destroy(tile_start);
 }
 
 /* ----------------------------------------------------------------------
@@ -186,6 +196,43 @@ void KSpace::compute_dummy(int eflag, int vflag)
   ev_init(eflag,vflag);
 }
 
+/* ----------------------------------------------------------------------
+   multiple time step KSpace for kspace_modify interval N > 1
+   solve only on every Nth step of a run, starting with its setup,
+     and scale those forces by N, so the two velocity Verlet half kicks
+     around a solve give the impulse N*dt*f of an rRESPA outer level
+   global energy and virial are always tallied when solving
+     and kept in between, so thermo output and barostats see unscaled values
+   per-atom energy and virial are zero on steps without a solve
+------------------------------------------------------------------------- */
+
+void KSpace::compute_interval(int eflag, int vflag)
+{
+  if ((update->ntimestep - update->firststep) % interval) {
+    ev_init(eflag & ENERGY_ATOM, vflag & VIRIAL_ATOM);
+    return;
+  }
+
+  // Coulomb prefactor scales forces of all solvers without dispersion
+
+  const double scale_one = scale;
+  scale *= interval;
+  compute(eflag | ENERGY_GLOBAL, vflag | VIRIAL_PAIR);
+  scale = scale_one;
+
+  const double iinv = 1.0/interval;
+  energy *= iinv;
+  for (int i = 0; i < 6; i++) virial[i] *= iinv;
+
+  int n = atom->nlocal;
+  if (tip4pflag) n += atom->nghost;
+  if (eflag_atom)
+    for (int i = 0; i < n; i++) eatom[i] *= iinv;
+  if (vflag_atom)
+    for (int i = 0; i < n; i++)
+      for (int j = 0; j < 6; j++) vatom[i][j] *= iinv;
+}
+
 /* ----------------------------------------------------------------------
    check that pair style is compatible with long-range solver
 ------------------------------------------------------------------------- */
@@ -288,6 +335,57 @@ void KSpace::ev_setup(int eflag, int vflag, int alloc)
   }
 }
 
+/* ----------------------------------------------------------------------
+   sort my particles by the tile of grid rows their stencils reach
+   p2g = global coords of "lower left" stencil pt of each particle,
+     stencil must fit in the (nylo:nyhi,nzlo:nzhi) extent of the brick
+   counting sort is stable, so particles in a tile keep their local order
+   spreading and interpolation in tile order then sweeps the grid brick
+     row by row and threads can work on tiles of one color without locks
+------------------------------------------------------------------------- */
+
+void KSpace::tile_sort(int **p2g, int nlow, int nup,
+                       int nylo, int nyhi, int nzlo, int nzhi)
+{
+  int i,t;
+
+  const int nlocal = atom->nlocal;
+  const int width = nup - nlow + 1;
+  const int ylo = nylo - nlow;
+  const int zlo = nzlo - nlow;
+
+  ntile_y = MAX(nyhi - nup - ylo,0) / width + 1;
+  ntile_z = MAX(nzhi - nup - zlo,0) / width + 1;
+  const int ntile = ntile_y * ntile_z;
+
+  if (ntile+1 > maxtile_start) {
+    maxtile_start = ntile+1;
+    memory->destroy(tile_start);
+    memory->create(tile_start,maxtile_start,"kspace:tile_start");
+  }
+  if (atom->nmax > maxtile_order) {
+    maxtile_order = atom->nmax;
+    memory->destroy(tile_order);
+    memory->create(tile_order,maxtile_order,"kspace:tile_order");
+  }
+
+  // count particles per tile, convert counts to offsets, then fill
+  // filling advances each offset to the start of the next tile
+
+  for (t = 0; t <= ntile; t++) tile_start[t] = 0;
+  for (i = 0; i < nlocal; i++) {
+    t = (p2g[i][2]-zlo) / width * ntile_y + (p2g[i][1]-ylo) / width;
+    tile_start[t+1]++;
+  }
+  for (t = 0; t < ntile; t++) tile_start[t+1] += tile_start[t];
+  for (i = 0; i < nlocal; i++) {
+    t = (p2g[i][2]-zlo) / width * ntile_y + (p2g[i][1]-ylo) / width;
+    tile_order[tile_start[t]++] = i;
+  }
+  for (t = ntile; t > 0; t--) tile_start[t] = tile_start[t-1];
+  tile_start[0] = 0;
+}
+
 /* ----------------------------------------------------------------------
    compute qsum,qsqsum,q2 and give error/warning if not charge neutral
    called initially, when particle count changes, when charges are changed
@@ -574,6 +672,20 @@ void KSpace::modify_params(int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       collective_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"pipeline") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      pipeline = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (pipeline < 0) error->all(FLERR,"Illegal kspace_modify pipeline value: {}",arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"concurrent") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      concurrent_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"interval") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      interval = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (interval < 1) error->all(FLERR,"Illegal kspace_modify interval value: {}",arg[iarg+1]);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"diff") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       if (strcmp(arg[iarg+1],"ad") == 0) differentiation_flag = 1;
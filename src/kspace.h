@@ -29,6 +29,7 @@ namespace LAMMPS_NS {
 class KSpace : protected Pointers {
   friend class ThrOMP;
   friend class FixOMP;
+  friend class KSpaceConcurrent;
 
  public:
   double energy;    // accumulated energies
@@ -96,6 +97,9 @@ class KSpace : protected Pointers {
   int compute_flag;       // 0 if skip compute()
   int fftbench;           // 0 if skip FFT timing
   int collective_flag;    // 1 if use MPI collectives for FFT/remap
+  int pipeline;           // # of chunks to overlap FFT remaps with 1d FFTs, 0 = off
+  int concurrent_flag;    // 1 if solved on 2nd partition concurrently with Rspace
+  int interval;           // solve every this many steps of a run, 1 = every step
   int stagger_flag;       // 1 if using staggered PPPM grids
 
   double splittol;    // tolerance for when to truncate splitting
@@ -107,6 +111,7 @@ class KSpace : protected Pointers {
   void modify_params(int, char **);
   void *extract(const char *);
   void compute_dummy(int, int);
+  void compute_interval(int, int);
 
   // triclinic
 
@@ -204,6 +209,14 @@ class KSpace : protected Pointers {
   int kewaldflag;                      // 1 if kspace range set for Ewald sum
   int kx_ewald, ky_ewald, kz_ewald;    // kspace settings for Ewald sum
 
+  // local particles sorted by tiles of the grid their stencils spread to
+  // tiles are one stencil wide in y and z, so only adjacent tiles overlap
+
+  int *tile_order;               // indices of local particles, sorted by tile
+  int *tile_start;               // 1st entry of each tile in tile_order, x fastest
+  int ntile_y, ntile_z;          // # of tiles in y and z
+  int maxtile_order, maxtile_start;
+
   void pair_check();
   void ev_init(int eflag, int vflag, int alloc = 1)
   {
@@ -215,6 +228,20 @@ class KSpace : protected Pointers {
   }
   void ev_setup(int, int, int alloc = 1);
   double estimate_table_accuracy(double, double);
+  void tile_sort(int **, int, int, int, int, int, int);
+
+  // tiles whose index in y and z has the same parity as (color & 1, color >> 1)
+  //   are at least one tile apart, so their stencils can be spread concurrently
+
+  int ntile_color(int color) const
+  {
+    return ((ntile_y - (color & 1) + 1) / 2) * ((ntile_z - (color >> 1) + 1) / 2);
+  }
+  int tile_color(int color, int k) const
+  {
+    const int ny = (ntile_y - (color & 1) + 1) / 2;
+    return (2 * (k / ny) + (color >> 1)) * ntile_y + 2 * (k % ny) + (color & 1);
+  }
 };
 
 }    // namespace LAMMPS_NS
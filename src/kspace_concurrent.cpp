@@ -0,0 +1,534 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "kspace_concurrent.h"
+
+#include "atom.h"
+#include "atom_vec.h"
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "fix.h"
+#include "force.h"
+#include "kspace.h"
+#include "modify.h"
+#include "neighbor.h"
+#include "timer.h"
+#include "universe.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+using namespace LAMMPS_NS;
+
+enum { STOP, COMPUTE };
+enum { COUNT_TAG, ATOM_TAG, FORCE_TAG };
+
+/* ----------------------------------------------------------------------
+   interface between the 2 partitions of a run with kspace_modify concurrent
+   partition 1 (Rspace) integrates and computes all forces except KSpace
+   partition 2 (KSpace) only computes KSpace forces of the Rspace atoms
+   owned atoms are routed to the KSpace proc whose sub-domain contains them,
+     so any Rspace decomposition works and KSpace sees a brick decomposition
+   both partitions must have been set up by the same input script
+------------------------------------------------------------------------- */
+
+KSpaceConcurrent::KSpaceConcurrent(LAMMPS *lmp) :
+    Pointers(lmp), lastroute(-1), fix_omp(nullptr), nsend(0), nrecv(0),
+    time_start(0.0), time_rspace(0.0), time_wait(0.0), time_kspace(0.0), time_idle(0.0),
+    ncompute(0)
+{
+  if (universe->nworlds != 2)
+    error->universe_all(FLERR, "Kspace_modify concurrent requires exactly 2 partitions");
+  if (force->kspace->tip4pflag)
+    error->universe_all(FLERR, "Kspace_modify concurrent does not support TIP4P");
+
+  MPI_Comm_rank(universe->uworld, &me);
+  MPI_Comm_size(universe->uworld, &nprocs);
+  rspace = (universe->iworld == 0) ? 1 : 0;
+  rroot = universe->root_proc[0];
+  kroot = universe->root_proc[1];
+  nkspace = universe->procs_per_world[1];
+
+  // KSpace partition has no ghost atoms, so it can only use a brick layout
+
+  int flag = 0;
+  if (!rspace && comm->style != 0) flag = 1;
+  MPI_Bcast(&flag, 1, MPI_INT, kroot, universe->uworld);
+  if (flag)
+    error->universe_all(FLERR,
+                        "Kspace_modify concurrent requires comm_style brick on KSpace partition");
+
+  // Rspace procs need the KSpace decomposition to route atoms
+  // world ranks of a partition are contiguous universe ranks starting at its root
+
+  if (!rspace) {
+    for (int i = 0; i < 3; i++) procgrid[i] = comm->procgrid[i];
+  }
+  MPI_Bcast(procgrid, 3, MPI_INT, kroot, universe->uworld);
+
+  xsplit.resize(procgrid[0] + 1);
+  ysplit.resize(procgrid[1] + 1);
+  zsplit.resize(procgrid[2] + 1);
+  grid2proc.resize(nkspace);
+  if (!rspace) {
+    std::copy(comm->xsplit, comm->xsplit + procgrid[0] + 1, xsplit.begin());
+    std::copy(comm->ysplit, comm->ysplit + procgrid[1] + 1, ysplit.begin());
+    std::copy(comm->zsplit, comm->zsplit + procgrid[2] + 1, zsplit.begin());
+    for (int k = 0; k < procgrid[2]; k++)
+      for (int j = 0; j < procgrid[1]; j++)
+        for (int i = 0; i < procgrid[0]; i++)
+          grid2proc[(k * procgrid[1] + j) * procgrid[0] + i] = kroot + comm->grid2proc[i][j][k];
+  }
+  MPI_Bcast(xsplit.data(), procgrid[0] + 1, MPI_DOUBLE, kroot, universe->uworld);
+  MPI_Bcast(ysplit.data(), procgrid[1] + 1, MPI_DOUBLE, kroot, universe->uworld);
+  MPI_Bcast(zsplit.data(), procgrid[2] + 1, MPI_DOUBLE, kroot, universe->uworld);
+  MPI_Bcast(grid2proc.data(), nkspace, MPI_INT, kroot, universe->uworld);
+
+  // per-atom data sent each request: x, charge, dipole, type
+
+  qflag = atom->q_flag;
+  muflag = atom->mu_flag;
+  size_one = 3 + qflag + 4 * muflag + 1;
+
+  // FixOMP clears and reduces per-thread forces on KSpace partition
+
+  if (!rspace) fix_omp = modify->get_fix_by_id("package_omp");
+}
+
+/* ----------------------------------------------------------------------
+   Rspace: send request and atom data to KSpace partition
+   setupflag = 1 forces routing of atoms and update of box on KSpace side
+   returns right away, so the caller can compute other forces meanwhile
+------------------------------------------------------------------------- */
+
+void KSpaceConcurrent::compute_start(int eflag_caller, int vflag_caller, int setupflag)
+{
+  eflag = eflag_caller;
+  vflag = vflag_caller;
+  set_size_reverse();
+
+  header[0] = COMPUTE;
+  header[1] = eflag;
+  header[2] = vflag;
+  header[3] = (setupflag || neighbor->lastcall != lastroute) ? 1 : 0;
+  header[4] = (setupflag || domain->box_change) ? 1 : 0;
+  MPI_Bcast(header, 5, MPI_INT, rroot, universe->uworld);
+
+  if (header[4]) sync_box();
+  if (header[3]) {
+    route();
+    lastroute = neighbor->lastcall;
+  }
+
+  // pack atoms in order of destination proc
+
+  double **x = atom->x;
+  double *q = atom->q;
+  double **mu = atom->mu;
+  int *type = atom->type;
+
+  const int n = sendlist.size();
+  buf_send.resize((size_t) n * size_one);
+  buf_force.resize((size_t) n * size_reverse);
+
+  int m = 0;
+  for (int i = 0; i < n; i++) {
+    const int j = sendlist[i];
+    buf_send[m++] = x[j][0];
+    buf_send[m++] = x[j][1];
+    buf_send[m++] = x[j][2];
+    if (qflag) buf_send[m++] = q[j];
+    if (muflag) {
+      buf_send[m++] = mu[j][0];
+      buf_send[m++] = mu[j][1];
+      buf_send[m++] = mu[j][2];
+      buf_send[m++] = mu[j][3];
+    }
+    buf_send[m++] = ubuf(type[j]).d;
+  }
+
+  // post receives for KSpace forces before sending atoms
+
+  request.resize(nsend);
+  request_force.resize(nsend);
+  int offset = 0;
+  for (int k = 0; k < nsend; k++) {
+    MPI_Irecv(&buf_force[(size_t) offset * size_reverse], num_send[k] * size_reverse, MPI_DOUBLE,
+              proc_send[k], FORCE_TAG, universe->uworld, &request_force[k]);
+    offset += num_send[k];
+  }
+  offset = 0;
+  for (int k = 0; k < nsend; k++) {
+    MPI_Isend(&buf_send[(size_t) offset * size_one], num_send[k] * size_one, MPI_DOUBLE,
+              proc_send[k], ATOM_TAG, universe->uworld, &request[k]);
+    offset += num_send[k];
+  }
+
+  time_start = platform::walltime();
+}
+
+/* ----------------------------------------------------------------------
+   Rspace: wait for KSpace forces of my atoms and add them to f
+   also acquire global and per-atom KSpace energy and virial if requested
+------------------------------------------------------------------------- */
+
+void KSpaceConcurrent::compute_finish()
+{
+  double time = platform::walltime();
+  time_rspace += time - time_start;
+
+  MPI_Waitall(nsend, request.data(), MPI_STATUSES_IGNORE);
+  MPI_Waitall(nsend, request_force.data(), MPI_STATUSES_IGNORE);
+
+  // allocate and zero per-atom arrays of the local KSpace instance
+
+  KSpace *kspace = force->kspace;
+  kspace->ev_init(eflag, vflag);
+
+  if (eflag_global || vflag_global) {
+    double ev[7];
+    MPI_Bcast(ev, 7, MPI_DOUBLE, kroot, universe->uworld);
+    if (eflag_global) kspace->energy = ev[0];
+    if (vflag_global)
+      for (int i = 0; i < 6; i++) kspace->virial[i] = ev[i + 1];
+  }
+
+  double **f = atom->f;
+  const int n = sendlist.size();
+  int m = 0;
+  for (int i = 0; i < n; i++) {
+    const int j = sendlist[i];
+    f[j][0] += buf_force[m++];
+    f[j][1] += buf_force[m++];
+    f[j][2] += buf_force[m++];
+    if (eflag_atom) kspace->eatom[j] = buf_force[m++];
+    if (vflag_atom)
+      for (int k = 0; k < 6; k++) kspace->vatom[j][k] = buf_force[m++];
+  }
+
+  time_wait += platform::walltime() - time;
+  ncompute++;
+}
+
+/* ----------------------------------------------------------------------
+   Rspace: tell KSpace partition that no more requests follow
+------------------------------------------------------------------------- */
+
+void KSpaceConcurrent::stop()
+{
+  header[0] = STOP;
+  MPI_Bcast(header, 5, MPI_INT, rroot, universe->uworld);
+}
+
+/* ----------------------------------------------------------------------
+   KSpace: compute KSpace forces of the Rspace atoms until stop() is called
+------------------------------------------------------------------------- */
+
+void KSpaceConcurrent::serve()
+{
+  timer->stamp();
+
+  while (true) {
+    double time = platform::walltime();
+    MPI_Bcast(header, 5, MPI_INT, rroot, universe->uworld);
+    if (header[0] == STOP) {
+      time_idle += platform::walltime() - time;
+      break;
+    }
+    eflag = header[1];
+    vflag = header[2];
+    set_size_reverse();
+
+    if (header[4]) sync_box();
+    if (header[3]) route();
+
+    // receive atoms from each Rspace proc into contiguous chunks
+
+    const int nlocal = atom->nlocal;
+    buf_recv.resize((size_t) nlocal * size_one);
+    request.resize(nrecv);
+    int offset = 0;
+    for (int k = 0; k < nrecv; k++) {
+      MPI_Irecv(&buf_recv[(size_t) offset * size_one], num_recv[k] * size_one, MPI_DOUBLE,
+                proc_recv[k], ATOM_TAG, universe->uworld, &request[k]);
+      offset += num_recv[k];
+    }
+    MPI_Waitall(nrecv, request.data(), MPI_STATUSES_IGNORE);
+    timer->stamp(Timer::COMM);
+
+    double timecompute = platform::walltime();
+    time_idle += timecompute - time;
+
+    double **x = atom->x;
+    double *q = atom->q;
+    double **mu = atom->mu;
+    int *type = atom->type;
+
+    int m = 0;
+    for (int i = 0; i < nlocal; i++) {
+      x[i][0] = buf_recv[m++];
+      x[i][1] = buf_recv[m++];
+      x[i][2] = buf_recv[m++];
+      if (qflag) q[i] = buf_recv[m++];
+      if (muflag) {
+        mu[i][0] = buf_recv[m++];
+        mu[i][1] = buf_recv[m++];
+        mu[i][2] = buf_recv[m++];
+        mu[i][3] = buf_recv[m++];
+      }
+      type[i] = (int) ubuf(buf_recv[m++]).i;
+    }
+
+    if (nlocal) memset(&atom->f[0][0], 0, sizeof(double) * 3 * nlocal);
+    if (fix_omp) fix_omp->pre_force(vflag);
+    force->kspace->compute(eflag, vflag);
+    timer->stamp(Timer::KSPACE);
+
+    // return forces and per-atom tallies in the order the atoms were received
+
+    double **f = atom->f;
+    double *eatom = force->kspace->eatom;
+    double **vatom = force->kspace->vatom;
+    buf_force.resize((size_t) nlocal * size_reverse);
+
+    m = 0;
+    for (int i = 0; i < nlocal; i++) {
+      buf_force[m++] = f[i][0];
+      buf_force[m++] = f[i][1];
+      buf_force[m++] = f[i][2];
+      if (eflag_atom) buf_force[m++] = eatom[i];
+      if (vflag_atom)
+        for (int k = 0; k < 6; k++) buf_force[m++] = vatom[i][k];
+    }
+
+    offset = 0;
+    for (int k = 0; k < nrecv; k++) {
+      MPI_Isend(&buf_force[(size_t) offset * size_reverse], num_recv[k] * size_reverse,
+                MPI_DOUBLE, proc_recv[k], FORCE_TAG, universe->uworld, &request[k]);
+      offset += num_recv[k];
+    }
+    MPI_Waitall(nrecv, request.data(), MPI_STATUSES_IGNORE);
+
+    if (eflag_global || vflag_global) {
+      double ev[7];
+      ev[0] = force->kspace->energy;
+      for (int i = 0; i < 6; i++) ev[i + 1] = force->kspace->virial[i];
+      MPI_Bcast(ev, 7, MPI_DOUBLE, kroot, universe->uworld);
+    }
+    timer->stamp(Timer::COMM);
+
+    time_kspace += platform::walltime() - timecompute;
+    ncompute++;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   both: set which energy/virial tallies are returned for current request
+   uses the same flag bits as KSpace::ev_setup()
+------------------------------------------------------------------------- */
+
+void KSpaceConcurrent::set_size_reverse()
+{
+  eflag_global = eflag & ENERGY_GLOBAL;
+  eflag_atom = eflag & ENERGY_ATOM;
+  vflag_global = vflag & (VIRIAL_PAIR | VIRIAL_FDOTR);
+  vflag_atom = vflag & VIRIAL_ATOM;
+  size_reverse = 3 + (eflag_atom ? 1 : 0) + (vflag_atom ? 6 : 0);
+}
+
+/* ----------------------------------------------------------------------
+   print time per request of both partitions to universe screen and logfile
+   suggest a split of procs that balances the Rspace work that overlaps
+     the KSpace solve with the KSpace solve, assuming both parts of the
+     calculation scale linearly with their # of procs
+   the split can only be changed with the -partition command-line switch
+------------------------------------------------------------------------- */
+
+void KSpaceConcurrent::report()
+{
+  double mytime[4], alltime[4];
+  mytime[0] = time_rspace;
+  mytime[1] = time_wait;
+  mytime[2] = time_kspace;
+  mytime[3] = time_idle;
+  MPI_Reduce(mytime, alltime, 4, MPI_DOUBLE, MPI_SUM, 0, universe->uworld);
+
+  if ((me == 0) && ncompute) {
+    const int nrspace = nprocs - nkspace;
+    const double trspace = alltime[0] / nrspace / ncompute;
+    const double twait = alltime[1] / nrspace / ncompute;
+    const double tkspace = alltime[2] / nkspace / ncompute;
+    const double tidle = alltime[3] / nkspace / ncompute;
+
+    const double wrspace = trspace * nrspace;
+    const double wkspace = tkspace * nkspace;
+    int nsuggest = nkspace;
+    if (wrspace + wkspace > 0.0)
+      nsuggest = static_cast<int>(nprocs * wkspace / (wrspace + wkspace) + 0.5);
+    nsuggest = MAX(nsuggest, 1);
+    nsuggest = MIN(nsuggest, nprocs - 1);
+
+    auto mesg = fmt::format("KSpace concurrent: {} requests, per request: Rspace {:.4g} secs, "
+                            "Rspace wait {:.4g} secs, KSpace {:.4g} secs, KSpace idle {:.4g} secs\n",
+                            ncompute, trspace, twait, tkspace, tidle);
+    mesg += fmt::format("KSpace concurrent: suggested split of {} procs: -partition {} {}\n",
+                        nprocs, nprocs - nsuggest, nsuggest);
+    if (universe->uscreen) fputs(mesg.c_str(), universe->uscreen);
+    if (universe->ulogfile) fputs(mesg.c_str(), universe->ulogfile);
+  }
+
+  time_rspace = time_wait = time_kspace = time_idle = 0.0;
+  ncompute = 0;
+}
+
+/* ----------------------------------------------------------------------
+   Rspace: universe rank of KSpace proc whose sub-domain contains x
+------------------------------------------------------------------------- */
+
+int KSpaceConcurrent::kspace_proc(double *x)
+{
+  double lamda[3];
+  if (domain->triclinic) domain->x2lamda(x, lamda);
+  else {
+    for (int i = 0; i < 3; i++) lamda[i] = (x[i] - domain->boxlo[i]) / domain->prd[i];
+  }
+
+  int igx = utils::binary_search(lamda[0], procgrid[0], xsplit.data());
+  int igy = utils::binary_search(lamda[1], procgrid[1], ysplit.data());
+  int igz = utils::binary_search(lamda[2], procgrid[2], zsplit.data());
+
+  igx = MAX(igx, 0);
+  igx = MIN(igx, procgrid[0] - 1);
+  igy = MAX(igy, 0);
+  igy = MIN(igy, procgrid[1] - 1);
+  igz = MAX(igz, 0);
+  igz = MIN(igz, procgrid[2] - 1);
+
+  return grid2proc[(igz * procgrid[1] + igy) * procgrid[0] + igx];
+}
+
+/* ----------------------------------------------------------------------
+   both: assign Rspace atoms to KSpace procs after reneighboring
+   Rspace procs build sendlist sorted by destination
+   KSpace procs learn how many atoms arrive from which Rspace proc
+     and resize their atom arrays to hold them, without ghost atoms
+------------------------------------------------------------------------- */
+
+void KSpaceConcurrent::route()
+{
+  std::vector<int> work(nprocs, 0);
+  std::vector<int> proclist;
+
+  if (rspace) {
+    double **x = atom->x;
+    const int nlocal = atom->nlocal;
+    proclist.resize(nlocal);
+    for (int i = 0; i < nlocal; i++) {
+      proclist[i] = kspace_proc(x[i]);
+      work[proclist[i]]++;
+    }
+
+    proc_send.clear();
+    num_send.clear();
+    std::vector<int> first(nprocs, 0);
+    int offset = 0;
+    for (int iproc = kroot; iproc < kroot + nkspace; iproc++) {
+      if (work[iproc] == 0) continue;
+      proc_send.push_back(iproc);
+      num_send.push_back(work[iproc]);
+      first[iproc] = offset;
+      offset += work[iproc];
+    }
+    nsend = proc_send.size();
+
+    sendlist.resize(nlocal);
+    for (int i = 0; i < nlocal; i++) sendlist[first[proclist[i]]++] = i;
+    for (int iproc = 0; iproc < nprocs; iproc++) work[iproc] = work[iproc] ? 1 : 0;
+  }
+
+  // nrecv = # of Rspace procs sending atoms to me
+
+  std::vector<int> counts(nprocs, 1);
+  MPI_Reduce_scatter(work.data(), &nrecv, counts.data(), MPI_INT, MPI_SUM, universe->uworld);
+
+  if (rspace) {
+    for (int k = 0; k < nsend; k++)
+      MPI_Send(&num_send[k], 1, MPI_INT, proc_send[k], COUNT_TAG, universe->uworld);
+    return;
+  }
+
+  std::vector<int> count(nrecv);
+  std::vector<MPI_Status> status(nrecv);
+  request.resize(nrecv);
+  for (int k = 0; k < nrecv; k++)
+    MPI_Irecv(&count[k], 1, MPI_INT, MPI_ANY_SOURCE, COUNT_TAG, universe->uworld, &request[k]);
+  MPI_Waitall(nrecv, request.data(), status.data());
+
+  // order atoms by Rspace proc, so they are summed onto the grid in a reproducible order
+
+  std::vector<std::pair<int, int>> source(nrecv);
+  for (int k = 0; k < nrecv; k++) source[k] = std::make_pair(status[k].MPI_SOURCE, count[k]);
+  std::sort(source.begin(), source.end());
+
+  proc_recv.resize(nrecv);
+  num_recv.resize(nrecv);
+  int nlocal = 0;
+  for (int k = 0; k < nrecv; k++) {
+    proc_recv[k] = source[k].first;
+    num_recv[k] = source[k].second;
+    nlocal += num_recv[k];
+  }
+
+  atom->nlocal = nlocal;
+  while (atom->nmax <= atom->nlocal) atom->avec->grow(0);
+  atom->nghost = 0;
+
+  bigint nblocal = nlocal;
+  MPI_Allreduce(&nblocal, &atom->natoms, 1, MPI_LMP_BIGINT, MPI_SUM, world);
+}
+
+/* ----------------------------------------------------------------------
+   both: copy box of Rspace partition to KSpace partition
+   KSpace solver is set up again for the new box
+------------------------------------------------------------------------- */
+
+void KSpaceConcurrent::sync_box()
+{
+  double box[9];
+  if (rspace) {
+    for (int i = 0; i < 3; i++) {
+      box[i] = domain->boxlo[i];
+      box[3 + i] = domain->boxhi[i];
+    }
+    box[6] = domain->xy;
+    box[7] = domain->xz;
+    box[8] = domain->yz;
+  }
+
+  MPI_Bcast(box, 9, MPI_DOUBLE, rroot, universe->uworld);
+
+  if (!rspace) {
+    for (int i = 0; i < 3; i++) {
+      domain->boxlo[i] = box[i];
+      domain->boxhi[i] = box[3 + i];
+    }
+    domain->xy = box[6];
+    domain->xz = box[7];
+    domain->yz = box[8];
+    domain->set_global_box();
+    domain->set_local_box();
+    force->kspace->setup();
+  }
+}
@@ -0,0 +1,88 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_KSPACE_CONCURRENT_H
+#define LMP_KSPACE_CONCURRENT_H
+
+#include "pointers.h"
+
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class KSpaceConcurrent : protected Pointers {
+ public:
+  int rspace;    // 1 for procs of the real-space partition, 0 for KSpace partition
+
+  KSpaceConcurrent(class LAMMPS *);
+
+  void compute_start(int, int, int);    // Rspace: send coords, start KSpace solve
+  void compute_finish();                // Rspace: wait for and add KSpace forces
+  void stop();                          // Rspace: end serve() on KSpace partition
+  void serve();                         // KSpace: compute requests until stop()
+  void report();                        // both: print timings and suggested split
+
+ private:
+  int me, nprocs;           // my rank and # of procs in universe
+  int rroot, kroot;         // universe rank of first proc in each partition
+  int nkspace;              // # of procs in KSpace partition
+  int header[5];            // request from Rspace to KSpace partition
+  int eflag, vflag;         // energy/virial flags of current request
+  int eflag_global, eflag_atom, vflag_global, vflag_atom;
+  int size_one;             // # of doubles per atom sent to KSpace partition
+  int size_reverse;         // # of doubles per atom returned to Rspace partition
+  int qflag, muflag;        // 1 if charges, dipoles are sent
+  bigint lastroute;         // timestep of neighbor list build when atoms were routed
+  class Fix *fix_omp;       // FixOMP on KSpace partition, if defined
+
+  // brick decomposition of KSpace partition
+
+  int procgrid[3];
+  std::vector<double> xsplit, ysplit, zsplit;
+  std::vector<int> grid2proc;    // universe rank of each KSpace proc, x fastest
+
+  // Rspace side of the exchange
+
+  int nsend;                         // # of KSpace procs I send atoms to
+  std::vector<int> proc_send;        // universe rank of each KSpace proc I send to
+  std::vector<int> num_send;         // # of atoms sent to each KSpace proc
+  std::vector<int> sendlist;         // local index of each sent atom, by destination
+  std::vector<double> buf_send;      // packed atom data
+  std::vector<double> buf_force;     // KSpace forces and per-atom tallies of sent atoms
+
+  // KSpace side of the exchange
+
+  int nrecv;                         // # of Rspace procs I receive atoms from
+  std::vector<int> proc_recv;        // universe rank of each Rspace proc
+  std::vector<int> num_recv;         // # of atoms received from each Rspace proc
+  std::vector<double> buf_recv;      // packed atom data
+
+  std::vector<MPI_Request> request;
+  std::vector<MPI_Request> request_force;
+
+  // timings to estimate the best split of procs between partitions
+
+  double time_start;                 // Rspace: wall time of last compute_start()
+  double time_rspace, time_wait;     // Rspace: time working and waiting for forces
+  double time_kspace, time_idle;     // KSpace: time computing and waiting for requests
+  int ncompute;                      // # of requests in this run
+
+  int kspace_proc(double *);
+  void route();
+  void sync_box();
+  void set_size_reverse();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
@@ -0,0 +1,31 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+// clang-format off
+#ifndef LMP_DATABIN_H
+#define LMP_DATABIN_H
+
+// binary sections of data files, written by write_data and read by read_data
+// a binary section follows the section keyword line and a blank line:
+//   DATABIN_MAGIC (16 bytes incl. terminating null), int endian flag,
+//   int format revision, bigint # of rows, int # of columns,
+//   one int type per column, then all values column by column
+// every value has 8 bytes, either a double or a 64-bit integer
+
+#define DATABIN_MAGIC "LammpS BinDatA"
+#define DATABIN_MAGIC_SIZE 16
+#define DATABIN_ENDIAN 0x0001
+#define DATABIN_REVISION 1
+
+enum{DATABIN_DOUBLE,DATABIN_INT};
+
+#endif
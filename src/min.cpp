@@ -117,6 +117,8 @@ void Min::init()
   if (lmp->kokkos && !kokkosable)
     error->all(FLERR,"Must use a Kokkos-enabled min style "
                "(e.g. min_style cg/kk) with Kokkos minimize");
+  if (force->kspace && force->kspace->concurrent_flag)
+    error->universe_all(FLERR,"Kspace_modify concurrent is not supported by minimization");
 
   // create fix needed for storing atom-based quantities
   // will delete it at end of run
@@ -110,6 +110,7 @@ void NBin::copy_neighbor_info()
   cutneighmax = neighbor->cutneighmax;
   binsizeflag = neighbor->binsizeflag;
   binsize_user = neighbor->binsize_user;
+  clustersize = neighbor->clustersize;
   bboxlo = neighbor->bboxlo;
   bboxhi = neighbor->bboxhi;
 
@@ -71,6 +71,7 @@ class NBin : protected Pointers {
   double cutneighmax;
   int binsizeflag;
   double binsize_user;
+  int clustersize;
   double *bboxlo, *bboxhi;
   int ncollections;
   double **cutcollectionsq;
@@ -116,11 +116,14 @@ void NBinStandard::setup_bins(int style)
 
   // optimal bin size is roughly 1/2 the cutoff
   // for BIN style, binsize = 1/2 of max neighbor cutoff
+  // for BIN style with cluster pair lists, binsize = max neighbor cutoff
+  //   so that each bin holds enough atoms to fill several clusters
   // for MULTI_OLD style, binsize = 1/2 of min neighbor cutoff
   // special case of all cutoffs = 0.0, binsize = box size
 
   double binsize_optimal;
   if (binsizeflag) binsize_optimal = binsize_user;
+  else if (style == Neighbor::BIN && clustersize) binsize_optimal = cutneighmax;
   else if (style == Neighbor::BIN) binsize_optimal = 0.5*cutneighmax;
   else binsize_optimal = 0.5*cutneighmin;
   if (binsize_optimal == 0.0) binsize_optimal = bbox[0];
@@ -24,6 +24,7 @@
 using namespace LAMMPS_NS;
 
 #define PGDELTA 1
+#define BIG 1.0e20
 
 /* ---------------------------------------------------------------------- */
 
@@ -34,6 +35,7 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
   maxatom = 0;
 
   inum = gnum = 0;
+  inum_owned = -1;
   ilist = nullptr;
   numneigh = nullptr;
   firstneigh = nullptr;
@@ -63,6 +65,20 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
 
   ipage = nullptr;
 
+  // cluster pair lists
+
+  cluster = 0;
+  nclocal = ncall = 0;
+  maxcluster = maxcpair = 0;
+  clusteratom = nullptr;
+  clustertype = nullptr;
+  xcluster = nullptr;
+  firstcj = nullptr;
+  numcj = nullptr;
+  cjlist = nullptr;
+  cjmask = nullptr;
+  npair_cluster = 0;
+
   // extra rRESPA lists
 
   inum_inner = gnum_inner = 0;
@@ -118,6 +134,14 @@ NeighList::~NeighList()
     delete [] ipage_middle;
   }
 
+  memory->destroy(clusteratom);
+  memory->destroy(clustertype);
+  memory->destroy(xcluster);
+  memory->destroy(firstcj);
+  memory->destroy(numcj);
+  memory->destroy(cjlist);
+  memory->destroy(cjmask);
+
   delete [] iskip;
   memory->destroy(ijskip);
 }
@@ -245,6 +269,100 @@ void NeighList::grow(int nlocal, int nall)
   }
 }
 
+/* ----------------------------------------------------------------------
+   grow per-cluster data to allow for n clusters of owned and ghost atoms
+   triggered by cluster pair list build
+------------------------------------------------------------------------- */
+
+void NeighList::grow_cluster(int n)
+{
+  if (n <= maxcluster) return;
+  maxcluster = n;
+
+  memory->destroy(clusteratom);
+  memory->destroy(clustertype);
+  memory->destroy(xcluster);
+  memory->destroy(firstcj);
+  memory->destroy(numcj);
+  memory->create(clusteratom,maxcluster*cluster,"neighlist:clusteratom");
+  memory->create(clustertype,maxcluster*cluster,"neighlist:clustertype");
+  memory->create(xcluster,3*maxcluster*cluster,"neighlist:xcluster");
+  memory->create(firstcj,maxcluster,"neighlist:firstcj");
+  memory->create(numcj,maxcluster,"neighlist:numcj");
+}
+
+/* ----------------------------------------------------------------------
+   grow cluster pair data to store at least n cluster pairs
+   preserves existing pairs, since called while building the list
+------------------------------------------------------------------------- */
+
+void NeighList::grow_cluster_pair(int n)
+{
+  if (n <= maxcpair) return;
+  while (maxcpair < n) maxcpair += (maxcpair ? maxcpair/2 : pgsize);
+
+  memory->grow(cjlist,maxcpair,"neighlist:cjlist");
+  memory->grow(cjmask,maxcpair,"neighlist:cjmask");
+}
+
+/* ----------------------------------------------------------------------
+   copy current coords of owned and ghost atoms into cluster order
+   called by pair styles before each cluster pair force computation
+   empty slots are placed far away, they are also masked out of all pairs
+------------------------------------------------------------------------- */
+
+void NeighList::pack_cluster_x()
+{
+  double **x = atom->x;
+  const int cs = cluster;
+
+  for (int c = 0; c < ncall; c++) {
+    const int *catom = &clusteratom[c*cs];
+    double *xc = &xcluster[3*c*cs];
+    for (int k = 0; k < cs; k++) {
+      const int i = catom[k];
+      if (i >= 0) {
+        xc[k] = x[i][0];
+        xc[cs+k] = x[i][1];
+        xc[2*cs+k] = x[i][2];
+      } else {
+        xc[k] = xc[cs+k] = xc[2*cs+k] = BIG;
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   reorder ilist so that I atoms whose J neighbors are all owned atoms
+     come first, in their original order, followed by all other I atoms
+   forces between the first inum_owned atoms and their neighbors
+     can be computed before ghost atom coords are up to date
+------------------------------------------------------------------------- */
+
+void NeighList::split_owned()
+{
+  const int nlocal = atom->nlocal;
+  int *boundary;
+  memory->create(boundary,MAX(inum,1),"neighlist:boundary");
+
+  int n = 0;
+  int nboundary = 0;
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    const int *jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+    int jj;
+    for (jj = 0; jj < jnum; jj++)
+      if ((jlist[jj] & NEIGHMASK) >= nlocal) break;
+    if (jj < jnum) boundary[nboundary++] = i;
+    else ilist[n++] = i;
+  }
+
+  inum_owned = n;
+  for (int ii = 0; ii < nboundary; ii++) ilist[n++] = boundary[ii];
+  memory->destroy(boundary);
+}
+
 /* ----------------------------------------------------------------------
    print attributes of this list and associated request
 ------------------------------------------------------------------------- */
@@ -310,6 +428,14 @@ double NeighList::memory_usage()
       bytes += ipage[i].size();
   }
 
+  if (cluster) {
+    bytes += 2.0*memory->usage(clusteratom,maxcluster*cluster);
+    bytes += memory->usage(xcluster,3*maxcluster*cluster);
+    bytes += 2.0*memory->usage(firstcj,maxcluster);
+    bytes += memory->usage(cjlist,maxcpair);
+    bytes += (double)maxcpair * sizeof(uint64_t);
+  }
+
   if (respainner) {
     bytes += memory->usage(ilist_inner,maxatom);
     bytes += memory->usage(numneigh_inner,maxatom);
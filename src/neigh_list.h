@@ -59,6 +59,11 @@ class NeighList : protected Pointers {
   int oneatom;           // max size for one atom
   MyPage<int> *ipage;    // pages of neighbor indices
 
+  // split of ilist for overlapping forward comm with force computation
+  // owned atoms whose J neighbors are all owned atoms come first in ilist
+
+  int inum_owned;    // # of I atoms with only owned J neighbors, -1 if not split
+
   // data structs to store rRESPA neighbor pairs I,J and associated values
 
   int inum_inner;            // # of I atoms neighbors are stored for
@@ -76,6 +81,25 @@ class NeighList : protected Pointers {
   MyPage<int> *ipage_inner;     // pages of neighbor indices for inner
   MyPage<int> *ipage_middle;    // pages of neighbor indices for middle
 
+  // data structs to store cluster pair lists (neighbor style cluster)
+  // owned and ghost atoms are grouped into clusters of cluster atoms each
+  // each owned cluster CI stores neighbor clusters CJ with a bitmask,
+  //   bit ii*cluster+jj is set if atom pair (ii,jj) is a neighbor pair
+
+  int cluster;              // 0 if regular list, else # of atoms per cluster
+  int nclocal;              // # of clusters of owned atoms
+  int ncall;                // # of clusters of owned and ghost atoms
+  int maxcluster;           // size of allocated per-cluster arrays
+  int *clusteratom;         // atom index for each cluster slot, -1 if empty
+  int *clustertype;         // atom type for each cluster slot
+  double *xcluster;         // coords for each cluster, as x,y,z blocks
+  int *firstcj;             // index of 1st neighbor cluster of each CI
+  int *numcj;               // # of neighbor clusters of each CI
+  int *cjlist;              // indices of CJ neighbor clusters
+  uint64_t *cjmask;         // pair bitmask for each CI,CJ pair
+  int maxcpair;             // size of allocated cluster pair arrays
+  bigint npair_cluster;     // # of atom pairs stored in cluster pairs
+
   // atom types to skip when building list
   // copied info from corresponding request into realloced vec/array
 
@@ -106,6 +130,10 @@ class NeighList : protected Pointers {
   void post_constructor(class NeighRequest *);
   void setup_pages(int, int);    // setup page data structures
   void grow(int, int);           // grow all data structs
+  void grow_cluster(int);        // grow per-cluster data structs
+  void grow_cluster_pair(int);   // grow cluster pair data structs
+  void pack_cluster_x();         // copy current coords into xcluster
+  void split_owned();            // move I atoms with only owned J neighbors to front
   void print_attributes();       // debug routine
   int get_maxlocal() { return maxatom; }
   double memory_usage();
@@ -53,6 +53,7 @@ NeighRequest::NeighRequest(LAMMPS *_lmp) : Pointers(_lmp)
   // default is no Intel-specific neighbor list build
   // default is no Kokkos neighbor list build
   // default is no Shardlow Splitting Algorithm (SSA) neighbor list build
+  // default is no cluster pair list build
   // default is no list-specific cutoff
   // default is no storage of auxiliary floating point values
 
@@ -68,6 +69,7 @@ NeighRequest::NeighRequest(LAMMPS *_lmp) : Pointers(_lmp)
   intel = 0;
   kokkos_host = kokkos_device = 0;
   ssa = 0;
+  cluster = 0;
   cut = 0;
   cutoff = 0.0;
 
@@ -167,6 +169,7 @@ int NeighRequest::identical(NeighRequest *other)
   if (kokkos_host != other->kokkos_host) same = 0;
   if (kokkos_device != other->kokkos_device) same = 0;
   if (ssa != other->ssa) same = 0;
+  if (cluster != other->cluster) same = 0;
   if (copy != other->copy) same = 0;
   if (cutoff != other->cutoff) same = 0;
 
@@ -231,6 +234,7 @@ void NeighRequest::copy_request(NeighRequest *other, int skipflag)
   kokkos_host = other->kokkos_host;
   kokkos_device = other->kokkos_device;
   ssa = other->ssa;
+  cluster = other->cluster;
   cut = other->cut;
   cutoff = other->cutoff;
 
@@ -274,6 +278,7 @@ void NeighRequest::apply_flags(int flags)
   if (flags & REQ_RESPA_INOUT) { respainner = respaouter = 1; }
   if (flags & REQ_RESPA_ALL)   { respainner = respamiddle = respaouter = 1; }
   if (flags & REQ_SSA)         { ssa = 1; }
+  if (flags & REQ_CLUSTER)     { cluster = 1; }
   // clang-format on
 }
 
@@ -80,6 +80,7 @@ class NeighRequest : protected Pointers {
   int kokkos_host;     // set by KOKKOS package
   int kokkos_device;
   int ssa;          // set by DPD-REACT package, for Shardlow lists
+  int cluster;      // 1 if requestor can use cluster pair lists
   int cut;          // 1 if use a non-standard cutoff length
   double cutoff;    // special cutoff distance for this list
 
@@ -131,6 +131,8 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   oneatom = 2000;
   binsizeflag = 0;
   build_once = 0;
+  clustersize = 0;
+  incremental = 0.0;
   cluster_check = 0;
   ago = -1;
 
@@ -170,6 +172,8 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   old_triclinic = 0;
   old_pgsize = pgsize;
   old_oneatom = oneatom;
+  old_clustersize = clustersize;
+  old_incremental = incremental;
 
   binclass = nullptr;
   binnames = nullptr;
@@ -194,6 +198,20 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   lastcall = -1;
   last_setup_bins = -1;
 
+  // data for incremental builds
+
+  nincremental = 0;
+  incremental_build = incremental_lists = incremental_valid = 0;
+  maxincr = 0;
+  xfull = nullptr;
+  moveflag = nullptr;
+  oldindex = nullptr;
+  nlocal_prev = nall_prev = maxprev = 0;
+  old2new = nullptr;
+  tagprev = nullptr;
+  xprev = xfullprev = nullptr;
+  moveprev = nullptr;
+
   // pair exclusion list info
 
   includegroup = 0;
@@ -271,6 +289,15 @@ Neighbor::~Neighbor()
 
   memory->destroy(xhold);
 
+  memory->destroy(xfull);
+  memory->destroy(moveflag);
+  memory->destroy(oldindex);
+  memory->destroy(old2new);
+  memory->destroy(tagprev);
+  memory->destroy(xprev);
+  memory->destroy(xfullprev);
+  memory->destroy(moveprev);
+
   memory->destroy(ex1_type);
   memory->destroy(ex2_type);
   memory->destroy(ex_type);
@@ -329,7 +356,17 @@ void Neighbor::init()
   // cutneigh = force cutoff + skin if cutforce > 0, else cutneigh = 0
   // cutneighghost = pair cutghost if it requests it, else same as cutneigh
 
-  triggersq = 0.25*skin*skin;
+  // incremental builds only guarantee pairs within cutneigh - 2*incremental
+
+  if (incremental > 0.0) {
+    if (2.0*incremental >= skin)
+      error->all(FLERR,"Neigh_modify incremental distance must be less than 1/2 of skin");
+    if (atom->map_style == Atom::MAP_NONE)
+      error->all(FLERR,"Neigh_modify incremental requires an atom map, see atom_modify");
+    triggersq = 0.25*(skin-2.0*incremental)*(skin-2.0*incremental);
+  } else triggersq = 0.25*skin*skin;
+  incremental_valid = 0;
+
   boxcheck = 0;
   if (domain->box_change && (domain->xperiodic || domain->yperiodic ||
                              (dimension == 3 && domain->zperiodic)))
@@ -785,6 +822,8 @@ int Neighbor::init_pair()
   if (triclinic != old_triclinic) same = 0;
   if (pgsize != old_pgsize) same = 0;
   if (oneatom != old_oneatom) same = 0;
+  if (clustersize != old_clustersize) same = 0;
+  if ((incremental > 0.0) != (old_incremental > 0.0)) same = 0;
 
   if (nrequest != old_nrequest) same = 0;
   else
@@ -916,6 +955,7 @@ int Neighbor::init_pair()
     lists[i]->pair_method = flag;
     if (flag < 0)
       error->all(FLERR,"Requested neighbor pair method does not exist");
+    if (flag > 0 && (pairmasks[flag-1] & NP_CLUSTER)) lists[i]->cluster = clustersize;
   }
 
   // instantiate unique Bin,Stencil classes in neigh_bin & neigh_stencil vecs
@@ -1035,9 +1075,12 @@ int Neighbor::init_pair()
   slist = new int[nstencil];
   plist = new int[nlist];
 
+  incremental_lists = 0;
   for (i = 0; i < nlist; i++) {
-    if (lists[i]->occasional == 0 && lists[i]->pair_method)
+    if (lists[i]->occasional == 0 && lists[i]->pair_method) {
       plist[npair_perpetual++] = i;
+      if (pairmasks[lists[i]->pair_method-1] & NP_INCREMENTAL) incremental_lists = 1;
+    }
   }
 
   for (i = 0; i < nstencil; i++) {
@@ -1152,9 +1195,11 @@ void Neighbor::morph_skip()
       jrq = requests[j];
 
       // can only skip from a perpetual non-skip list
+      // cluster pair lists do not store per-atom neighbors to skip from
 
       if (jrq->occasional) continue;
       if (jrq->skip) continue;
+      if (clustersize && jrq->cluster) continue;
 
       // both lists must be half, or both full
 
@@ -1210,6 +1255,7 @@ void Neighbor::morph_skip()
       nrq->pair = nrq->fix = nrq->compute = nrq->command = 0;
       nrq->neigh = 1;
       nrq->skip = 0;
+      nrq->cluster = 0;
       if (irq->unique) nrq->unique = 1;
     }
   }
@@ -1304,8 +1350,10 @@ void Neighbor::morph_halffull()
 
     // these lists are created other ways, no need for halffull
     // do want to process skip lists
+    // cluster pair lists are built directly from bins
 
     if (irq->copy) continue;
+    if (clustersize && irq->cluster && !irq->skip) continue;
 
     // check all other lists
 
@@ -1415,6 +1463,11 @@ void Neighbor::morph_copy()
       if (jrq->respamiddle) continue;
       if (jrq->respainner) continue;
 
+      // cluster pair lists are neither copied nor copied from
+      // b/c they do not store per-atom neighbors
+
+      if (clustersize && (irq->cluster || jrq->cluster)) continue;
+
       // these flags must be same,
       //   else 2 lists do not store same pairs
       //   or their data structures are different
@@ -1615,6 +1668,7 @@ void Neighbor::print_pairwise_info()
   bbox[1] =  bboxhi[1]-bboxlo[1];
   bbox[2] =  bboxhi[2]-bboxlo[2];
   if (binsizeflag) binsize = binsize_user;
+  else if (style == Neighbor::BIN && clustersize) binsize = cutneighmax;
   else if (style == Neighbor::BIN) binsize = 0.5*cutneighmax;
   else binsize = 0.5*cutneighmin;
   if (binsize == 0.0) binsize = bbox[0];
@@ -1631,6 +1685,10 @@ void Neighbor::print_pairwise_info()
   std::string out = "Neighbor list info ...\n";
   out += fmt::format("  update every {} steps, delay {} steps, check {}\n",
                      every,delay,dist_check ? "yes" : "no");
+  if (clustersize)
+    out += fmt::format("  cluster pair lists with {} atoms per cluster\n",clustersize);
+  if (incremental > 0.0)
+    out += fmt::format("  incremental builds for atoms moved less than {:.8g}\n",incremental);
   out += fmt::format("  max neighbors/atom: {}, page size: {}\n",
                      oneatom, pgsize);
   out += fmt::format("  master list distance cutoff = {:.8g}\n",cutneighmax);
@@ -1696,6 +1754,7 @@ void Neighbor::print_pairwise_info()
     if (rq->kokkos_device) out += ", kokkos_device";
     if (rq->kokkos_host) out += ", kokkos_host";
     if (rq->ssa) out += ", ssa";
+    if (lists[i]->cluster) out += ", cluster";
     if (rq->cut) out += fmt::format(", cut {}",rq->cutoff);
     if (rq->off2on) out += ", off2on";
     out += "\n";
@@ -1716,6 +1775,35 @@ void Neighbor::print_pairwise_info()
   utils::logmesg(lmp,out);
 }
 
+/* ----------------------------------------------------------------------
+   change skin distance in the middle of a run
+   re-issue requests of current run, so init() keeps the existing lists
+     and only recomputes cutoffs and refreshes Bin,Stencil,Pair info
+   build counters are preserved, caller must reset comm and bins
+------------------------------------------------------------------------- */
+
+void Neighbor::reset_skin(double newskin)
+{
+  bigint ncalls_hold = ncalls;
+  bigint ndanger_hold = ndanger;
+
+  skin = newskin;
+
+  for (int i = 0; i < old_nrequest; i++) {
+    if (nrequest == maxrequest) {
+      maxrequest += RQDELTA;
+      requests = (NeighRequest **)
+        memory->srealloc(requests,maxrequest*sizeof(NeighRequest *), "neighbor:requests");
+    }
+    requests[nrequest++] = new NeighRequest(old_requests[i]);
+  }
+
+  init();
+
+  ncalls = ncalls_hold;
+  ndanger = ndanger_hold;
+}
+
 /* ----------------------------------------------------------------------
    make copy of current requests and Neighbor params
    used to compare to when next run occurs
@@ -1737,6 +1825,8 @@ void Neighbor::requests_new2old()
   old_triclinic = triclinic;
   old_pgsize = pgsize;
   old_oneatom = oneatom;
+  old_clustersize = clustersize;
+  old_incremental = incremental;
 }
 
 /* ----------------------------------------------------------------------
@@ -1949,6 +2039,33 @@ int Neighbor::choose_pair(NeighRequest *rq)
 
   int molecular = atom->molecular;
 
+  // cluster pair lists are only built for plain half lists with newton on
+  //   of atomic systems in orthogonal boxes
+  // all other requests by cluster capable styles get a regular list
+
+  int cluster = 0;
+  if (clustersize && rq->cluster && rq->half && newtflag && !triclinic &&
+      (molecular == Atom::ATOMIC) && (style == Neighbor::BIN)) {
+    cluster = 1;
+    if (rq->ghost || rq->size || rq->granonesided || rq->bond) cluster = 0;
+    if (rq->respaouter || rq->omp || rq->intel || rq->ssa) cluster = 0;
+    if (rq->kokkos_host || rq->kokkos_device) cluster = 0;
+    if (rq->skip || rq->copy || rq->halffull || rq->off2on) cluster = 0;
+  }
+
+  // incremental builds are likewise limited to plain half lists with newton on
+  //   of atomic systems in orthogonal boxes, and not for cluster pair lists
+
+  int incr = 0;
+  if ((incremental > 0.0) && !cluster && rq->half && newtflag && !triclinic &&
+      (molecular == Atom::ATOMIC) && (style == Neighbor::BIN) && !includegroup) {
+    incr = 1;
+    if (rq->ghost || rq->size || rq->granonesided || rq->bond) incr = 0;
+    if (rq->respaouter || rq->omp || rq->intel || rq->ssa) incr = 0;
+    if (rq->kokkos_host || rq->kokkos_device) incr = 0;
+    if (rq->skip || rq->copy || rq->halffull || rq->off2on) incr = 0;
+  }
+
   //printf("PAIR RQ FLAGS: hf %d %d n %d g %d sz %d gos %d r %d b %d o %d i %d "
   //       "kk %d %d ss %d dn %d sk %d cp %d hf %d oo %d\n",
   //        rq->half,rq->full,rq->newton,rq->ghost,rq->size,
@@ -2020,6 +2137,8 @@ int Neighbor::choose_pair(NeighRequest *rq)
     if (!rq->kokkos_device != !(mask & NP_KOKKOS_DEVICE)) continue;
     if (!rq->kokkos_host != !(mask & NP_KOKKOS_HOST)) continue;
     if (!rq->ssa != !(mask & NP_SSA)) continue;
+    if (!cluster != !(mask & NP_CLUSTER)) continue;
+    if (!incr != !(mask & NP_INCREMENTAL)) continue;
 
     if (!rq->skip != !(mask & NP_SKIP)) continue;
 
@@ -2031,7 +2150,7 @@ int Neighbor::choose_pair(NeighRequest *rq)
     if (style == Neighbor::NSQ) {
       if (!(mask & NP_NSQ)) continue;
     } else if (style == Neighbor::BIN) {
-      if (!(mask & NP_BIN)) continue;
+      if (!(mask & (NP_BIN | NP_CLUSTER))) continue;
     } else if (style == Neighbor::MULTI_OLD) {
       if (!(mask & NP_MULTI_OLD)) continue;
     } else if (style == Neighbor::MULTI) {
@@ -2189,6 +2308,7 @@ int Neighbor::decide()
    conservative shrink procedure:
      compute distance each of 8 corners of box has moved since last reneighbor
      reduce skin distance by sum of 2 largest of the 8 values
+     and by 2*incremental, if lists are built incrementally
      if reduced skin distance is negative, set to zero
      new trigger = 1/2 of reduced skin distance
    for orthogonal box, only need 2 lo/hi corners
@@ -2210,7 +2330,7 @@ int Neighbor::check_distance()
       dely = bboxhi[1] - boxhi_hold[1];
       delz = bboxhi[2] - boxhi_hold[2];
       delta2 = sqrt(delx*delx + dely*dely + delz*delz);
-      delta = 0.5 * (skin - (delta1+delta2));
+      delta = 0.5 * (skin - 2.0*incremental - (delta1+delta2));
       if (delta < 0.0) delta = 0.0;
       deltasq = delta*delta;
     } else {
@@ -2224,7 +2344,7 @@ int Neighbor::check_distance()
         if (delta > delta1) delta1 = delta;
         else if (delta > delta2) delta2 = delta;
       }
-      delta = 0.5 * (skin - (delta1+delta2));
+      delta = 0.5 * (skin - 2.0*incremental - (delta1+delta2));
       if (delta < 0.0) delta = 0.0;
       deltasq = delta*delta;
     }
@@ -2322,6 +2442,10 @@ void Neighbor::build(int topoflag)
     }
   }
 
+  // decide between full and incremental build of lists that support it
+
+  if (incremental_lists) incremental_setup();
+
   // build pairwise lists for all perpetual NPair/NeighList
   // grow() with nlocal/nall args so that only realloc if have to
 
@@ -2333,11 +2457,159 @@ void Neighbor::build(int topoflag)
     neigh_pair[m]->build(lists[m]);
   }
 
+  if (incremental_lists) incremental_store();
+
+  // split pair list so comm of ghost coords can overlap with pair forces
+
+  if (comm->overlap && force->pair && force->pair->overlap_enable) {
+    NeighList *list = force->pair->list;
+    if (list && !list->ghost && !list->cluster) list->split_owned();
+  }
+
   // build topology lists for bonds/angles/etc
 
   if ((atom->molecular != Atom::ATOMIC) && topoflag) build_topology();
 }
 
+/* ----------------------------------------------------------------------
+   decide if lists with incremental builds can patch their previous lists
+   atom indices change between builds due to migration, sorting, and
+     regenerated ghosts, so atoms are matched by atom ID
+   owned atoms are "movers" if they moved more than incremental since the
+     last full build or were not owned at the previous build
+   moveflag of ghost atoms is set from their owned atoms by forward comm
+   each atom of previous build is matched to its image within 2*incremental,
+     which always exists for non-movers
+   a full build is done on all procs if too many atoms are movers
+------------------------------------------------------------------------- */
+
+void Neighbor::incremental_setup()
+{
+  int i,k;
+  double delx,dely,delz;
+
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+
+  if (atom->nmax > maxincr) {
+    maxincr = atom->nmax;
+    memory->destroy(xfull);
+    memory->destroy(moveflag);
+    memory->destroy(oldindex);
+    memory->create(xfull,maxincr,3,"neigh:xfull");
+    memory->create(moveflag,maxincr,1,"neigh:moveflag");
+    memory->create(oldindex,maxincr,"neigh:oldindex");
+  }
+
+  incremental_build = 0;
+  int flag = incremental_valid && !update->setupflag;
+
+  if (flag) {
+    const double incrsq = incremental*incremental;
+    for (i = 0; i < nlocal; i++) {
+      oldindex[i] = -1;
+      moveflag[i][0] = 1.0;
+    }
+    for (k = 0; k < nlocal_prev; k++) {
+      i = atom->map(tagprev[k]);
+      if (i < 0 || i >= nlocal) continue;
+      oldindex[i] = k;
+      xfull[i][0] = xfullprev[k][0];
+      xfull[i][1] = xfullprev[k][1];
+      xfull[i][2] = xfullprev[k][2];
+      delx = x[i][0] - xfull[i][0];
+      dely = x[i][1] - xfull[i][1];
+      delz = x[i][2] - xfull[i][2];
+      if ((moveprev[k] == 0.0) && (delx*delx + dely*dely + delz*delz <= incrsq))
+        moveflag[i][0] = 0.0;
+    }
+
+    // full build is faster if more than 1/4 of the atoms need a new row
+
+    bigint nmove = 0;
+    for (i = 0; i < nlocal; i++)
+      if (moveflag[i][0] != 0.0) nmove++;
+    bigint nmoveall;
+    MPI_Allreduce(&nmove,&nmoveall,1,MPI_LMP_BIGINT,MPI_SUM,world);
+    if (4*nmoveall > atom->natoms) flag = 0;
+  }
+
+  if (!flag) {
+    for (i = 0; i < nlocal; i++) {
+      xfull[i][0] = x[i][0];
+      xfull[i][1] = x[i][1];
+      xfull[i][2] = x[i][2];
+    }
+    for (i = 0; i < nall; i++) moveflag[i][0] = 0.0;
+    return;
+  }
+
+  comm->forward_comm_array(1,moveflag);
+
+  const double cutsq = 4.0*incremental*incremental;
+  int *sametag = atom->sametag;
+  for (k = 0; k < nall_prev; k++) {
+    old2new[k] = -1;
+    for (i = atom->map(tagprev[k]); i >= 0; i = sametag[i]) {
+      delx = x[i][0] - xprev[k][0];
+      dely = x[i][1] - xprev[k][1];
+      delz = x[i][2] - xprev[k][2];
+      if (delx*delx + dely*dely + delz*delz <= cutsq) {
+        old2new[k] = i;
+        break;
+      }
+    }
+  }
+
+  incremental_build = 1;
+  nincremental++;
+}
+
+/* ----------------------------------------------------------------------
+   store atom IDs, coords, and moveflag of this build
+   for matching atoms to their indices at the next build
+------------------------------------------------------------------------- */
+
+void Neighbor::incremental_store()
+{
+  double **x = atom->x;
+  tagint *tag = atom->tag;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+
+  if (nall > maxprev) {
+    maxprev = atom->nmax;
+    memory->destroy(old2new);
+    memory->destroy(tagprev);
+    memory->destroy(xprev);
+    memory->destroy(xfullprev);
+    memory->destroy(moveprev);
+    memory->create(old2new,maxprev,"neigh:old2new");
+    memory->create(tagprev,maxprev,"neigh:tagprev");
+    memory->create(xprev,maxprev,3,"neigh:xprev");
+    memory->create(xfullprev,maxprev,3,"neigh:xfullprev");
+    memory->create(moveprev,maxprev,"neigh:moveprev");
+  }
+
+  for (int i = 0; i < nall; i++) {
+    tagprev[i] = tag[i];
+    xprev[i][0] = x[i][0];
+    xprev[i][1] = x[i][1];
+    xprev[i][2] = x[i][2];
+  }
+  for (int i = 0; i < nlocal; i++) {
+    xfullprev[i][0] = xfull[i][0];
+    xfullprev[i][1] = xfull[i][1];
+    xfullprev[i][2] = xfull[i][2];
+    moveprev[i] = moveflag[i][0];
+  }
+
+  nlocal_prev = nlocal;
+  nall_prev = nall;
+  incremental_valid = 1;
+}
+
 /* ----------------------------------------------------------------------
    build topology neighbor lists: bond, angle, dihedral, improper
    copy their list info back to Neighbor for access by bond/angle/etc classes
@@ -2435,9 +2707,13 @@ void Neighbor::set(int narg, char **arg)
   skin = utils::numeric(FLERR,arg[0],false,lmp);
   if (skin < 0.0) error->all(FLERR,"Illegal neighbor command");
 
+  clustersize = 0;
   if (strcmp(arg[1],"nsq") == 0) style = Neighbor::NSQ;
   else if (strcmp(arg[1],"bin") == 0) style = Neighbor::BIN;
-  else if (strcmp(arg[1],"multi") == 0) {
+  else if (strcmp(arg[1],"cluster") == 0) {
+    style = Neighbor::BIN;
+    clustersize = 4;
+  } else if (strcmp(arg[1],"multi") == 0) {
     style = Neighbor::MULTI;
     ncollections = atom->ntypes;
   } else if (strcmp(arg[1],"multi/old") == 0) style = Neighbor::MULTI_OLD;
@@ -2514,6 +2790,21 @@ void Neighbor::modify_params(int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
       cluster_check = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"cluster/size") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
+      if (!clustersize)
+        error->all(FLERR,"Neigh_modify cluster/size requires neighbor style cluster");
+      clustersize = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (clustersize != 4 && clustersize != 8)
+        error->all(FLERR,"Illegal neigh_modify cluster/size value: {}",clustersize);
+      iarg += 2;
+
+    } else if (strcmp(arg[iarg],"incremental") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
+      incremental = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      if (incremental < 0.0)
+        error->all(FLERR,"Illegal neigh_modify incremental value: {}",incremental);
+      iarg += 2;
 
     } else if (strcmp(arg[iarg],"include") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
@@ -2818,7 +3109,8 @@ bigint Neighbor::get_nneigh_half()
   bigint nneighhalf = -1;
   if (m < old_nrequest) {
     nneighhalf = 0;
-    if (!lists[m]->kokkos) {
+    if (lists[m]->cluster) nneighhalf = lists[m]->npair_cluster;
+    else if (!lists[m]->kokkos) {
       int inum = neighbor->lists[m]->inum;
       int *ilist = neighbor->lists[m]->ilist;
       int *numneigh = neighbor->lists[m]->numneigh;
@@ -2837,6 +3129,14 @@ double Neighbor::memory_usage()
 {
   double bytes = 0;
   bytes += memory->usage(xhold,maxhold,3);
+  bytes += memory->usage(xfull,maxincr,3);
+  bytes += memory->usage(moveflag,maxincr,1);
+  bytes += memory->usage(oldindex,maxincr);
+  bytes += memory->usage(old2new,maxprev);
+  bytes += memory->usage(tagprev,maxprev);
+  bytes += memory->usage(xprev,maxprev,3);
+  bytes += memory->usage(xfullprev,maxprev,3);
+  bytes += memory->usage(moveprev,maxprev);
 
   for (int i = 0; i < nlist; i++)
     if (lists[i]) bytes += lists[i]->memory_usage();
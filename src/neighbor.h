@@ -34,6 +34,10 @@ class Neighbor : protected Pointers {
   int oneatom;         // max # of neighbors for one atom
   int includegroup;    // only build pairwise lists for this group
   int build_once;      // 1 if only build lists once per run
+  int clustersize;     // # of atoms per cluster for cluster pair lists
+                       // 0 = off (neighbor style bin), 4 or 8 = on
+  double incremental;  // displacement threshold for incremental builds
+                       // 0.0 = off, always rebuild lists from scratch
 
   double skin;                    // skin distance
   double cutneighmin;             // min neighbor cutoff for all type pairs
@@ -53,6 +57,16 @@ class Neighbor : protected Pointers {
   bigint ncalls;      // # of times build has been called
   bigint ndanger;     // # of dangerous builds
   bigint lastcall;    // timestep of last neighbor::build() call
+  bigint nincremental;    // # of incremental builds
+
+  // per-atom data for incremental builds, used by NPair
+
+  int incremental_build;    // 1 if current build patches previous lists
+  double **moveflag;        // 1.0 if atom moved more than incremental since
+                            //   last full build or is new, 0.0 if not
+  int *oldindex;            // index of owned atom at previous build, -1 if new
+  int *old2new;             // current index of each atom of previous build
+                            //   -1 if not found within 2*incremental
 
   // geometry and static info, used by other Neigh classes
 
@@ -148,6 +162,7 @@ class Neighbor : protected Pointers {
   void build_one(class NeighList *list, int preflag = 0);
   void set(int, char **);                     // set neighbor style and skin distance
   void reset_timestep(bigint);                // reset of timestep counter
+  void reset_skin(double);                    // change skin distance during a run
   void modify_params(int, char **);           // modify params that control builds
   void modify_params(const std::string &);    // convenience overload
 
@@ -183,6 +198,18 @@ class Neighbor : protected Pointers {
   double **xhold;    // atom coords at last neighbor build
   int maxhold;       // size of xhold array
 
+  int incremental_lists;    // 1 if any perpetual list is built incrementally
+  int incremental_valid;    // 1 if data of previous build can be reused
+  int maxincr;              // size of per-atom incremental arrays
+  double **xfull;           // owned atom coords at last full build
+  int nlocal_prev;          // # of owned atoms at previous build
+  int nall_prev;            // # of owned + ghost atoms at previous build
+  int maxprev;              // size of arrays for previous build
+  tagint *tagprev;          // atom IDs at previous build
+  double **xprev;           // atom coords at previous build
+  double **xfullprev;       // xfull of owned atoms at previous build
+  double *moveprev;         // moveflag of owned atoms at previous build
+
   int boxcheck;                           // 1 if need to store box size
   double boxlo_hold[3], boxhi_hold[3];    // box size at last neighbor build
   double corners_hold[8][3];              // box corners at last neighbor build
@@ -192,6 +219,8 @@ class Neighbor : protected Pointers {
 
   int old_style, old_triclinic;    // previous run info
   int old_pgsize, old_oneatom;     // used to avoid re-creating neigh lists
+  int old_clustersize;
+  double old_incremental;
 
   int nstencil_perpetual;    // # of perpetual NeighStencil classes
   int npair_perpetual;       // #x of perpetual NeighPair classes
@@ -248,6 +277,8 @@ class Neighbor : protected Pointers {
   void morph_copy();
 
   void print_pairwise_info();
+  void incremental_setup();
+  void incremental_store();
   void requests_new2old();
 
   int choose_bin(class NeighRequest *);
@@ -319,7 +350,9 @@ namespace NeighConst {
     NP_SKIP = 1 << 22,
     NP_HALF_FULL = 1 << 23,
     NP_OFF2ON = 1 << 24,
-    NP_MULTI_OLD = 1 << 25
+    NP_MULTI_OLD = 1 << 25,
+    NP_CLUSTER = 1 << 26,
+    NP_INCREMENTAL = 1 << 27
   };
 
   enum {
@@ -334,6 +367,7 @@ namespace NeighConst {
     REQ_NEWTON_ON = 1 << 8,
     REQ_NEWTON_OFF = 1 << 9,
     REQ_SSA = 1 << 10,
+    REQ_CLUSTER = 1 << 11,
   };
 }    // namespace NeighConst
 
@@ -0,0 +1,258 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "npair_half_bin_atomonly_newton_incremental.h"
+
+#include "atom.h"
+#include "error.h"
+#include "memory.h"
+#include "my_page.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+NPairHalfBinAtomonlyNewtonIncremental::NPairHalfBinAtomonlyNewtonIncremental(LAMMPS *lmp) :
+  NPairHalfBinAtomonlyNewton(lmp)
+{
+  last_ncalls = -1;
+  maxsnap = maxmover = maxbin = maxfull = 0;
+  maxpair = 0;
+  snapfirst = nullptr;
+  snapneigh = nullptr;
+  moverhead = movernext = nullptr;
+  fullstencil = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+NPairHalfBinAtomonlyNewtonIncremental::~NPairHalfBinAtomonlyNewtonIncremental()
+{
+  memory->destroy(snapfirst);
+  memory->destroy(snapneigh);
+  memory->destroy(moverhead);
+  memory->destroy(movernext);
+  memory->destroy(fullstencil);
+}
+
+/* ----------------------------------------------------------------------
+   binned neighbor list construction with full Newton's 3rd law
+   patch list of previous build if Neighbor allows an incremental build,
+     else build from scratch the same as half/bin/atomonly/newton
+   keep a copy of the list, since the next build overwrites its pages
+------------------------------------------------------------------------- */
+
+void NPairHalfBinAtomonlyNewtonIncremental::build(NeighList *list)
+{
+  if (neighbor->incremental_build && (last_ncalls == neighbor->ncalls-1))
+    build_incremental(list);
+  else NPairHalfBinAtomonlyNewton::build(list);
+
+  store(list);
+  last_ncalls = neighbor->ncalls;
+}
+
+/* ----------------------------------------------------------------------
+   incremental build from list of previous build
+   non-movers keep their pairs with other non-movers from previous list
+     and add pairs with ghost movers in bins of full stencil
+   movers check all atoms in bins of full stencil
+   owned pairs with a mover are stored once, by the mover or by the lower
+     index if both are movers
+   owned/ghost pairs with a mover are stored if ghost is "above and to the
+     right" of the owned atom, same as other procs decide for their copy
+------------------------------------------------------------------------- */
+
+void NPairHalfBinAtomonlyNewtonIncremental::build_incremental(NeighList *list)
+{
+  int i,j,k,n,itype,jtype,ibin,jbin;
+  bigint m;
+  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
+  int *neighptr;
+
+  double **x = atom->x;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  tagint *molecule = atom->molecule;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+
+  double **moveflag = neighbor->moveflag;
+  int *oldindex = neighbor->oldindex;
+  int *old2new = neighbor->old2new;
+
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  MyPage<int> *ipage = list->ipage;
+
+  // full stencil = own bin + Newton stencil + its mirror image
+
+  if (2*nstencil+1 > maxfull) {
+    maxfull = 2*nstencil+1;
+    memory->destroy(fullstencil);
+    memory->create(fullstencil,maxfull,"neigh:fullstencil");
+  }
+  int nfull = 0;
+  fullstencil[nfull++] = 0;
+  for (k = 0; k < nstencil; k++) {
+    fullstencil[nfull++] = stencil[k];
+    fullstencil[nfull++] = -stencil[k];
+  }
+
+  // bin movers in separate linked lists
+
+  if (mbins > maxbin) {
+    maxbin = mbins;
+    memory->destroy(moverhead);
+    memory->create(moverhead,maxbin,"neigh:moverhead");
+  }
+  if (nall > maxmover) {
+    maxmover = atom->nmax;
+    memory->destroy(movernext);
+    memory->create(movernext,maxmover,"neigh:movernext");
+  }
+
+  for (ibin = 0; ibin < mbins; ibin++) moverhead[ibin] = -1;
+  for (j = nall-1; j >= 0; j--) {
+    if (moveflag[j][0] == 0.0) continue;
+    ibin = atom2bin[j];
+    movernext[j] = moverhead[ibin];
+    moverhead[ibin] = j;
+  }
+
+  int inum = 0;
+  ipage->reset();
+
+  for (i = 0; i < nlocal; i++) {
+    n = 0;
+    neighptr = ipage->vget();
+
+    itype = type[i];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    ibin = atom2bin[i];
+
+    if (moveflag[i][0] == 0.0) {
+
+      // pairs with other non-movers are unchanged
+
+      const int iold = oldindex[i];
+      for (m = snapfirst[iold]; m < snapfirst[iold+1]; m++) {
+        j = old2new[snapneigh[m]];
+        if (j >= 0 && moveflag[j][0] == 0.0) neighptr[n++] = j;
+      }
+
+      // owned movers store their pairs with i themselves
+
+      for (k = 0; k < nfull; k++) {
+        jbin = ibin + fullstencil[k];
+        for (j = moverhead[jbin]; j >= 0; j = movernext[j]) {
+          if (j < nlocal) continue;
+          if (x[j][2] < ztmp) continue;
+          if (x[j][2] == ztmp) {
+            if (x[j][1] < ytmp) continue;
+            if (x[j][1] == ytmp && x[j][0] < xtmp) continue;
+          }
+
+          jtype = type[j];
+          if (exclude && exclusion(i,j,itype,jtype,mask,molecule)) continue;
+
+          delx = xtmp - x[j][0];
+          dely = ytmp - x[j][1];
+          delz = ztmp - x[j][2];
+          rsq = delx*delx + dely*dely + delz*delz;
+
+          if (rsq <= cutneighsq[itype][jtype]) neighptr[n++] = j;
+        }
+      }
+
+    } else {
+
+      // mover checks all atoms in full stencil
+
+      for (k = 0; k < nfull; k++) {
+        jbin = ibin + fullstencil[k];
+        for (j = binhead[jbin]; j >= 0; j = bins[j]) {
+          if (j < nlocal) {
+            if (j == i) continue;
+            if (moveflag[j][0] != 0.0 && j < i) continue;
+          } else {
+            if (x[j][2] < ztmp) continue;
+            if (x[j][2] == ztmp) {
+              if (x[j][1] < ytmp) continue;
+              if (x[j][1] == ytmp && x[j][0] < xtmp) continue;
+            }
+          }
+
+          jtype = type[j];
+          if (exclude && exclusion(i,j,itype,jtype,mask,molecule)) continue;
+
+          delx = xtmp - x[j][0];
+          dely = ytmp - x[j][1];
+          delz = ztmp - x[j][2];
+          rsq = delx*delx + dely*dely + delz*delz;
+
+          if (rsq <= cutneighsq[itype][jtype]) neighptr[n++] = j;
+        }
+      }
+    }
+
+    ilist[inum++] = i;
+    firstneigh[i] = neighptr;
+    numneigh[i] = n;
+    ipage->vgot(n);
+    if (ipage->status())
+      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+  }
+
+  list->inum = inum;
+}
+
+/* ----------------------------------------------------------------------
+   copy list into contiguous arrays indexed by owned atom
+------------------------------------------------------------------------- */
+
+void NPairHalfBinAtomonlyNewtonIncremental::store(NeighList *list)
+{
+  int nlocal = atom->nlocal;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  if (nlocal+1 > maxsnap) {
+    maxsnap = atom->nmax + 1;
+    memory->destroy(snapfirst);
+    memory->create(snapfirst,maxsnap,"neigh:snapfirst");
+  }
+
+  bigint npair = 0;
+  for (int i = 0; i < nlocal; i++) npair += numneigh[i];
+  if (npair > maxpair) {
+    maxpair = npair + npair/4;
+    memory->destroy(snapneigh);
+    memory->create(snapneigh,maxpair,"neigh:snapneigh");
+  }
+
+  bigint m = 0;
+  for (int i = 0; i < nlocal; i++) {
+    snapfirst[i] = m;
+    const int *neighptr = firstneigh[i];
+    const int jnum = numneigh[i];
+    for (int jj = 0; jj < jnum; jj++) snapneigh[m++] = neighptr[jj];
+  }
+  snapfirst[nlocal] = m;
+}
@@ -0,0 +1,58 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef NPAIR_CLASS
+// clang-format off
+NPairStyle(half/bin/atomonly/newton/incremental,
+           NPairHalfBinAtomonlyNewtonIncremental,
+           NP_HALF | NP_BIN | NP_ATOMONLY | NP_NEWTON | NP_ORTHO | NP_INCREMENTAL);
+// clang-format on
+#else
+
+#ifndef LMP_NPAIR_HALF_BIN_ATOMONLY_NEWTON_INCREMENTAL_H
+#define LMP_NPAIR_HALF_BIN_ATOMONLY_NEWTON_INCREMENTAL_H
+
+#include "npair_half_bin_atomonly_newton.h"
+
+namespace LAMMPS_NS {
+
+class NPairHalfBinAtomonlyNewtonIncremental : public NPairHalfBinAtomonlyNewton {
+ public:
+  NPairHalfBinAtomonlyNewtonIncremental(class LAMMPS *);
+  ~NPairHalfBinAtomonlyNewtonIncremental() override;
+  void build(class NeighList *) override;
+
+ protected:
+  bigint last_ncalls;    // neighbor->ncalls of last build
+
+  int maxsnap;          // size of snapfirst
+  bigint maxpair;       // size of snapneigh
+  bigint *snapfirst;    // 1st neighbor of each owned atom in snapneigh
+  int *snapneigh;       // neighbors of all owned atoms of last build
+
+  int maxmover;      // size of movernext
+  int maxbin;        // size of moverhead
+  int *moverhead;    // 1st mover in each bin
+  int *movernext;    // next mover in same bin
+
+  int maxfull;       // size of fullstencil
+  int *fullstencil;  // own bin + both halves of Newton stencil
+
+  void build_incremental(class NeighList *);
+  void store(class NeighList *);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
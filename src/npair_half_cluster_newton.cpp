@@ -0,0 +1,327 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "npair_half_cluster_newton.h"
+#include "neigh_list.h"
+#include "atom.h"
+#include "memory.h"
+#include "error.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace LAMMPS_NS;
+
+#define BIG 1.0e20
+
+enum{SAMECLUSTER,SAMEBIN,SAMEBINGHOST,OTHERBIN};
+
+/* ---------------------------------------------------------------------- */
+
+NPairHalfClusterNewton::NPairHalfClusterNewton(LAMMPS *lmp) : NPair(lmp)
+{
+  maxbin = maxcbox = maxsort = 0;
+  bincfirst = bincnum = nullptr;
+  bingfirst = bingnum = nullptr;
+  cbox = nullptr;
+  sortatom = sortcol = sortperm = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+NPairHalfClusterNewton::~NPairHalfClusterNewton()
+{
+  memory->destroy(bincfirst);
+  memory->destroy(bincnum);
+  memory->destroy(bingfirst);
+  memory->destroy(bingnum);
+  memory->destroy(cbox);
+  memory->destroy(sortatom);
+  memory->destroy(sortcol);
+  memory->destroy(sortperm);
+}
+
+/* ----------------------------------------------------------------------
+   binned cluster pair list construction with full Newton's 3rd law
+   owned and ghost atoms of each bin are sorted by xy column and z coord
+     and grouped into clusters of list->cluster atoms, padded with empty slots
+   each owned cluster checks clusters in its own bin and other bins in
+     Newton stencil, pruned by distance between cluster bounding boxes
+   the per cluster pair bitmask selects exactly the atom pairs that
+     NPairHalfBinNewton would store, so every pair is stored once
+------------------------------------------------------------------------- */
+
+void NPairHalfClusterNewton::build(NeighList *list)
+{
+  int i,j,k,ibin,jbin,ci,cj,nlocal_cluster,nghost_cluster;
+
+  const int cs = list->cluster;
+  int nlocal = atom->nlocal;
+  if (includegroup) nlocal = atom->nfirst;
+
+  // largest cutoff of any type pair, used to prune cluster pairs
+
+  const int ntypes = atom->ntypes;
+  cutmaxsq = 0.0;
+  for (i = 1; i <= ntypes; i++)
+    for (j = 1; j <= ntypes; j++)
+      cutmaxsq = MAX(cutmaxsq,cutneighsq[i][j]);
+
+  if (mbins > maxbin) {
+    maxbin = mbins;
+    memory->destroy(bincfirst);
+    memory->destroy(bincnum);
+    memory->destroy(bingfirst);
+    memory->destroy(bingnum);
+    memory->create(bincfirst,maxbin,"neigh:bincfirst");
+    memory->create(bincnum,maxbin,"neigh:bincnum");
+    memory->create(bingfirst,maxbin,"neigh:bingfirst");
+    memory->create(bingnum,maxbin,"neigh:bingnum");
+  }
+
+  // count clusters of owned and ghost atoms in each bin
+  // owned atoms are at the front of each bin's linked list
+
+  nlocal_cluster = nghost_cluster = 0;
+  int maxinbin = 0;
+  for (ibin = 0; ibin < mbins; ibin++) {
+    int nown = 0, nghost = 0;
+    for (j = binhead[ibin]; j >= 0; j = bins[j]) {
+      if (j < nlocal) nown++;
+      else nghost++;
+    }
+    nlocal_cluster += (nown + cs - 1) / cs;
+    nghost_cluster += (nghost + cs - 1) / cs;
+    maxinbin = MAX(maxinbin,MAX(nown,nghost));
+  }
+
+  list->grow_cluster(nlocal_cluster + nghost_cluster);
+  if (list->maxcluster > maxcbox) {
+    maxcbox = list->maxcluster;
+    memory->destroy(cbox);
+    memory->create(cbox,maxcbox,6,"neigh:cbox");
+  }
+  if (maxinbin > maxsort) {
+    maxsort = maxinbin;
+    memory->destroy(sortatom);
+    memory->destroy(sortcol);
+    memory->destroy(sortperm);
+    memory->create(sortatom,maxsort,"neigh:sortatom");
+    memory->create(sortcol,maxsort,"neigh:sortcol");
+    memory->create(sortperm,maxsort,"neigh:sortperm");
+  }
+
+  // clusters of owned atoms first, then clusters of ghost atoms
+
+  int ncluster = 0;
+  for (ibin = 0; ibin < mbins; ibin++) {
+    bincfirst[ibin] = ncluster;
+    bincnum[ibin] = fill_clusters(list,ibin,0,ncluster,nlocal,cs);
+  }
+  for (ibin = 0; ibin < mbins; ibin++) {
+    bingfirst[ibin] = ncluster;
+    bingnum[ibin] = fill_clusters(list,ibin,1,ncluster,nlocal,cs);
+  }
+
+  list->nclocal = nlocal_cluster;
+  list->ncall = ncluster;
+
+  // loop over clusters of owned atoms bin by bin
+
+  int npair = 0;
+  bigint natompair = 0;
+  int *firstcj = list->firstcj;
+  int *numcj = list->numcj;
+
+  for (ibin = 0; ibin < mbins; ibin++) {
+    const int cfirst = bincfirst[ibin];
+    const int clast = cfirst + bincnum[ibin];
+
+    for (ci = cfirst; ci < clast; ci++) {
+      firstcj[ci] = npair;
+
+      // rest of owned clusters in my bin, including my own cluster
+      // ghost clusters in my bin, only pairs "above and to the right" of i
+
+      add_pair(list,ci,ci,SAMECLUSTER,npair);
+      for (cj = ci+1; cj < clast; cj++)
+        add_pair(list,ci,cj,SAMEBIN,npair);
+      for (k = 0; k < bingnum[ibin]; k++)
+        add_pair(list,ci,bingfirst[ibin]+k,SAMEBINGHOST,npair);
+
+      // all owned and ghost clusters in other bins in stencil
+
+      for (k = 0; k < nstencil; k++) {
+        jbin = ibin + stencil[k];
+        for (i = 0; i < bincnum[jbin]; i++)
+          add_pair(list,ci,bincfirst[jbin]+i,OTHERBIN,npair);
+        for (i = 0; i < bingnum[jbin]; i++)
+          add_pair(list,ci,bingfirst[jbin]+i,OTHERBIN,npair);
+      }
+
+      numcj[ci] = npair - firstcj[ci];
+    }
+  }
+
+  uint64_t *cjmask = list->cjmask;
+  for (k = 0; k < npair; k++)
+    for (uint64_t m = cjmask[k]; m; m &= m-1) natompair++;
+
+  list->npair_cluster = natompair;
+  list->inum = 0;
+  list->gnum = 0;
+}
+
+/* ----------------------------------------------------------------------
+   group owned (ghostflag = 0) or ghost atoms (ghostflag = 1) of one bin
+     into consecutive clusters starting at cluster index nc
+   atoms are sorted by xy column and z coord so clusters are spatially compact
+   update nc and return # of clusters added
+------------------------------------------------------------------------- */
+
+int NPairHalfClusterNewton::fill_clusters(NeighList *list, int ibin, int ghostflag,
+                                          int &nc, int nlocal, int cs)
+{
+  double **x = atom->x;
+  int *type = atom->type;
+  int *clusteratom = list->clusteratom;
+  int *clustertype = list->clustertype;
+
+  int n = 0;
+  for (int j = binhead[ibin]; j >= 0; j = bins[j])
+    if ((j >= nlocal) == (ghostflag != 0)) sortatom[n++] = j;
+  if (n == 0) return 0;
+
+  // split bin into ncol x ncol columns in xy so clusters are roughly cubic
+  // columns are traversed in a serpentine order and atoms within a column
+  //   are sorted by z, alternating direction, so consecutive clusters are adjacent
+
+  int ncol = static_cast<int>(cbrt((double) n / cs) + 0.5);
+  ncol = MAX(ncol,1);
+  for (int m = 0; m < n; m++) {
+    const int i = sortatom[m];
+    double fx = (x[i][0]-bboxlo[0])*bininvx;
+    double fy = (x[i][1]-bboxlo[1])*bininvy;
+    int cx = static_cast<int>((fx - floor(fx))*ncol);
+    int cy = static_cast<int>((fy - floor(fy))*ncol);
+    cx = MIN(cx,ncol-1);
+    cy = MIN(cy,ncol-1);
+    if (cx % 2) cy = ncol-1 - cy;
+    sortcol[m] = cx*ncol + cy;
+    sortperm[m] = m;
+  }
+
+  std::sort(sortperm, sortperm+n, [&](int a, int b) {
+    if (sortcol[a] != sortcol[b]) return sortcol[a] < sortcol[b];
+    const double za = x[sortatom[a]][2];
+    const double zb = x[sortatom[b]][2];
+    if (za != zb) return (sortcol[a] % 2) ? (za > zb) : (za < zb);
+    return sortatom[a] < sortatom[b];
+  });
+
+  const int nnew = (n + cs - 1) / cs;
+  for (int c = 0; c < nnew; c++) {
+    double *box = cbox[nc];
+    box[0] = box[1] = box[2] = BIG;
+    box[3] = box[4] = box[5] = -BIG;
+    for (int k = 0; k < cs; k++) {
+      const int m = c*cs + k;
+      if (m < n) {
+        const int i = sortatom[sortperm[m]];
+        clusteratom[nc*cs+k] = i;
+        clustertype[nc*cs+k] = type[i];
+        box[0] = MIN(box[0],x[i][0]);
+        box[1] = MIN(box[1],x[i][1]);
+        box[2] = MIN(box[2],x[i][2]);
+        box[3] = MAX(box[3],x[i][0]);
+        box[4] = MAX(box[4],x[i][1]);
+        box[5] = MAX(box[5],x[i][2]);
+      } else {
+        clusteratom[nc*cs+k] = -1;
+        clustertype[nc*cs+k] = type[sortatom[sortperm[c*cs]]];
+      }
+    }
+    nc++;
+  }
+  return nnew;
+}
+
+/* ----------------------------------------------------------------------
+   test cluster pair CI,CJ and append it to the list if any atom pair
+     is within the neighbor cutoff
+   which = relation of CJ to CI, determines which atom pairs are stored
+------------------------------------------------------------------------- */
+
+void NPairHalfClusterNewton::add_pair(NeighList *list, int ci, int cj, int which, int &npair)
+{
+  const int cs = list->cluster;
+
+  // prune by distance between the cluster bounding boxes
+
+  const double *bi = cbox[ci];
+  const double *bj = cbox[cj];
+  double rsq = 0.0;
+  for (int d = 0; d < 3; d++) {
+    double del = MAX(bj[d]-bi[d+3],bi[d]-bj[d+3]);
+    if (del > 0.0) rsq += del*del;
+  }
+  if (rsq > cutmaxsq) return;
+
+  double **x = atom->x;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  tagint *molecule = atom->molecule;
+  const int *iatom = &list->clusteratom[ci*cs];
+  const int *jatom = &list->clusteratom[cj*cs];
+
+  uint64_t pairmask = 0;
+  for (int ii = 0; ii < cs; ii++) {
+    const int i = iatom[ii];
+    if (i < 0) continue;
+    const int itype = type[i];
+    const double xtmp = x[i][0];
+    const double ytmp = x[i][1];
+    const double ztmp = x[i][2];
+
+    for (int jj = (which == SAMECLUSTER) ? ii+1 : 0; jj < cs; jj++) {
+      const int j = jatom[jj];
+      if (j < 0) continue;
+
+      if (which == SAMEBINGHOST) {
+        if (x[j][2] < ztmp) continue;
+        if (x[j][2] == ztmp) {
+          if (x[j][1] < ytmp) continue;
+          if (x[j][1] == ytmp && x[j][0] < xtmp) continue;
+        }
+      }
+
+      const int jtype = type[j];
+      if (exclude && exclusion(i,j,itype,jtype,mask,molecule)) continue;
+
+      const double delx = xtmp - x[j][0];
+      const double dely = ytmp - x[j][1];
+      const double delz = ztmp - x[j][2];
+      rsq = delx*delx + dely*dely + delz*delz;
+      if (rsq <= cutneighsq[itype][jtype])
+        pairmask |= ((uint64_t) 1) << (ii*cs + jj);
+    }
+  }
+
+  if (pairmask == 0) return;
+
+  if (npair == list->maxcpair) list->grow_cluster_pair(npair+1);
+  list->cjlist[npair] = cj;
+  list->cjmask[npair] = pairmask;
+  npair++;
+}
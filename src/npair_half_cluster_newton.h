@@ -0,0 +1,59 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef NPAIR_CLASS
+// clang-format off
+NPairStyle(half/cluster/newton,
+           NPairHalfClusterNewton,
+           NP_HALF | NP_CLUSTER | NP_ATOMONLY | NP_NEWTON | NP_ORTHO);
+// clang-format on
+#else
+
+#ifndef LMP_NPAIR_HALF_CLUSTER_NEWTON_H
+#define LMP_NPAIR_HALF_CLUSTER_NEWTON_H
+
+#include "npair.h"
+
+namespace LAMMPS_NS {
+
+class NPairHalfClusterNewton : public NPair {
+ public:
+  NPairHalfClusterNewton(class LAMMPS *);
+  ~NPairHalfClusterNewton() override;
+  void build(class NeighList *) override;
+
+ protected:
+  int maxbin;          // size of per-bin arrays
+  int *bincfirst;      // 1st cluster of owned atoms in each bin
+  int *bincnum;        // # of clusters of owned atoms in each bin
+  int *bingfirst;      // 1st cluster of ghost atoms in each bin
+  int *bingnum;        // # of clusters of ghost atoms in each bin
+
+  int maxcbox;         // size of cluster bounding box array
+  double **cbox;       // xlo,ylo,zlo,xhi,yhi,zhi of each cluster
+
+  double cutmaxsq;     // max neighbor cutoff squared
+
+  int maxsort;         // size of sort buffer
+  int *sortatom;       // atoms of one bin
+  int *sortcol;        // xy column of each atom in sortatom
+  int *sortperm;       // sorted order of sortatom
+
+  int fill_clusters(class NeighList *, int, int, int &, int, int);
+  void add_pair(class NeighList *, int, int, int, int &);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -85,6 +85,7 @@ Output::Output(LAMMPS *lmp) : Pointers(lmp)
   var_dump = nullptr;
   ivar_dump = nullptr;
   dump = nullptr;
+  dump_threaded = 0;
 
   restart_flag = restart_flag_single = restart_flag_double = 0;
   restart_every_single = restart_every_double = 0;
@@ -121,7 +122,10 @@ Output::~Output()
   for (int i = 0; i < ndump; i++) delete[] var_dump[i];
   memory->sfree(var_dump);
   memory->destroy(ivar_dump);
-  for (int i = 0; i < ndump; i++) delete dump[i];
+  for (int i = 0; i < ndump; i++) {
+    dump[i]->wait_async();
+    delete dump[i];
+  }
   memory->sfree(dump);
 
   delete[] restart1;
@@ -819,6 +823,7 @@ void Output::delete_dump(char *id)
     if (strcmp(id,dump[idump]->id) == 0) break;
   if (idump == ndump) error->all(FLERR,"Could not find undump ID");
 
+  dump[idump]->wait_async();
   delete dump[idump];
   delete[] var_dump[idump];
 
@@ -47,6 +47,7 @@ class Output : protected Pointers {
   char **var_dump;              // variable name for next dump (steps or sim time)
   int *ivar_dump;               // variable index of var_dump name
   Dump **dump;                  // list of defined Dumps
+  int dump_threaded;            // 1 if text dumps format lines with threads
 
   int restart_flag;               // 1 if any restart files are written
   int restart_flag_single;        // 1 if single restart files are written
@@ -62,6 +62,9 @@ Pair::Pair(LAMMPS *lmp) : Pointers(lmp)
   single_hessian_enable = 0;
   restartinfo = 1;
   respa_enable = 0;
+  cluster_enable = 0;
+  overlap_enable = 0;
+  soa_enable = 0;
   one_coeff = 0;
   no_virial_fdotr_compute = 0;
   writedata = 0;
@@ -56,6 +56,9 @@ class Pair : protected Pointers {
   int single_hessian_enable;      // 1 if single_hessian() routine exists
   int restartinfo;                // 1 if pair style writes restart info
   int respa_enable;               // 1 if inner/middle/outer rRESPA routines
+  int cluster_enable;             // 1 if compute() supports cluster pair lists
+  int overlap_enable;             // 1 if compute() can be split across parts of its list
+  int soa_enable;                 // 1 if compute() reads coords from Atom::xsoa
   int one_coeff;                  // 1 if allows only one coeff * * call
   int manybody_flag;              // 1 if a manybody potential
   int unit_convert_flag;          // value != 0 indicates support for unit conversion.
@@ -397,12 +397,14 @@ void PairHybrid::flags()
   // ewaldflag, pppmflag, msmflag, dipoleflag, dispersionflag, tip4pflag = 1
   //   if any sub-style is set
   // compute_flag = 1 if any sub-style is set
+  // soa_enable = 1 if any sub-style is set
 
   single_enable = 0;
   compute_flag = 0;
   respa_enable = 0;
   restartinfo = 0;
   born_matrix_enable = 0;
+  soa_enable = 0;
 
   for (m = 0; m < nstyles; m++) {
     if (styles[m]->single_enable) ++single_enable;
@@ -421,6 +423,7 @@ void PairHybrid::flags()
     if (styles[m]->tip4pflag) tip4pflag = 1;
     if (styles[m]->compute_flag) compute_flag = 1;
     if (styles[m]->finitecutflag) finitecutflag = 1;
+    if (styles[m]->soa_enable) soa_enable = 1;
   }
   single_enable = (single_enable == nstyles) ? 1 : 0;
   respa_enable = (respa_enable == nstyles) ? 1 : 0;
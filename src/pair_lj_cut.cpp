@@ -39,8 +39,13 @@ using namespace MathConst;
 PairLJCut::PairLJCut(LAMMPS *lmp) : Pair(lmp)
 {
   respa_enable = 1;
+  cluster_enable = 1;
+  overlap_enable = 1;
+  soa_enable = 1;
   born_matrix_enable = 1;
   writedata = 1;
+  maxjbuf = 0;
+  jbuf = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -49,6 +54,8 @@ PairLJCut::~PairLJCut()
 {
   if (copymode) return;
 
+  memory->destroy(jbuf);
+
   if (allocated) {
     memory->destroy(setflag);
     memory->destroy(cutsq);
@@ -76,6 +83,41 @@ void PairLJCut::compute(int eflag, int vflag)
   evdwl = 0.0;
   ev_init(eflag, vflag);
 
+  // cluster pair list from neighbor style cluster
+
+  if (list->cluster == 8) {
+    if (evflag) {
+      if (eflag) eval_cluster<1, 1, 8>();
+      else eval_cluster<1, 0, 8>();
+    } else eval_cluster<0, 0, 8>();
+    return;
+  } else if (list->cluster) {
+    if (evflag) {
+      if (eflag) eval_cluster<1, 1, 4>();
+      else eval_cluster<1, 0, 4>();
+    } else eval_cluster<0, 0, 4>();
+    return;
+  }
+
+  // structure-of-arrays coords from atom_modify soa yes
+
+  if (atom->soa_active) {
+    if (evflag) {
+      if (eflag) {
+        if (force->newton_pair) eval_soa<1, 1, 1>();
+        else eval_soa<1, 1, 0>();
+      } else {
+        if (force->newton_pair) eval_soa<1, 0, 1>();
+        else eval_soa<1, 0, 0>();
+      }
+    } else {
+      if (force->newton_pair) eval_soa<0, 0, 1>();
+      else eval_soa<0, 0, 0>();
+    }
+    if (vflag_fdotr) virial_fdotr_compute();
+    return;
+  }
+
   double **x = atom->x;
   double **f = atom->f;
   int *type = atom->type;
@@ -138,6 +180,255 @@ void PairLJCut::compute(int eflag, int vflag)
   if (vflag_fdotr) virial_fdotr_compute();
 }
 
+/* ----------------------------------------------------------------------
+   compute forces from a cluster pair list, always with newton on
+   inner loop over the atoms of the J cluster has fixed length
+     and no dependencies, so it can be vectorized by the compiler
+   pairs not stored or outside the cutoff are masked to zero force
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG, int CLUSTERSIZE> void PairLJCut::eval_cluster()
+{
+  constexpr int CS = CLUSTERSIZE;
+  double evdwl = 0.0;
+
+  double **f = atom->f;
+  const int nlocal = atom->nlocal;
+
+  list->pack_cluster_x();
+
+  const int nclocal = list->nclocal;
+  const double *_noalias const xcluster = list->xcluster;
+  const int *_noalias const clusteratom = list->clusteratom;
+  const int *_noalias const clustertype = list->clustertype;
+  const int *_noalias const firstcj = list->firstcj;
+  const int *_noalias const numcj = list->numcj;
+  const int *_noalias const cjlist = list->cjlist;
+  const uint64_t *_noalias const cjmask = list->cjmask;
+
+  for (int ci = 0; ci < nclocal; ci++) {
+    const double *_noalias const xi = &xcluster[3 * CS * ci];
+    const int *const iatom = &clusteratom[CS * ci];
+    const int *const itype = &clustertype[CS * ci];
+
+    double fxi[CS], fyi[CS], fzi[CS];
+    for (int ii = 0; ii < CS; ii++) fxi[ii] = fyi[ii] = fzi[ii] = 0.0;
+
+    const int kfirst = firstcj[ci];
+    const int klast = kfirst + numcj[ci];
+
+    for (int k = kfirst; k < klast; k++) {
+      const int cj = cjlist[k];
+      const uint64_t mask = cjmask[k];
+      const double *_noalias const xj = &xcluster[3 * CS * cj];
+      const int *const jatom = &clusteratom[CS * cj];
+      const int *const jtype = &clustertype[CS * cj];
+
+      double fxj[CS], fyj[CS], fzj[CS];
+      for (int jj = 0; jj < CS; jj++) fxj[jj] = fyj[jj] = fzj[jj] = 0.0;
+
+      for (int ii = 0; ii < CS; ii++) {
+        const double *const cutsqi = cutsq[itype[ii]];
+        const double *const lj1i = lj1[itype[ii]];
+        const double *const lj2i = lj2[itype[ii]];
+
+        const uint64_t maski = mask >> (ii * CS);
+        double cutsqj[CS], lj1j[CS], lj2j[CS], fpairj[CS];
+        bool insidej[CS];
+
+        // gather per-type coefficients so the force loop has unit stride
+
+        for (int jj = 0; jj < CS; jj++) {
+          const int jt = jtype[jj];
+          cutsqj[jj] = ((maski >> jj) & 1) ? cutsqi[jt] : 0.0;
+          lj1j[jj] = lj1i[jt];
+          lj2j[jj] = lj2i[jt];
+        }
+
+        for (int jj = 0; jj < CS; jj++) {
+          const double delx = xi[ii] - xj[jj];
+          const double dely = xi[CS + ii] - xj[CS + jj];
+          const double delz = xi[2 * CS + ii] - xj[2 * CS + jj];
+          const double rsq = delx * delx + dely * dely + delz * delz;
+          const bool inside = rsq < cutsqj[jj];
+
+          const double r2inv = inside ? 1.0 / rsq : 0.0;
+          const double r6inv = r2inv * r2inv * r2inv;
+          const double fpair = r6inv * (lj1j[jj] * r6inv - lj2j[jj]) * r2inv;
+          if (EVFLAG) {
+            fpairj[jj] = fpair;
+            insidej[jj] = inside;
+          }
+
+          fxi[ii] += delx * fpair;
+          fyi[ii] += dely * fpair;
+          fzi[ii] += delz * fpair;
+          fxj[jj] -= delx * fpair;
+          fyj[jj] -= dely * fpair;
+          fzj[jj] -= delz * fpair;
+        }
+
+        // tally in a separate loop to keep the force loop free of branches
+
+        if (EVFLAG) {
+          for (int jj = 0; jj < CS; jj++) {
+            if (!insidej[jj]) continue;
+            const double delx = xi[ii] - xj[jj];
+            const double dely = xi[CS + ii] - xj[CS + jj];
+            const double delz = xi[2 * CS + ii] - xj[2 * CS + jj];
+            if (EFLAG) {
+              const int it = itype[ii];
+              const int jt = jtype[jj];
+              const double rsq = delx * delx + dely * dely + delz * delz;
+              const double r2inv = 1.0 / rsq;
+              const double r6inv = r2inv * r2inv * r2inv;
+              evdwl = r6inv * (lj3[it][jt] * r6inv - lj4[it][jt]) - offset[it][jt];
+            }
+            ev_tally(iatom[ii], jatom[jj], nlocal, 1, evdwl, 0.0, fpairj[jj], delx, dely, delz);
+          }
+        }
+      }
+
+      for (int jj = 0; jj < CS; jj++) {
+        const int j = jatom[jj];
+        if (j < 0) continue;
+        f[j][0] += fxj[jj];
+        f[j][1] += fyj[jj];
+        f[j][2] += fzj[jj];
+      }
+    }
+
+    for (int ii = 0; ii < CS; ii++) {
+      const int i = iatom[ii];
+      if (i < 0) continue;
+      f[i][0] += fxi[ii];
+      f[i][1] += fyi[ii];
+      f[i][2] += fzi[ii];
+    }
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   displacements, force/r, and energy of all neighbors of one atom
+   rsq is stored relative to the cutoff, so rsq < 0.0 means inside
+   no branches and no writes to per-atom arrays, so loop can be vectorized
+------------------------------------------------------------------------- */
+
+template <int EFLAG>
+static void lj_soa_neighbors(const int jnum, const int *_noalias const jlist,
+                             const int *_noalias const type, const double *_noalias const xs,
+                             const double *_noalias const ys, const double *_noalias const zs,
+                             const double xtmp, const double ytmp, const double ztmp,
+                             const double *_noalias const special_lj,
+                             const double *_noalias const cutsqi, const double *_noalias const lj1i,
+                             const double *_noalias const lj2i, const double *_noalias const lj3i,
+                             const double *_noalias const lj4i, const double *_noalias const offseti,
+                             double *_noalias const bdelx, double *_noalias const bdely,
+                             double *_noalias const bdelz, double *_noalias const brsq,
+                             double *_noalias const bfpair, double *_noalias const bevdwl)
+{
+  for (int jj = 0; jj < jnum; jj++) {
+    const int j = jlist[jj] & NEIGHMASK;
+    const double factor_lj = special_lj[jlist[jj] >> SBBITS & 3];
+    const int jtype = type[j];
+    const double delx = xtmp - xs[j];
+    const double dely = ytmp - ys[j];
+    const double delz = ztmp - zs[j];
+    const double rsq = delx * delx + dely * dely + delz * delz;
+    const double r2inv = 1.0 / rsq;
+    const double r6inv = r2inv * r2inv * r2inv;
+    const double fpair = factor_lj * r6inv * (lj1i[jtype] * r6inv - lj2i[jtype]) * r2inv;
+    bdelx[jj] = delx;
+    bdely[jj] = dely;
+    bdelz[jj] = delz;
+    brsq[jj] = rsq - cutsqi[jtype];
+    bfpair[jj] = (rsq < cutsqi[jtype]) ? fpair : 0.0;
+    if (EFLAG)
+      bevdwl[jj] = factor_lj * (r6inv * (lj3i[jtype] * r6inv - lj4i[jtype]) - offseti[jtype]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   compute forces using structure-of-arrays copy of coords
+   1st pass over neighbors of atom i fills per-neighbor buffers
+   2nd pass accumulates forces and tallies energy/virial
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG, int NEWTON_PAIR> void PairLJCut::eval_soa()
+{
+  int i, j, ii, jj, jnum, itype;
+  double xtmp, ytmp, ztmp, fpair;
+  double fxtmp, fytmp, fztmp;
+
+  const double *_noalias const xs = atom->xsoa[0];
+  const double *_noalias const ys = atom->xsoa[1];
+  const double *_noalias const zs = atom->xsoa[2];
+  double **f = atom->f;
+  const int *_noalias const type = atom->type;
+  const int nlocal = atom->nlocal;
+  const double *_noalias const special_lj = force->special_lj;
+  double evdwl = 0.0;
+
+  const int inum = list->inum;
+  const int *_noalias const ilist = list->ilist;
+  const int *_noalias const numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  // per-neighbor buffers must hold the longest neighbor list
+
+  jnum = 0;
+  for (ii = 0; ii < inum; ii++) jnum = MAX(jnum, numneigh[ilist[ii]]);
+  if (jnum > maxjbuf) {
+    maxjbuf = jnum;
+    memory->destroy(jbuf);
+    memory->create(jbuf, 6, maxjbuf, "pair:jbuf");
+  }
+
+  double *_noalias const bdelx = jbuf[0];
+  double *_noalias const bdely = jbuf[1];
+  double *_noalias const bdelz = jbuf[2];
+  double *_noalias const brsq = jbuf[3];
+  double *_noalias const bfpair = jbuf[4];
+  double *_noalias const bevdwl = jbuf[5];
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    xtmp = xs[i];
+    ytmp = ys[i];
+    ztmp = zs[i];
+    itype = type[i];
+    const int *_noalias const jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    lj_soa_neighbors<EFLAG>(jnum, jlist, type, xs, ys, zs, xtmp, ytmp, ztmp, special_lj,
+                            cutsq[itype], lj1[itype], lj2[itype], lj3[itype], lj4[itype],
+                            offset[itype], bdelx, bdely, bdelz, brsq, bfpair, bevdwl);
+
+    fxtmp = fytmp = fztmp = 0.0;
+    for (jj = 0; jj < jnum; jj++) {
+      if (brsq[jj] >= 0.0) continue;
+      j = jlist[jj] & NEIGHMASK;
+      fpair = bfpair[jj];
+      fxtmp += bdelx[jj] * fpair;
+      fytmp += bdely[jj] * fpair;
+      fztmp += bdelz[jj] * fpair;
+      if (NEWTON_PAIR || j < nlocal) {
+        f[j][0] -= bdelx[jj] * fpair;
+        f[j][1] -= bdely[jj] * fpair;
+        f[j][2] -= bdelz[jj] * fpair;
+      }
+      if (EFLAG) evdwl = bevdwl[jj];
+      if (EVFLAG)
+        ev_tally(i, j, nlocal, NEWTON_PAIR, evdwl, 0.0, fpair, bdelx[jj], bdely[jj], bdelz[jj]);
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void PairLJCut::compute_inner()
@@ -483,6 +774,7 @@ void PairLJCut::init_style()
     if (respa->level_inner >= 0) list_style = NeighConst::REQ_RESPA_INOUT;
     if (respa->level_middle >= 0) list_style = NeighConst::REQ_RESPA_ALL;
   }
+  if (cluster_enable) list_style |= NeighConst::REQ_CLUSTER;
   neighbor->add_request(this, list_style);
 
   // set rRESPA cutoffs
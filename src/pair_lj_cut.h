@@ -54,7 +54,13 @@ class PairLJCut : public Pair {
   double **lj1, **lj2, **lj3, **lj4, **offset;
   double *cut_respa;
 
+  int maxjbuf;       // length of per-neighbor buffers
+  double **jbuf;     // delx,dely,delz,rsq,fpair,evdwl of neighbors of one atom
+
   virtual void allocate();
+
+  template <int EVFLAG, int EFLAG, int CLUSTERSIZE> void eval_cluster();
+  template <int EVFLAG, int EFLAG, int NEWTON_PAIR> void eval_soa();
 };
 
 }    // namespace LAMMPS_NS
@@ -17,6 +17,7 @@
 #include "irregular.h"
 #include "memory.h"
 
+#include <cmath>
 #include <cstring>
 
 using namespace LAMMPS_NS;
@@ -24,6 +25,7 @@ using namespace LAMMPS_NS;
 #define MYHUGE 1.0e30
 #define TINY 1.0e-6
 #define DELTA 16384
+#define NGRAPHBIN 1024
 
 // prototypes for non-class functions
 
@@ -48,11 +50,16 @@ RCB::RCB(LAMMPS *lmp) : Pointers(lmp)
   maxbuf = 0;
   buf = nullptr;
 
+  spanflag = 0;
+  maxspan = maxspanbuf = 0;
+  dotspan = spanbuf = nullptr;
+
   maxrecv = maxsend = 0;
   recvproc = recvindex = sendproc = sendindex = nullptr;
 
   tree = nullptr;
   irregular = nullptr;
+  graphme = graphall = nullptr;
 
   // create MPI data and function types for box and median AllReduce ops
 
@@ -76,6 +83,8 @@ RCB::~RCB()
   memory->destroy(dotmark);
   memory->destroy(dotmark_select);
   memory->sfree(buf);
+  memory->destroy(dotspan);
+  memory->destroy(spanbuf);
 
   memory->destroy(recvproc);
   memory->destroy(recvindex);
@@ -84,6 +93,8 @@ RCB::~RCB()
 
   memory->sfree(tree);
   delete irregular;
+  memory->destroy(graphme);
+  memory->destroy(graphall);
 
   MPI_Type_free(&med_type);
   MPI_Type_free(&box_type);
@@ -98,6 +109,9 @@ RCB::~RCB()
      this is to prevent very narrow boxes from being produced
    if wt = nullptr, ignore per-particle weights
    if wt defined, per-particle weights > 0.0
+   if span defined, lo/hi extent of each particle and its bonded partners
+     each cut is shifted within spantol of average weight per proc
+     to where it splits the fewest spans, see graph_cut()
    dimension = 2 or 3
    as documented in rcb.h:
      sets noriginal,nfinal,nkeep,recvproc,recvindex,lo,hi
@@ -107,7 +121,7 @@ RCB::~RCB()
 ------------------------------------------------------------------------- */
 
 void RCB::compute(int dimension, int n, double **x, double *wt,
-                  double *bboxlo, double *bboxhi)
+                  double *bboxlo, double *bboxhi, double **span, double spantol)
 {
   int i,j,k;
   int keep,outgoing,incoming,incoming2;
@@ -119,7 +133,7 @@ void RCB::compute(int dimension, int n, double **x, double *wt,
   double valuemin,valuemax,valuehalf,valuehalf_select,smaller;
   double tolerance;
   MPI_Comm comm,comm_half;
-  MPI_Request request,request2;
+  MPI_Request request,request2,requestspan,requestspan2;
   Median med,medme;
 
   // create list of my Dots
@@ -145,6 +159,18 @@ void RCB::compute(int dimension, int n, double **x, double *wt,
   else
     for (i = 0; i < ndot; i++) dots[i].wt = 1.0;
 
+  // spans are kept outside of Dot, so plain RCB does not carry them around
+
+  spanflag = (span != nullptr);
+  if (spanflag) {
+    if (maxdot > maxspan) {
+      maxspan = maxdot;
+      memory->destroy(dotspan);
+      memory->create(dotspan,6*maxspan,"RCB:dotspan");
+    }
+    for (i = 0; i < ndot; i++) memcpy(&dotspan[6*i],span[i],6*sizeof(double));
+  }
+
   // initial bounding box = simulation box
   // includes periodic or shrink-wrapped boundaries
 
@@ -455,6 +481,20 @@ void RCB::compute(int dimension, int n, double **x, double *wt,
         nlist = k;
       }
 
+      // if spans are defined, shift cut to where it splits fewer bonds
+      // while staying within spantol of average weight per proc
+      // if cut moved, re-mark all dots
+
+      if (spanflag) {
+        double graphcut = graph_cut(dim,valuehalf,targetlo,
+                                    spantol*wttot/(procupper+1-proclower),comm);
+        if (graphcut != valuehalf) {
+          valuehalf = graphcut;
+          for (i = 0; i < ndot; i++)
+            dotmark[i] = (dots[i].x[dim] <= valuehalf) ? 0 : 1;
+        }
+      }
+
       // cut produces 2 sub-boxes with reduced size in dim
       // compare smaller of the 2 sizes to previous dims
       // keep dim that has the largest smaller
@@ -534,6 +574,10 @@ void RCB::compute(int dimension, int n, double **x, double *wt,
       dots = (Dot *) memory->srealloc(dots,maxdot*sizeof(Dot),"RCB::dots");
       counters[6]++;
     }
+    if (spanflag && maxdot > maxspan) {
+      maxspan = maxdot;
+      memory->grow(dotspan,6*maxspan,"RCB:dotspan");
+    }
 
     counters[1] += outgoing;
     counters[2] += incoming;
@@ -547,27 +591,42 @@ void RCB::compute(int dimension, int n, double **x, double *wt,
       maxbuf = outgoing;
       buf = (Dot *) memory->smalloc(maxbuf*sizeof(Dot),"RCB:buf");
     }
+    if (spanflag && outgoing > maxspanbuf) {
+      memory->destroy(spanbuf);
+      maxspanbuf = outgoing;
+      memory->create(spanbuf,6*maxspanbuf,"RCB:spanbuf");
+    }
 
     // fill buffer with dots that are marked for sending
     // pack down the unmarked ones
+    // spans follow their dots
 
     keep = outgoing = 0;
     for (i = 0; i < ndot; i++) {
-      if (dotmark[i] == markactive)
+      if (dotmark[i] == markactive) {
+        if (spanflag) memcpy(&spanbuf[6*outgoing],&dotspan[6*i],6*sizeof(double));
         memcpy(&buf[outgoing++],&dots[i],sizeof(Dot));
-      else
+      } else {
+        if (spanflag) memmove(&dotspan[6*keep],&dotspan[6*i],6*sizeof(double));
         memmove(&dots[keep++],&dots[i],sizeof(Dot));
+      }
     }
 
-    // post receives for dots
+    // post receives for dots and their spans
 
     if (readnumber > 0) {
       MPI_Irecv(&dots[keep],incoming*sizeof(Dot),MPI_CHAR,
                 procpartner,1,world,&request);
+      if (spanflag)
+        MPI_Irecv(&dotspan[6*keep],6*incoming,MPI_DOUBLE,
+                  procpartner,2,world,&requestspan);
       if (readnumber == 2) {
         keep += incoming - incoming2;
         MPI_Irecv(&dots[keep],incoming2*sizeof(Dot),MPI_CHAR,
                   procpartner2,1,world,&request2);
+        if (spanflag)
+          MPI_Irecv(&dotspan[6*keep],6*incoming2,MPI_DOUBLE,
+                    procpartner2,2,world,&requestspan2);
       }
     }
 
@@ -582,12 +641,17 @@ void RCB::compute(int dimension, int n, double **x, double *wt,
     // send dots to partner
 
     MPI_Rsend(buf,outgoing*sizeof(Dot),MPI_CHAR,procpartner,1,world);
+    if (spanflag) MPI_Rsend(spanbuf,6*outgoing,MPI_DOUBLE,procpartner,2,world);
 
     // wait until all dots are received
 
     if (readnumber > 0) {
       MPI_Wait(&request,MPI_STATUS_IGNORE);
       if (readnumber == 2) MPI_Wait(&request2,MPI_STATUS_IGNORE);
+      if (spanflag) {
+        MPI_Wait(&requestspan,MPI_STATUS_IGNORE);
+        if (readnumber == 2) MPI_Wait(&requestspan2,MPI_STATUS_IGNORE);
+      }
     }
 
     ndot = ndotnew;
@@ -630,6 +694,83 @@ void RCB::compute(int dimension, int n, double **x, double *wt,
   }
 }
 
+/* ----------------------------------------------------------------------
+   find cut in dim that splits the fewest dot spans
+   dot span is split if cut is strictly inside its lo/hi extent in dim
+   candidates = NGRAPHBIN-1 equidistant positions inside current box
+     whose lower weight is within wttol of targetlo
+   histograms of dot weight and of split spans are summed across partition
+   return median cut if no candidate splits fewer spans than it does
+------------------------------------------------------------------------- */
+
+double RCB::graph_cut(int dim, double valuehalf, double targetlo, double wttol,
+                      MPI_Comm comm)
+{
+  const int nbuf = 2*NGRAPHBIN + 2;
+  double delta = (hi[dim] - lo[dim]) / NGRAPHBIN;
+  if (delta <= 0.0) return valuehalf;
+
+  if (!graphme) {
+    memory->create(graphme,nbuf,"RCB:graphme");
+    memory->create(graphall,nbuf,"RCB:graphall");
+  }
+
+  // graphme[0:NGRAPHBIN) = weight of dots in each bin
+  // graphme[NGRAPHBIN:2*NGRAPHBIN] = change in # of split spans at each bin edge
+  // graphme[2*NGRAPHBIN+1] = # of spans split by median cut
+
+  for (int m = 0; m < nbuf; m++) graphme[m] = 0.0;
+  double *split = &graphme[NGRAPHBIN];
+
+  for (int i = 0; i < ndot; i++) {
+    double *s = &dotspan[6*i];
+    int ibin = static_cast<int>((dots[i].x[dim] - lo[dim]) / delta);
+    ibin = MAX(ibin,0);
+    ibin = MIN(ibin,NGRAPHBIN-1);
+    graphme[ibin] += dots[i].wt;
+
+    if (s[dim] == s[dim+3]) continue;
+    if (s[dim] < valuehalf && s[dim+3] > valuehalf) graphme[nbuf-1] += 1.0;
+
+    double first = floor((s[dim] - lo[dim]) / delta) + 1.0;
+    double last = ceil((s[dim+3] - lo[dim]) / delta) - 1.0;
+    int efirst = static_cast<int>(MAX(first,1.0));
+    int elast = static_cast<int>(MIN(last,NGRAPHBIN-1.0));
+    if (efirst <= elast) {
+      split[efirst] += 1.0;
+      split[elast+1] -= 1.0;
+    }
+  }
+
+  MPI_Allreduce(graphme,graphall,nbuf,MPI_DOUBLE,MPI_SUM,comm);
+  split = &graphall[NGRAPHBIN];
+
+  // scan bin edges, keep admissible one with fewest split spans
+  // ties are broken by smallest deviation from targetlo
+  // median cut counts as zero deviation, so a tie never moves the cut off it
+
+  double wtlo = graphall[0];
+  double nsplit = split[0];
+  double best = graphall[nbuf-1];
+  double bestdev = 0.0;
+  double bestcut = valuehalf;
+
+  for (int e = 1; e < NGRAPHBIN; e++) {
+    nsplit += split[e];
+    double dev = fabs(wtlo - targetlo);
+    if (dev <= wttol) {
+      if (nsplit < best || (nsplit == best && dev < bestdev)) {
+        best = nsplit;
+        bestdev = dev;
+        bestcut = lo[dim] + e*delta;
+      }
+    }
+    wtlo += graphall[e];
+  }
+
+  return bestcut;
+}
+
 /* ----------------------------------------------------------------------
    perform RCB balancing of N particles at coords X in bounding box LO/HI
    OLD version: each RCB cut is made in longest dimension of sub-box
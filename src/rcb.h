@@ -40,7 +40,8 @@ class RCB : protected Pointers {
 
   RCB(class LAMMPS *);
   ~RCB() override;
-  void compute(int, int, double **, double *, double *, double *);
+  void compute(int, int, double **, double *, double *, double *, double **span = nullptr,
+               double spantol = 0.0);
   void compute_old(int, int, double **, double *, double *, double *);
   void invert(int sortflag = 0);
   double memory_usage();
@@ -104,11 +105,21 @@ class RCB : protected Pointers {
   int maxbuf;
   Dot *buf;
 
+  // lo/hi extent of each dot and its bond partners, only with span
+
+  int spanflag;      // 1 if spans are defined for current compute()
+  int maxspan;       // allocated # of spans in dotspan
+  int maxspanbuf;    // allocated # of spans in spanbuf
+  double *dotspan;   // 6 values per dot, in same order as dots
+  double *spanbuf;   // comm buffer for spans, in same order as buf
+
   int maxrecv, maxsend;
 
   BBox bbox;
   class Irregular *irregular;
 
+  double *graphme, *graphall;    // histograms for connectivity-aware cuts
+
   MPI_Op box_op, med_op;
   MPI_Datatype box_type, med_type;
 
@@ -117,6 +128,8 @@ class RCB : protected Pointers {
   double bboxlo[3];    // bounding box of final RCB sub-domain
   double bboxhi[3];
   Tree *tree;         // tree of RCB cuts, used by reuse()
+  double graph_cut(int, double, double, double, MPI_Comm);
+
   int counters[7];    // diagnostic counts
                       // 0 = # of median iterations
                       // 1 = # of points sent
@@ -30,6 +30,7 @@
 #include "group.h"
 #include "improper.h"
 #include "irregular.h"
+#include "lmpdatabin.h"
 #include "memory.h"
 #include "modify.h"
 #include "molecule.h"
@@ -38,6 +39,7 @@
 #include "tokenizer.h"
 #include "update.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstring>
 #include <unordered_set>
@@ -49,6 +51,11 @@ static constexpr double LB_FACTOR = 1.1;
 static constexpr int CHUNK = 1024;
 static constexpr int DELTA = 4;    // must be 2 or larger
 static constexpr int MAXBODY = 32; // max # of lines in one body
+static constexpr bigint PBLOCK = 1 << 20;   // bytes one reader reads in 1st round
+static constexpr bigint PBLOCKMAX = 1 << 24; // bytes one reader reads per round, at most
+static constexpr double PEPSILON = 1.0e-5;  // must be larger than EPSILON in Atom
+static constexpr int BINCHUNK = 16384;      // rows of binary section read at a time
+static constexpr int RVOUS = 1;    // 0 for irregular, 1 for all2all
 
 // customize for new sections
 
@@ -73,6 +80,14 @@ bool ReadData::is_data_section(const std::string &keyword)
 
 // clang-format off
 enum{NONE,APPEND,VALUE,MERGE};
+enum{PATOMS,PVELOCITIES,PBONDS,PANGLES,PDIHEDRALS,PIMPROPERS,PSKIP};
+
+// datum for the atom ID -> owning proc directory
+
+struct OwnerRvous {
+  tagint atomID;
+  int proc;
+};
 
 // pair style suffixes to ignore
 // when matching Pair Coeffs comment to currently-defined pair style
@@ -94,6 +109,11 @@ ReadData::ReadData(LAMMPS *lmp) : Command(lmp)
   ncoeffarg = maxcoeffarg = 0;
   coeffarg = nullptr;
   fp = nullptr;
+  nreaders = 0;
+  ireader = -1;
+  pfp = nullptr;
+  dirowner = nullptr;
+  ndir = 0;
 
   // customize for new sections
   // pointers to atom styles that store bonus info
@@ -117,6 +137,8 @@ ReadData::~ReadData()
   delete [] style;
   delete [] buffer;
   memory->sfree(coeffarg);
+  memory->destroy(dirowner);
+  if (pfp) fclose(pfp);
 
   for (int i = 0; i < nfix; i++) {
     delete [] fix_header[i];
@@ -148,6 +170,7 @@ void ReadData::command(int narg, char **arg)
     extra_dihedral_types = extra_improper_types = 0;
 
   groupbit = 0;
+  nreaders = 0;
 
   nfix = 0;
   fix_index = nullptr;
@@ -282,6 +305,11 @@ void ReadData::command(int narg, char **arg)
       int igroup = group->find_or_create(arg[iarg+1]);
       groupbit = group->bitmask[igroup];
       iarg += 2;
+    } else if (strcmp(arg[iarg],"parallel") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal read_data command");
+      nreaders = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      if (nreaders < 0) error->all(FLERR,"Illegal read_data parallel value");
+      iarg += 2;
     } else if (strcmp(arg[iarg],"fix") == 0) {
       if (iarg+4 > narg)
         error->all(FLERR,"Illegal read_data command");
@@ -333,6 +361,22 @@ void ReadData::command(int narg, char **arg)
     error->all(FLERR,fmt::format("Cannot open file {}: {}",
                                  arg[0], utils::getsyserror()));
 
+  // setup for parallel reading of sections
+  // readers are spread evenly across procs, each opens the file itself
+
+  if (nreaders) {
+    if (platform::has_compress_extension(arg[0]))
+      error->all(FLERR,"Cannot use read_data parallel with compressed data file");
+    nreaders = MIN(nreaders,comm->nprocs);
+    int stride = comm->nprocs / nreaders;
+    ireader = -1;
+    if ((me % stride == 0) && (me / stride < nreaders)) ireader = me / stride;
+    if (ireader >= 0) {
+      pfp = fopen(arg[0],"rb");
+      if (!pfp) error->one(FLERR,"Cannot open file {}: {}", arg[0], utils::getsyserror());
+    }
+  }
+
   // reset so we can warn about reset image flags exactly once per data file
 
   atom->reset_image_flag[0] = atom->reset_image_flag[1] = atom->reset_image_flag[2] = false;
@@ -541,13 +585,13 @@ void ReadData::command(int narg, char **arg)
             error->warning(FLERR,"Atom style in data file differs "
                            "from currently defined atom style");
           atoms();
-        } else skip_lines(natoms);
+        } else skip_section(natoms);
 
       } else if (strcmp(keyword,"Velocities") == 0) {
         if (atomflag == 0)
           error->all(FLERR,"Must read Atoms before Velocities");
         if (firstpass) velocities();
-        else skip_lines(natoms);
+        else skip_section(natoms);
 
       } else if (strcmp(keyword,"Bonds") == 0) {
         topoflag = bondflag = 1;
@@ -794,6 +838,13 @@ void ReadData::command(int narg, char **arg)
     atom->avec->grow(atom->nmax);
   }
 
+  // done with parallel reading
+
+  if (pfp) fclose(pfp);
+  pfp = nullptr;
+  memory->destroy(dirowner);
+  dirowner = nullptr;
+
   // init per-atom fix/compute/variable values for created atoms
 
   atom->data_fix_compute_variable(nlocal_previous,atom->nlocal);
@@ -1196,12 +1247,25 @@ void ReadData::atoms()
 
   bigint nread = 0;
 
-  while (nread < natoms) {
-    nchunk = MIN(natoms-nread,CHUNK);
-    eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_atoms(nchunk,buffer,id_offset,mol_offset,toffset,shiftflag,shift);
-    nread += nchunk;
+  if (binary_header()) binary_section(natoms,PATOMS,nullptr);
+  else if (nreaders) parallel_section(natoms,PATOMS,nullptr);
+  else {
+    while (nread < natoms) {
+      nchunk = MIN(natoms-nread,CHUNK);
+      eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_atoms(nchunk,buffer,id_offset,mol_offset,toffset,shiftflag,shift);
+      nread += nchunk;
+    }
+  }
+
+  // with parallel reading, image flags were reset only on procs that received the atoms
+
+  if (nreaders) {
+    int flag[3],flagall[3];
+    for (int i = 0; i < 3; i++) flag[i] = atom->reset_image_flag[i] ? 1 : 0;
+    MPI_Allreduce(flag,flagall,3,MPI_INT,MPI_MAX,world);
+    for (int i = 0; i < 3; i++) atom->reset_image_flag[i] = (flagall[i] != 0);
   }
 
   // warn if we have read data with non-zero image flags for non-periodic boundaries.
@@ -1268,12 +1332,16 @@ void ReadData::velocities()
 
   bigint nread = 0;
 
-  while (nread < natoms) {
-    nchunk = MIN(natoms-nread,CHUNK);
-    eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_vels(nchunk,buffer,id_offset);
-    nread += nchunk;
+  if (binary_header()) binary_section(natoms,PVELOCITIES,nullptr);
+  else if (nreaders) parallel_section(natoms,PVELOCITIES,nullptr);
+  else {
+    while (nread < natoms) {
+      nchunk = MIN(natoms-nread,CHUNK);
+      eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_vels(nchunk,buffer,id_offset);
+      nread += nchunk;
+    }
   }
 
   if (mapflag) {
@@ -1310,12 +1378,16 @@ void ReadData::bonds(int firstpass)
 
   bigint nread = 0;
 
-  while (nread < nbonds) {
-    nchunk = MIN(nbonds-nread,CHUNK);
-    eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_bonds(nchunk,buffer,count,id_offset,boffset);
-    nread += nchunk;
+  if (binary_header()) binary_section(nbonds,PBONDS,count);
+  else if (nreaders) parallel_section(nbonds,PBONDS,count);
+  else {
+    while (nread < nbonds) {
+      nchunk = MIN(nbonds-nread,CHUNK);
+      eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_bonds(nchunk,buffer,count,id_offset,boffset);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max bond/atom and return
@@ -1384,12 +1456,16 @@ void ReadData::angles(int firstpass)
 
   bigint nread = 0;
 
-  while (nread < nangles) {
-    nchunk = MIN(nangles-nread,CHUNK);
-    eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_angles(nchunk,buffer,count,id_offset,aoffset);
-    nread += nchunk;
+  if (binary_header()) binary_section(nangles,PANGLES,count);
+  else if (nreaders) parallel_section(nangles,PANGLES,count);
+  else {
+    while (nread < nangles) {
+      nchunk = MIN(nangles-nread,CHUNK);
+      eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_angles(nchunk,buffer,count,id_offset,aoffset);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max angle/atom and return
@@ -1458,12 +1534,16 @@ void ReadData::dihedrals(int firstpass)
 
   bigint nread = 0;
 
-  while (nread < ndihedrals) {
-    nchunk = MIN(ndihedrals-nread,CHUNK);
-    eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_dihedrals(nchunk,buffer,count,id_offset,doffset);
-    nread += nchunk;
+  if (binary_header()) binary_section(ndihedrals,PDIHEDRALS,count);
+  else if (nreaders) parallel_section(ndihedrals,PDIHEDRALS,count);
+  else {
+    while (nread < ndihedrals) {
+      nchunk = MIN(ndihedrals-nread,CHUNK);
+      eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_dihedrals(nchunk,buffer,count,id_offset,doffset);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max dihedral/atom and return
@@ -1532,12 +1612,16 @@ void ReadData::impropers(int firstpass)
 
   bigint nread = 0;
 
-  while (nread < nimpropers) {
-    nchunk = MIN(nimpropers-nread,CHUNK);
-    eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_impropers(nchunk,buffer,count,id_offset,ioffset);
-    nread += nchunk;
+  if (binary_header()) binary_section(nimpropers,PIMPROPERS,count);
+  else if (nreaders) parallel_section(nimpropers,PIMPROPERS,count);
+  else {
+    while (nread < nimpropers) {
+      nchunk = MIN(nimpropers-nread,CHUNK);
+      eof = utils::read_lines_from_file(fp,nchunk,MAXLINE,buffer,me,world);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_impropers(nchunk,buffer,count,id_offset,ioffset);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max improper/atom and return
@@ -1957,7 +2041,7 @@ void ReadData::open(const std::string &file)
     if (!fp) error->one(FLERR,"Cannot open compressed file {}", file);
   } else {
     compressed = 0;
-    fp = fopen(file.c_str(),"r");
+    fp = fopen(file.c_str(),"rb");
     if (!fp) error->one(FLERR,"Cannot open file {}: {}", file, utils::getsyserror());
   }
 }
@@ -2127,3 +2211,726 @@ int ReadData::style_match(const char *one, const char *two)
   if ((len1 == 0) || (len1 == len2) || (strncmp(one,two,len1) == 0)) return 1;
   return 0;
 }
+
+/* ----------------------------------------------------------------------
+   read N lines of a section in parallel, starting at current position of proc 0
+   in each round, every reader reads one block of the same size,
+     blocks of one round are consecutive in the file in order of reader rank
+   block size doubles every round from PBLOCK up to PBLOCKMAX,
+     so large sections need few rounds of collectives and routing
+   lines are numbered by the block they start in via MPI_Scan,
+     lines after the end of the section are ignored
+   which = section the lines are routed to other procs for, PSKIP = none
+   afterwards proc 0 file pointer is positioned at end of section
+     and the end is remembered, so a later pass can skip the section
+------------------------------------------------------------------------- */
+
+void ReadData::parallel_section(bigint nsection, int which, int *count)
+{
+  bigint start = 0;
+  if (me == 0) start = platform::ftell(fp);
+  MPI_Bcast(&start,1,MPI_LMP_BIGINT,0,world);
+
+  if ((which != PATOMS) && (which != PSKIP) && !dirowner) directory();
+
+  std::vector<char> block;
+  std::vector<int> lines;
+  bigint nread = 0;
+  bigint end = -1;
+  bigint offset = 0;
+  bigint roundstart = start;
+  bigint blocksize = PBLOCK;
+
+  while (nread < nsection) {
+    bigint nme = 0;
+    if (ireader >= 0)
+      nme = read_block(start,roundstart+ireader*blocksize,blocksize,block,lines,offset);
+
+    bigint nbefore,ntotal;
+    MPI_Scan(&nme,&nbefore,1,MPI_LMP_BIGINT,MPI_SUM,world);
+    MPI_Allreduce(&nme,&ntotal,1,MPI_LMP_BIGINT,MPI_SUM,world);
+    if (ntotal == 0) error->all(FLERR,"Unexpected end of data file");
+
+    // first = index within section of my first line
+    // nuse = # of my lines that belong to section
+    // reader of last line of section stores where the section ends
+
+    bigint first = nread + nbefore - nme;
+    int nuse = 0;
+    if (first < nsection) nuse = MIN(nme,nsection-first);
+    if (nuse && (first+nuse == nsection)) {
+      const char *ptr = &block[lines[nuse-1]];
+      auto eol = (const char *) memchr(ptr,'\n',block.size()-lines[nuse-1]);
+      if (eol) end = offset + (eol-block.data()) + 1;
+      else end = offset + block.size();
+    }
+
+    if (which != PSKIP) parallel_route(which,block,lines,nuse,first,count);
+
+    nread += ntotal;
+    roundstart += nreaders*blocksize;
+    blocksize = MIN(2*blocksize,PBLOCKMAX);
+  }
+
+  bigint endall;
+  MPI_Allreduce(&end,&endall,1,MPI_LMP_BIGINT,MPI_MAX,world);
+  if (me == 0) platform::fseek(fp,endall);
+  sectionend[start] = endall;
+}
+
+/* ----------------------------------------------------------------------
+   reader reads block of BSIZE bytes at offset bstart of file
+   start = offset of section, a line always starts there
+   preceding byte is also read to detect if a line starts at bstart
+   last line is completed if it extends beyond the block
+   offset = file offset of block[0]
+   lines = indices into block of all lines that start within the block
+   return # of lines
+------------------------------------------------------------------------- */
+
+int ReadData::read_block(bigint start, bigint bstart, bigint bsize, std::vector<char> &block,
+                         std::vector<int> &lines, bigint &offset)
+{
+  offset = (bstart > start) ? bstart-1 : bstart;
+  const int nskip = bstart - offset;
+  const int nmax = bsize + nskip;
+
+  block.resize(nmax);
+  lines.clear();
+  int n = 0;
+  if (platform::fseek(pfp,offset) == 0) n = fread(block.data(),1,nmax,pfp);
+  block.resize(n);
+
+  if ((n == nmax) && (block[n-1] != '\n')) {
+    int c;
+    while ((c = fgetc(pfp)) != EOF) {
+      block.push_back((char) c);
+      if (c == '\n') break;
+    }
+  }
+
+  for (int i = nskip; i < n; i++)
+    if ((i == 0) || (block[i-1] == '\n')) lines.push_back(i);
+
+  return lines.size();
+}
+
+/* ----------------------------------------------------------------------
+   send my first NUSE lines to the procs that process them
+   first = index of my first line within section
+   atoms go to all procs whose sub-domain may contain them
+   velocities and topology go to the owners of their atoms via directory
+   received lines are sorted into file order and processed
+     by the same Atom methods as lines read by proc 0
+------------------------------------------------------------------------- */
+
+void ReadData::parallel_route(int which, std::vector<char> &block, std::vector<int> &lines,
+                              int nuse, bigint first, int *count)
+{
+  int nprocs = comm->nprocs;
+
+  // lines are truncated the same as with utils::fgets_trunc()
+
+  std::vector<std::string> text(nuse);
+  for (int i = 0; i < nuse; i++) {
+    const char *ptr = &block[lines[i]];
+    auto eol = (const char *) memchr(ptr,'\n',block.size()-lines[i]);
+    int len = eol ? (eol-ptr) : (block.data()+block.size()-ptr);
+    text[i] = std::string(ptr,MIN(len,MAXLINE-2));
+  }
+
+  // dest = (proc, line) pairs for all lines I send
+
+  std::vector<std::pair<int,int>> dest;
+  std::vector<int> procs;
+
+  if (which == PATOMS) {
+    for (int i = 0; i < nuse; i++) {
+      atom_procs(text[i],procs);
+      for (auto proc : procs) dest.emplace_back(proc,i);
+    }
+
+  } else {
+    int nwords,icol,ncol;
+    const char *section;
+    if (which == PVELOCITIES) {
+      section = "Velocities";
+      nwords = atom->avec->size_data_vel;
+      icol = 0;
+      ncol = 1;
+    } else if (which == PBONDS) {
+      section = "Bonds";
+      nwords = 4;
+      icol = 2;
+      ncol = 2;
+    } else if (which == PANGLES) {
+      section = "Angles";
+      nwords = 5;
+      icol = 2;
+      ncol = 3;
+    } else {
+      section = (which == PDIHEDRALS) ? "Dihedrals" : "Impropers";
+      nwords = 6;
+      icol = 2;
+      ncol = 4;
+    }
+
+    // atom IDs of each line
+
+    std::vector<std::vector<tagint>> ids(nuse);
+    std::unordered_map<tagint,int> owner;
+
+    for (int i = 0; i < nuse; i++) {
+      ValueTokenizer values(utils::trim_comment(text[i]));
+      if (!values.has_next()) continue;
+      if ((int) values.count() != nwords)
+        error->one(FLERR,"Incorrect format of {} section of data file: {}",
+                   section, utils::trim(text[i]));
+      try {
+        values.skip(icol);
+        for (int k = 0; k < ncol; k++) ids[i].push_back(values.next_tagint() + id_offset);
+      } catch (TokenizerException &e) {
+        error->one(FLERR,"{} in {} section of data file: {}", e.what(), section,
+                   utils::trim(text[i]));
+      }
+      for (auto id : ids[i]) {
+        if ((id <= 0) || (id > maxtag))
+          error->one(FLERR,"Invalid atom ID {} in {} section of data file: {}", id, section,
+                     utils::trim(text[i]));
+        owner[id] = -1;
+      }
+    }
+
+    lookup_owners(owner);
+
+    // send each line once to each distinct owner of its atoms
+    // lines with non-existing atoms are sent nowhere, same as serial reading
+
+    for (int i = 0; i < nuse; i++) {
+      procs.clear();
+      for (auto id : ids[i]) {
+        int proc = owner[id];
+        if ((proc >= 0) && (std::find(procs.begin(),procs.end(),proc) == procs.end()))
+          procs.push_back(proc);
+      }
+      for (auto proc : procs) dest.emplace_back(proc,i);
+    }
+  }
+
+  // pack lines grouped by proc as (index, length, text) records
+
+  std::stable_sort(dest.begin(),dest.end(),
+                   [](const std::pair<int,int> &a, const std::pair<int,int> &b)
+                   { return a.first < b.first; });
+
+  std::vector<int> sendcounts(nprocs,0);
+  int nsend = 0;
+  for (auto &d : dest) {
+    int nbytes = sizeof(bigint) + sizeof(int) + text[d.second].size();
+    sendcounts[d.first] += nbytes;
+    nsend += nbytes;
+  }
+
+  std::vector<char> sendbuf(nsend);
+  char *ptr = sendbuf.data();
+  for (auto &d : dest) {
+    bigint index = first + d.second;
+    int len = text[d.second].size();
+    memcpy(ptr,&index,sizeof(bigint));
+    ptr += sizeof(bigint);
+    memcpy(ptr,&len,sizeof(int));
+    ptr += sizeof(int);
+    memcpy(ptr,text[d.second].data(),len);
+    ptr += len;
+  }
+
+  auto irregular = new Irregular(lmp);
+  int nrecv = irregular->create_data_grouped(nsend,sendcounts.data());
+  std::vector<char> recvbuf(nrecv);
+  irregular->exchange_data(sendbuf.data(),1,recvbuf.data());
+  irregular->destroy_data();
+  delete irregular;
+
+  // sort received lines into file order
+
+  std::vector<std::pair<bigint,int>> recvlines;
+  int m = 0;
+  while (m < nrecv) {
+    bigint index;
+    int len;
+    memcpy(&index,&recvbuf[m],sizeof(bigint));
+    memcpy(&len,&recvbuf[m+sizeof(bigint)],sizeof(int));
+    recvlines.emplace_back(index,m+sizeof(bigint));
+    m += sizeof(bigint) + sizeof(int) + len;
+  }
+  std::sort(recvlines.begin(),recvlines.end());
+
+  int n = recvlines.size();
+  if (n == 0) return;
+
+  std::string chunk;
+  for (auto &r : recvlines) {
+    int len;
+    memcpy(&len,&recvbuf[r.second],sizeof(int));
+    chunk.append(&recvbuf[r.second+sizeof(int)],len);
+    chunk += '\n';
+  }
+  char *buf = &chunk[0];
+
+  if (which == PATOMS)
+    atom->data_atoms(n,buf,id_offset,mol_offset,toffset,shiftflag,shift);
+  else if (which == PVELOCITIES)
+    atom->data_vels(n,buf,id_offset);
+  else if (which == PBONDS)
+    atom->data_bonds(n,buf,count,id_offset,boffset);
+  else if (which == PANGLES)
+    atom->data_angles(n,buf,count,id_offset,aoffset);
+  else if (which == PDIHEDRALS)
+    atom->data_dihedrals(n,buf,count,id_offset,doffset);
+  else if (which == PIMPROPERS)
+    atom->data_impropers(n,buf,count,id_offset,ioffset);
+}
+
+/* ----------------------------------------------------------------------
+   procs whose sub-domain may contain the atom of one line of Atoms section
+------------------------------------------------------------------------- */
+
+void ReadData::atom_procs(const std::string &text, std::vector<int> &procs)
+{
+  procs.clear();
+  auto values = Tokenizer(utils::trim_comment(text)).as_vector();
+  int nwords = values.size();
+  if (nwords == 0) return;
+
+  AtomVec *avec = atom->avec;
+  if ((nwords != avec->size_data_atom) && (nwords != avec->size_data_atom + 3))
+    error->one(FLERR,"Incorrect atom format in data file: {}", utils::trim(text));
+
+  double xdata[3];
+  int xptr = avec->xcol_data - 1;
+  for (int k = 0; k < 3; k++) xdata[k] = utils::numeric(FLERR,values[xptr+k],true,lmp);
+
+  coord_procs(xdata,procs);
+}
+
+/* ----------------------------------------------------------------------
+   procs whose sub-domain may contain an atom with unshifted coords xdata
+   coords are remapped into the box as in Atom::data_atoms()
+   the corners of a small cube around the atom are dropped on the decomposition,
+     which covers round-off and the EPSILON extension of periodic sub-domains
+   Atom::data_atoms() on those procs decides which one owns the atom
+------------------------------------------------------------------------- */
+
+void ReadData::coord_procs(double *xdata, std::vector<int> &procs)
+{
+  double lamda[3],delta[3],corner[3];
+  double *coord;
+
+  procs.clear();
+  if (shiftflag) {
+    xdata[0] += shift[0];
+    xdata[1] += shift[1];
+    xdata[2] += shift[2];
+  }
+
+  imageint image = ((imageint) IMGMAX << IMG2BITS) | ((imageint) IMGMAX << IMGBITS) | IMGMAX;
+  domain->remap(xdata,image);
+  if (domain->triclinic) {
+    domain->x2lamda(xdata,lamda);
+    coord = lamda;
+    delta[0] = delta[1] = delta[2] = PEPSILON;
+  } else {
+    coord = xdata;
+    for (int k = 0; k < 3; k++) delta[k] = PEPSILON * domain->prd[k];
+  }
+
+  int igx,igy,igz;
+  for (int i = 0; i < 8; i++) {
+    corner[0] = (i & 1) ? coord[0] + delta[0] : coord[0] - delta[0];
+    corner[1] = (i & 2) ? coord[1] + delta[1] : coord[1] - delta[1];
+    corner[2] = (i & 4) ? coord[2] + delta[2] : coord[2] - delta[2];
+    int proc = comm->coord2proc(corner,igx,igy,igz);
+    if (std::find(procs.begin(),procs.end(),proc) == procs.end()) procs.push_back(proc);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   setup directory of owning procs of all atoms in rendezvous decomposition
+   each proc stores every Pth atom ID, same as Special::atom_owners()
+------------------------------------------------------------------------- */
+
+void ReadData::directory()
+{
+  int nprocs = comm->nprocs;
+  tagint *tag = atom->tag;
+  int nlocal = atom->nlocal;
+
+  tagint max = 0;
+  for (int i = 0; i < nlocal; i++) max = MAX(max,tag[i]);
+  MPI_Allreduce(&max,&maxtag,1,MPI_LMP_TAGINT,MPI_MAX,world);
+
+  ndir = maxtag/nprocs + 1;
+  memory->create(dirowner,ndir,"read_data:dirowner");
+  for (int i = 0; i < ndir; i++) dirowner[i] = -1;
+
+  int *proclist;
+  memory->create(proclist,nlocal,"read_data:proclist");
+  auto idbuf = (OwnerRvous *) memory->smalloc((bigint) nlocal*sizeof(OwnerRvous),
+                                              "read_data:idbuf");
+
+  for (int i = 0; i < nlocal; i++) {
+    proclist[i] = tag[i] % nprocs;
+    idbuf[i].atomID = tag[i];
+    idbuf[i].proc = me;
+  }
+
+  char *buf;
+  comm->rendezvous(RVOUS,nlocal,(char *) idbuf,sizeof(OwnerRvous),0,proclist,
+                   rendezvous_directory,0,buf,0,(void *) this);
+
+  memory->destroy(proclist);
+  memory->sfree(idbuf);
+}
+
+/* ----------------------------------------------------------------------
+   look up owning procs of all atom IDs in owner via rendezvous directory
+------------------------------------------------------------------------- */
+
+void ReadData::lookup_owners(std::unordered_map<tagint,int> &owner)
+{
+  int nprocs = comm->nprocs;
+
+  int nquery = owner.size();
+  int *proclist;
+  memory->create(proclist,nquery,"read_data:proclist");
+  auto inbuf = (OwnerRvous *) memory->smalloc((bigint) nquery*sizeof(OwnerRvous),
+                                              "read_data:inbuf");
+  int m = 0;
+  for (auto &entry : owner) {
+    proclist[m] = entry.first % nprocs;
+    inbuf[m].atomID = entry.first;
+    inbuf[m].proc = me;
+    m++;
+  }
+
+  char *buf;
+  int nreturn = comm->rendezvous(RVOUS,nquery,(char *) inbuf,sizeof(OwnerRvous),0,proclist,
+                                 rendezvous_owners,0,buf,sizeof(OwnerRvous),(void *) this);
+  auto outbuf = (OwnerRvous *) buf;
+  for (int i = 0; i < nreturn; i++) owner[outbuf[i].atomID] = outbuf[i].proc;
+
+  memory->sfree(outbuf);
+  memory->destroy(proclist);
+  memory->sfree(inbuf);
+}
+
+/* ----------------------------------------------------------------------
+   callback from comm->rendezvous() to store directory entries assigned to me
+------------------------------------------------------------------------- */
+
+int ReadData::rendezvous_directory(int n, char *inbuf, int &flag, int *& /*proclist*/,
+                                   char *& /*outbuf*/, void *ptr)
+{
+  auto rptr = (ReadData *) ptr;
+  int nprocs = rptr->comm->nprocs;
+  auto in = (OwnerRvous *) inbuf;
+
+  for (int i = 0; i < n; i++)
+    rptr->dirowner[in[i].atomID / nprocs] = in[i].proc;
+
+  // flag = 0: no second comm needed in rendezvous
+
+  flag = 0;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   callback from comm->rendezvous() to look up owning procs of atom IDs
+   inbuf = list of N OwnerRvous datums with requesting proc
+   outbuf = same list with owning proc, returned to requesting procs
+------------------------------------------------------------------------- */
+
+int ReadData::rendezvous_owners(int n, char *inbuf, int &flag, int *&proclist,
+                                char *&outbuf, void *ptr)
+{
+  auto rptr = (ReadData *) ptr;
+  int nprocs = rptr->comm->nprocs;
+  auto in = (OwnerRvous *) inbuf;
+
+  rptr->memory->create(proclist,n,"read_data:proclist");
+  for (int i = 0; i < n; i++) {
+    proclist[i] = in[i].proc;
+    in[i].proc = rptr->dirowner[in[i].atomID / nprocs];
+  }
+
+  // flag = 1: outbuf = inbuf
+
+  outbuf = inbuf;
+  flag = 1;
+  return n;
+}
+
+/* ----------------------------------------------------------------------
+   skip N lines of a section or a binary section not read in this pass
+   a text section already read in parallel in the 1st pass is skipped
+     by seeking to its recorded end
+------------------------------------------------------------------------- */
+
+void ReadData::skip_section(bigint n)
+{
+  if (binary_header()) {
+    if (me == 0) platform::fseek(fp,binstart + (bigint) bincols*binrows*sizeof(double));
+  } else if (nreaders) {
+    bigint start = 0;
+    if (me == 0) start = platform::ftell(fp);
+    MPI_Bcast(&start,1,MPI_LMP_BIGINT,0,world);
+    auto it = sectionend.find(start);
+    if (it == sectionend.end()) parallel_section(n,PSKIP,nullptr);
+    else if (me == 0) platform::fseek(fp,it->second);
+  } else skip_lines(n);
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 checks if a binary section follows the section keyword
+   if so, read and bcast its header, file is positioned after it
+   else file is positioned at first line of text section
+   return 1 if binary section, 0 if not
+------------------------------------------------------------------------- */
+
+int ReadData::binary_header()
+{
+  int flag = 0;
+
+  if ((me == 0) && !compressed) {
+    bigint start = platform::ftell(fp);
+    char magic[DATABIN_MAGIC_SIZE];
+    if ((fread(magic,1,DATABIN_MAGIC_SIZE,fp) == DATABIN_MAGIC_SIZE) &&
+        (memcmp(magic,DATABIN_MAGIC,strlen(DATABIN_MAGIC)+1) == 0)) flag = 1;
+    else {
+      clearerr(fp);
+      platform::fseek(fp,start);
+    }
+
+    if (flag) {
+      int endian,revision;
+      utils::sfread(FLERR,&endian,sizeof(int),1,fp,nullptr,error);
+      if (endian != DATABIN_ENDIAN)
+        error->one(FLERR,"Binary data file section has incompatible endianness");
+      utils::sfread(FLERR,&revision,sizeof(int),1,fp,nullptr,error);
+      if (revision > DATABIN_REVISION)
+        error->one(FLERR,"Binary data file section has unsupported format revision {}", revision);
+      utils::sfread(FLERR,&binrows,sizeof(bigint),1,fp,nullptr,error);
+      utils::sfread(FLERR,&bincols,sizeof(int),1,fp,nullptr,error);
+      if ((binrows < 0) || (bincols <= 0))
+        error->one(FLERR,"Invalid header of binary data file section");
+      bintypes.resize(bincols);
+      utils::sfread(FLERR,bintypes.data(),sizeof(int),bincols,fp,nullptr,error);
+      binstart = platform::ftell(fp);
+    }
+  }
+
+  MPI_Bcast(&flag,1,MPI_INT,0,world);
+  if (!flag) return 0;
+
+  MPI_Bcast(&binrows,1,MPI_LMP_BIGINT,0,world);
+  MPI_Bcast(&bincols,1,MPI_INT,0,world);
+  MPI_Bcast(&binstart,1,MPI_LMP_BIGINT,0,world);
+  bintypes.resize(bincols);
+  MPI_Bcast(bintypes.data(),bincols,MPI_INT,0,world);
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   read binary section with nsection rows, header was read by binary_header()
+   w/out parallel readers, proc 0 reads chunks of rows and bcasts them
+   with parallel readers, they read chunks of rows round-robin
+     and send each row to the procs that need it
+   count is passed on for Bonds/Angles/Dihedrals/Impropers as for text sections
+------------------------------------------------------------------------- */
+
+void ReadData::binary_section(bigint nsection, int which, int *count)
+{
+  static const char *sections[] = {"Atoms","Velocities","Bonds","Angles","Dihedrals","Impropers"};
+
+  // rows must match the layout of the atom style or topology section
+
+  std::vector<int> types;
+  if ((which == PATOMS) || (which == PVELOCITIES)) {
+    atom->avec->data_columns((which == PVELOCITIES) ? 1 : 0,types);
+    for (auto &type : types) type = (type == Atom::DOUBLE) ? DATABIN_DOUBLE : DATABIN_INT;
+  } else {
+    int natom = (which == PBONDS) ? 2 : ((which == PANGLES) ? 3 : 4);
+    types.assign(natom+1,DATABIN_INT);
+  }
+
+  if (binrows != nsection)
+    error->all(FLERR,"Binary {} section of data file has {} rows instead of {}",
+               sections[which], binrows, nsection);
+  if (bintypes != types)
+    error->all(FLERR,"Columns of binary {} section of data file do not match atom style {}",
+               sections[which], atom->atom_style);
+
+  double *buf;
+  memory->create(buf,(bigint) BINCHUNK*bincols,"read_data:binbuf");
+
+  if (nreaders == 0) {
+    bigint nread = 0;
+    while (nread < nsection) {
+      int nchunk = MIN(nsection-nread,BINCHUNK);
+      if (me == 0) binary_rows(fp,nread,nchunk,buf);
+      MPI_Bcast(buf,nchunk*bincols,MPI_DOUBLE,0,world);
+      binary_process(which,nchunk,buf,count);
+      nread += nchunk;
+    }
+
+  } else {
+    if ((which != PATOMS) && !dirowner) directory();
+
+    // all procs perform the same # of rounds, since routing is collective
+    // in each round, every reader reads one chunk of BINCHUNK rows,
+    //   chunks of one round are consecutive in order of reader rank,
+    //   so rows arrive in file order as for parallel text sections
+
+    bigint nchunks = (nsection + BINCHUNK - 1) / BINCHUNK;
+    bigint nrounds = (nchunks + nreaders - 1) / nreaders;
+
+    for (bigint iround = 0; iround < nrounds; iround++) {
+      bigint first = (iround*nreaders + ireader) * BINCHUNK;
+      int nchunk = 0;
+      if ((ireader >= 0) && (first < nsection)) nchunk = MIN(nsection-first,BINCHUNK);
+      if (nchunk) binary_rows(pfp,first,nchunk,buf);
+      binary_route(which,nchunk,buf,first,count);
+    }
+  }
+
+  memory->destroy(buf);
+
+  if (me == 0) platform::fseek(fp,binstart + (bigint) bincols*binrows*sizeof(double));
+}
+
+/* ----------------------------------------------------------------------
+   read N rows of binary section starting at row first into buf
+   values are stored column by column in the file, row by row in buf
+------------------------------------------------------------------------- */
+
+void ReadData::binary_rows(FILE *fpr, bigint first, int n, double *buf)
+{
+  std::vector<double> column(n);
+
+  for (int c = 0; c < bincols; c++) {
+    bigint offset = binstart + ((bigint) c*binrows + first) * sizeof(double);
+    if (platform::fseek(fpr,offset) != 0)
+      error->one(FLERR,"Unexpected end of data file");
+    utils::sfread(FLERR,column.data(),sizeof(double),n,fpr,nullptr,error);
+    for (int i = 0; i < n; i++) buf[(bigint) i*bincols+c] = column[i];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   send N rows of binary section read by this proc to the procs that need them
+   rows of Atoms go to procs whose sub-domain may contain the atom,
+     all others to the owners of the atoms in the row
+   first = index of buf[0] within section, used to restore file order
+------------------------------------------------------------------------- */
+
+void ReadData::binary_route(int which, int n, double *buf, bigint first, int *count)
+{
+  static const char *sections[] = {"Atoms","Velocities","Bonds","Angles","Dihedrals","Impropers"};
+  int nprocs = comm->nprocs;
+  int ncol = bincols;
+
+  // dest = (proc, row) pairs for all rows I send
+
+  std::vector<std::pair<int,int>> dest;
+  std::vector<int> procs;
+
+  if (which == PATOMS) {
+    int xptr = atom->avec->xcol_data - 1;
+    double xdata[3];
+    for (int i = 0; i < n; i++) {
+      for (int k = 0; k < 3; k++) xdata[k] = buf[(bigint) i*ncol+xptr+k];
+      coord_procs(xdata,procs);
+      for (auto proc : procs) dest.emplace_back(proc,i);
+    }
+
+  } else {
+    int icol = (which == PVELOCITIES) ? 0 : 1;
+    int nid = (which == PVELOCITIES) ? 1 : ncol-1;
+    std::unordered_map<tagint,int> owner;
+
+    for (int i = 0; i < n; i++) {
+      for (int k = 0; k < nid; k++) {
+        tagint id = (tagint) ubuf(buf[(bigint) i*ncol+icol+k]).i + id_offset;
+        if ((id <= 0) || (id > maxtag))
+          error->one(FLERR,"Invalid atom ID {} in {} section of data file", id, sections[which]);
+        owner[id] = -1;
+      }
+    }
+
+    lookup_owners(owner);
+
+    for (int i = 0; i < n; i++) {
+      procs.clear();
+      for (int k = 0; k < nid; k++) {
+        int proc = owner[(tagint) ubuf(buf[(bigint) i*ncol+icol+k]).i + id_offset];
+        if ((proc >= 0) && (std::find(procs.begin(),procs.end(),proc) == procs.end()))
+          procs.push_back(proc);
+      }
+      for (auto proc : procs) dest.emplace_back(proc,i);
+    }
+  }
+
+  // datum = index within section followed by the row
+
+  std::stable_sort(dest.begin(),dest.end(),
+                   [](const std::pair<int,int> &a, const std::pair<int,int> &b)
+                   { return a.first < b.first; });
+
+  int nsend = dest.size();
+  std::vector<int> sendcounts(nprocs,0);
+  std::vector<double> sendbuf((bigint) nsend*(ncol+1));
+  for (int m = 0; m < nsend; m++) {
+    sendcounts[dest[m].first]++;
+    double *datum = &sendbuf[(bigint) m*(ncol+1)];
+    datum[0] = ubuf(first + dest[m].second).d;
+    memcpy(&datum[1],&buf[(bigint) dest[m].second*ncol],ncol*sizeof(double));
+  }
+
+  auto irregular = new Irregular(lmp);
+  int nrecv = irregular->create_data_grouped(nsend,sendcounts.data());
+  std::vector<double> recvbuf((bigint) nrecv*(ncol+1));
+  irregular->exchange_data((char *) sendbuf.data(),(ncol+1)*sizeof(double),
+                           (char *) recvbuf.data());
+  irregular->destroy_data();
+  delete irregular;
+
+  // process received rows in file order
+
+  std::vector<std::pair<bigint,int>> order(nrecv);
+  for (int m = 0; m < nrecv; m++)
+    order[m] = std::make_pair((bigint) ubuf(recvbuf[(bigint) m*(ncol+1)]).i,m);
+  std::sort(order.begin(),order.end());
+
+  std::vector<double> rows((bigint) nrecv*ncol);
+  for (int m = 0; m < nrecv; m++)
+    memcpy(&rows[(bigint) m*ncol],&recvbuf[(bigint) order[m].second*(ncol+1)+1],
+           ncol*sizeof(double));
+
+  binary_process(which,nrecv,rows.data(),count);
+}
+
+/* ----------------------------------------------------------------------
+   process N rows of binary section
+------------------------------------------------------------------------- */
+
+void ReadData::binary_process(int which, int n, double *buf, int *count)
+{
+  if (which == PATOMS)
+    atom->data_atoms_binary(n,buf,id_offset,mol_offset,toffset,shiftflag,shift);
+  else if (which == PVELOCITIES)
+    atom->data_vels_binary(n,buf,id_offset);
+  else {
+    const int offsets[] = {boffset,aoffset,doffset,ioffset};
+    atom->data_topology_binary(which-PBONDS,n,buf,count,id_offset,offsets[which-PBONDS]);
+  }
+}
@@ -22,6 +22,9 @@ CommandStyle(read_data,ReadData);
 
 #include "command.h"
 
+#include <unordered_map>
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class ReadData : public Command {
@@ -72,6 +75,25 @@ class ReadData : public Command {
   int extra_dihedral_types, extra_improper_types;
   int groupbit;
 
+  // parallel reading of large sections
+
+  int nreaders;         // # of procs that read sections, 0 = only proc 0 reads
+  int ireader;          // my index among readers, -1 if not a reader
+  FILE *pfp;            // my own file pointer if I am a reader
+  int *dirowner;        // owning proc of atom IDs assigned to me, nullptr if not set
+  int ndir;             // length of dirowner
+  tagint maxtag;        // largest atom ID in directory
+
+  std::unordered_map<bigint, bigint> sectionend;    // file offset of end of each section
+                                                    //   read in parallel, by its start
+
+  // current binary section
+
+  bigint binrows;            // # of rows
+  int bincols;               // # of columns
+  bigint binstart;           // file offset of first value
+  std::vector<int> bintypes; // datatype of each column
+
   int nfix;
   int *fix_index;
   char **fix_header;
@@ -109,6 +131,23 @@ class ReadData : public Command {
   void impropercoeffs(int);
 
   void fix(int, char *);
+
+  void parallel_section(bigint, int, int *);
+  int read_block(bigint, bigint, bigint, std::vector<char> &, std::vector<int> &, bigint &);
+  void parallel_route(int, std::vector<char> &, std::vector<int> &, int, bigint, int *);
+  void atom_procs(const std::string &, std::vector<int> &);
+  void coord_procs(double *, std::vector<int> &);
+  void directory();
+  void lookup_owners(std::unordered_map<tagint, int> &);
+  static int rendezvous_directory(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_owners(int, char *, int &, int *&, char *&, void *);
+
+  void skip_section(bigint);
+  int binary_header();
+  void binary_section(bigint, int, int *);
+  void binary_rows(FILE *, bigint, int, double *);
+  void binary_route(int, int, double *, bigint, int *);
+  void binary_process(int, int, double *, int *);
 };
 
 }    // namespace LAMMPS_NS
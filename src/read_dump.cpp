@@ -288,6 +288,7 @@ bigint ReadDump::seek(bigint nrequest, int exact)
         multiname.replace(multiname.find('%'),1,"0");
         readers[0]->open_file(multiname.c_str());
       } else readers[0]->open_file(files[ifile]);
+      readers[0]->seek_time(nrequest);
 
       while (true) {
         eofflag = readers[0]->read_time(ntimestep);
@@ -331,6 +332,7 @@ bigint ReadDump::seek(bigint nrequest, int exact)
       std::string multiname = files[currentfile];
       multiname.replace(multiname.find('%'),1,fmt::format("{}",firstfile+i));
       readers[i]->open_file(multiname.c_str());
+      readers[i]->seek_time(ntimestep);
 
       bigint step;
       while (true) {
@@ -381,6 +383,7 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
           readers[0]->open_file(multiname.c_str());
         } else readers[0]->open_file(files[ifile]);
       }
+      readers[0]->seek_time(ncurrent+1);
 
       while (true) {
         eofflag = readers[0]->read_time(ntimestep);
@@ -433,6 +436,7 @@ bigint ReadDump::next(bigint ncurrent, bigint nlast, int nevery, int nskip)
       std::string multiname = files[currentfile];
       multiname.replace(multiname.find('%'),1,fmt::format("{}",firstfile+i));
       readers[i]->open_file(multiname.c_str());
+      readers[i]->seek_time(ntimestep);
 
       bigint step;
       while (true) {
@@ -69,6 +69,14 @@ void Reader::close_file()
   fp = nullptr;
 }
 
+/* ----------------------------------------------------------------------
+   optionally move forward to the first snapshot with timestep >= Ntimestep,
+     e.g. by using an index, so the next read_time() returns it
+   generic version does nothing, caller reads and skips snapshots in order
+------------------------------------------------------------------------- */
+
+void Reader::seek_time(bigint /*ntimestep*/) {}
+
 /* ----------------------------------------------------------------------
    detect unused arguments
 ------------------------------------------------------------------------- */
@@ -28,6 +28,7 @@ class Reader : protected Pointers {
 
   virtual int read_time(bigint &) = 0;
   virtual void skip() = 0;
+  virtual void seek_time(bigint);
   virtual bigint read_header(double[3][3], int &, int &, int, int, int *, char **, int, int, int &,
                              int &, int &, int &) = 0;
   virtual void read_atoms(int, int, double **) = 0;
@@ -17,7 +17,9 @@
 #include "domain.h"
 #include "error.h"
 #include "finish.h"
+#include "force.h"
 #include "integrate.h"
+#include "kspace.h"
 #include "modify.h"
 #include "output.h"
 #include "read_dump.h"
@@ -131,6 +133,11 @@ void Rerun::command(int narg, char **arg)
   if (nremain) rd->setup_reader(nremain,&arg[narg-nremain]);
   else rd->setup_reader(0,nullptr);
 
+  // snapshots are not spaced by timesteps of a run, multiple time step KSpace does not apply
+
+  if (force->kspace && force->kspace->interval > 1)
+    error->all(FLERR,"Rerun cannot be used with kspace_modify interval > 1");
+
   // perform the pseudo run
   // invoke lmp->init() only once
   // read all relevant snapshots
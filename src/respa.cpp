@@ -30,6 +30,7 @@
 #include "force.h"
 #include "improper.h"
 #include "kspace.h"
+#include "kspace_concurrent.h"
 #include "modify.h"
 #include "neighbor.h"
 #include "output.h"
@@ -383,6 +384,13 @@ void Respa::setup(int flag)
     }
   }
 
+  // KSpace partition of kspace_modify concurrent only computes KSpace forces
+
+  if (kspace_concurrent && !kspace_concurrent->rspace) {
+    kspace_concurrent->serve();
+    return;
+  }
+
   update->setupflag = 1;
 
   // setup domain, communication and neighboring
@@ -428,7 +436,13 @@ void Respa::setup(int flag)
     if (level_angle == ilevel && force->angle) force->angle->compute(eflag, vflag);
     if (level_dihedral == ilevel && force->dihedral) force->dihedral->compute(eflag, vflag);
     if (level_improper == ilevel && force->improper) force->improper->compute(eflag, vflag);
-    if (level_kspace == ilevel && force->kspace) {
+    if (level_kspace == ilevel && kspace_concurrent) {
+      if (kspace_compute_flag) {
+        kspace_concurrent->compute_start(eflag, vflag, 1);
+        kspace_concurrent->compute_finish();
+      }
+      kspace_concurrent->stop();
+    } else if (level_kspace == ilevel && force->kspace) {
       force->kspace->setup();
       if (kspace_compute_flag) force->kspace->compute(eflag, vflag);
     }
@@ -452,6 +466,13 @@ void Respa::setup(int flag)
 
 void Respa::setup_minimal(int flag)
 {
+  // KSpace partition of kspace_modify concurrent only computes KSpace forces
+
+  if (kspace_concurrent && !kspace_concurrent->rspace) {
+    kspace_concurrent->serve();
+    return;
+  }
+
   update->setupflag = 1;
 
   // setup domain, communication and neighboring
@@ -497,7 +518,13 @@ void Respa::setup_minimal(int flag)
     if (level_angle == ilevel && force->angle) force->angle->compute(eflag, vflag);
     if (level_dihedral == ilevel && force->dihedral) force->dihedral->compute(eflag, vflag);
     if (level_improper == ilevel && force->improper) force->improper->compute(eflag, vflag);
-    if (level_kspace == ilevel && force->kspace) {
+    if (level_kspace == ilevel && kspace_concurrent) {
+      if (kspace_compute_flag) {
+        kspace_concurrent->compute_start(eflag, vflag, 1);
+        kspace_concurrent->compute_finish();
+      }
+      kspace_concurrent->stop();
+    } else if (level_kspace == ilevel && force->kspace) {
       force->kspace->setup();
       if (kspace_compute_flag) force->kspace->compute(eflag, vflag);
     }
@@ -520,6 +547,12 @@ void Respa::run(int n)
 {
   bigint ntimestep;
 
+  if (kspace_concurrent && !kspace_concurrent->rspace) {
+    kspace_concurrent->serve();
+    kspace_concurrent->report();
+    return;
+  }
+
   for (int i = 0; i < n; i++) {
     if (timer->check_timeout(i)) {
       update->nsteps = i;
@@ -547,6 +580,11 @@ void Respa::run(int n)
       timer->stamp(Timer::OUTPUT);
     }
   }
+
+  if (kspace_concurrent) {
+    kspace_concurrent->stop();
+    kspace_concurrent->report();
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -557,7 +595,10 @@ void Respa::cleanup()
 {
   modify->post_run();
   modify->delete_fix("RESPA");
-  domain->box_too_small_check();
+
+  // atoms on KSpace partition of kspace_modify concurrent have no ghosts or bond partners
+
+  if (!kspace_concurrent || kspace_concurrent->rspace) domain->box_too_small_check();
   update->update_time();
 }
 
@@ -651,7 +692,14 @@ void Respa::recurse(int ilevel)
       timer->stamp(Timer::MODIFY);
     }
 
+    // start KSpace solve on other partition, so it overlaps with other forces
+
     timer->stamp();
+    if (level_kspace == ilevel && kspace_concurrent && kspace_compute_flag) {
+      kspace_concurrent->compute_start(eflag, vflag, 0);
+      timer->stamp(Timer::KSPACE);
+    }
+
     if (nhybrid_styles > 0) {
       set_compute_flags(ilevel);
       force->pair->compute(eflag, vflag);
@@ -690,7 +738,8 @@ void Respa::recurse(int ilevel)
       timer->stamp(Timer::BOND);
     }
     if (level_kspace == ilevel && kspace_compute_flag) {
-      force->kspace->compute(eflag, vflag);
+      if (kspace_concurrent) kspace_concurrent->compute_finish();
+      else force->kspace->compute(eflag, vflag);
       timer->stamp(Timer::KSPACE);
     }
 
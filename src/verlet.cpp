@@ -26,7 +26,9 @@
 #include "force.h"
 #include "improper.h"
 #include "kspace.h"
+#include "kspace_concurrent.h"
 #include "modify.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 #include "output.h"
 #include "pair.h"
@@ -106,6 +108,13 @@ void Verlet::setup(int flag)
   if (lmp->kokkos)
     error->all(FLERR,"KOKKOS package requires run_style verlet/kk");
 
+  // KSpace partition of kspace_modify concurrent only computes KSpace forces
+
+  if (kspace_concurrent && !kspace_concurrent->rspace) {
+    kspace_concurrent->serve();
+    return;
+  }
+
   update->setupflag = 1;
 
   // setup domain, communication and neighboring
@@ -147,10 +156,17 @@ void Verlet::setup(int flag)
     if (force->improper) force->improper->compute(eflag,vflag);
   }
 
-  if (force->kspace) {
+  if (kspace_concurrent) {
+    if (kspace_compute_flag) {
+      kspace_concurrent->compute_start(eflag,vflag,1);
+      kspace_concurrent->compute_finish();
+    } else force->kspace->compute_dummy(eflag,vflag);
+    kspace_concurrent->stop();
+  } else if (force->kspace) {
     force->kspace->setup();
-    if (kspace_compute_flag) force->kspace->compute(eflag,vflag);
-    else force->kspace->compute_dummy(eflag,vflag);
+    if (!kspace_compute_flag) force->kspace->compute_dummy(eflag,vflag);
+    else if (force->kspace->interval > 1) force->kspace->compute_interval(eflag,vflag);
+    else force->kspace->compute(eflag,vflag);
   }
 
   modify->setup_pre_reverse(eflag,vflag);
@@ -169,6 +185,13 @@ void Verlet::setup(int flag)
 
 void Verlet::setup_minimal(int flag)
 {
+  // KSpace partition of kspace_modify concurrent only computes KSpace forces
+
+  if (kspace_concurrent && !kspace_concurrent->rspace) {
+    kspace_concurrent->serve();
+    return;
+  }
+
   update->setupflag = 1;
 
   // setup domain, communication and neighboring
@@ -209,10 +232,17 @@ void Verlet::setup_minimal(int flag)
     if (force->improper) force->improper->compute(eflag,vflag);
   }
 
-  if (force->kspace) {
+  if (kspace_concurrent) {
+    if (kspace_compute_flag) {
+      kspace_concurrent->compute_start(eflag,vflag,1);
+      kspace_concurrent->compute_finish();
+    } else force->kspace->compute_dummy(eflag,vflag);
+    kspace_concurrent->stop();
+  } else if (force->kspace) {
     force->kspace->setup();
-    if (kspace_compute_flag) force->kspace->compute(eflag,vflag);
-    else force->kspace->compute_dummy(eflag,vflag);
+    if (!kspace_compute_flag) force->kspace->compute_dummy(eflag,vflag);
+    else if (force->kspace->interval > 1) force->kspace->compute_interval(eflag,vflag);
+    else force->kspace->compute(eflag,vflag);
   }
 
   modify->setup_pre_reverse(eflag,vflag);
@@ -229,7 +259,13 @@ void Verlet::setup_minimal(int flag)
 void Verlet::run(int n)
 {
   bigint ntimestep;
-  int nflag,sortflag;
+  int nflag,sortflag,overlap;
+
+  if (kspace_concurrent && !kspace_concurrent->rspace) {
+    kspace_concurrent->serve();
+    kspace_concurrent->report();
+    return;
+  }
 
   int n_post_integrate = modify->n_post_integrate;
   int n_pre_exchange = modify->n_pre_exchange;
@@ -243,6 +279,12 @@ void Verlet::run(int n)
   if (atom->sortfreq > 0) sortflag = 1;
   else sortflag = 0;
 
+  // overlap forward comm with pair forces if no fix needs ghosts before pair
+
+  int overlapflag = 0;
+  if (comm->overlap && pair_compute_flag && force->pair->overlap_enable && !n_pre_force)
+    overlapflag = 1;
+
   for (int i = 0; i < n; i++) {
     if (timer->check_timeout(i)) {
       update->nsteps = i;
@@ -262,10 +304,14 @@ void Verlet::run(int n)
     // regular communication vs neighbor list rebuild
 
     nflag = neighbor->decide();
+    overlap = 0;
 
     if (nflag == 0) {
       timer->stamp();
-      comm->forward_comm();
+      if (overlapflag && !eflag && !vflag && force->pair->list->inum_owned >= 0) {
+        comm->forward_comm_start();
+        overlap = 1;
+      } else comm->forward_comm();
       timer->stamp(Timer::COMM);
     } else {
       if (n_pre_exchange) {
@@ -312,7 +358,15 @@ void Verlet::run(int n)
       timer->stamp(Timer::MODIFY);
     }
 
-    if (pair_compute_flag) {
+    // start KSpace solve on other partition, so it overlaps with other forces
+
+    if (kspace_concurrent && kspace_compute_flag) {
+      kspace_concurrent->compute_start(eflag,vflag,0);
+      timer->stamp(Timer::KSPACE);
+    }
+
+    if (overlap) pair_compute_overlap();
+    else if (pair_compute_flag) {
       force->pair->compute(eflag,vflag);
       timer->stamp(Timer::PAIR);
     }
@@ -326,7 +380,9 @@ void Verlet::run(int n)
     }
 
     if (kspace_compute_flag) {
-      force->kspace->compute(eflag,vflag);
+      if (kspace_concurrent) kspace_concurrent->compute_finish();
+      else if (force->kspace->interval > 1) force->kspace->compute_interval(eflag,vflag);
+      else force->kspace->compute(eflag,vflag);
       timer->stamp(Timer::KSPACE);
     }
 
@@ -357,6 +413,40 @@ void Verlet::run(int n)
       timer->stamp(Timer::OUTPUT);
     }
   }
+
+  if (kspace_concurrent) {
+    kspace_concurrent->stop();
+    kspace_concurrent->report();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   pair forces in two parts, overlapped with a split-phase forward comm
+   1st part = owned atoms with only owned neighbors, needs no ghost coords
+   2nd part = all other atoms, computed after ghost coords have arrived
+   only used on steps without energy/virial tallies, so the two calls
+     of compute() need no extra bookkeeping
+------------------------------------------------------------------------- */
+
+void Verlet::pair_compute_overlap()
+{
+  NeighList *list = force->pair->list;
+  const int inum = list->inum;
+  int *ilist = list->ilist;
+
+  list->inum = list->inum_owned;
+  force->pair->compute(0,0);
+  timer->stamp(Timer::PAIR);
+
+  comm->forward_comm_finish();
+  timer->stamp(Timer::COMM);
+
+  list->ilist = ilist + list->inum_owned;
+  list->inum = inum - list->inum_owned;
+  force->pair->compute(0,0);
+  list->ilist = ilist;
+  list->inum = inum;
+  timer->stamp(Timer::PAIR);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -364,7 +454,10 @@ void Verlet::run(int n)
 void Verlet::cleanup()
 {
   modify->post_run();
-  domain->box_too_small_check();
+
+  // atoms on KSpace partition of kspace_modify concurrent have no ghosts or bond partners
+
+  if (!kspace_concurrent || kspace_concurrent->rspace) domain->box_too_small_check();
   update->update_time();
 }
 
@@ -39,6 +39,7 @@ class Verlet : public Integrate {
   int torqueflag, extraflag;
 
   virtual void force_clear();
+  void pair_compute_overlap();
 };
 
 }    // namespace LAMMPS_NS
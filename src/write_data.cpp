@@ -25,6 +25,7 @@
 #include "fix.h"
 #include "force.h"
 #include "improper.h"
+#include "lmpdatabin.h"
 #include "memory.h"
 #include "modify.h"
 #include "output.h"
@@ -71,6 +72,7 @@ void WriteData::command(int narg, char **arg)
   pairflag = II;
   coeffflag = 1;
   fixflag = 1;
+  binaryflag = 0;
   int noinit = 0;
 
   int iarg = 1;
@@ -90,6 +92,10 @@ void WriteData::command(int narg, char **arg)
     } else if (strcmp(arg[iarg],"nofix") == 0) {
       fixflag = 0;
       iarg++;
+    } else if (strcmp(arg[iarg],"binary") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal write_data command");
+      binaryflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else error->all(FLERR,"Illegal write_data command");
   }
 
@@ -174,7 +180,7 @@ void WriteData::write(const std::string &file)
   // open data file
 
   if (me == 0) {
-    fp = fopen(file.c_str(),"w");
+    fp = fopen(file.c_str(),binaryflag ? "wb" : "w");
     if (fp == nullptr)
       error->one(FLERR,"Cannot open data file {}: {}",
                                    file, utils::getsyserror());
@@ -355,6 +361,11 @@ void WriteData::atoms()
 
   atom->avec->pack_data(buf);
 
+  // total # of rows of binary section
+
+  bigint nrows = sendrow;
+  if (binaryflag) MPI_Allreduce(MPI_IN_PLACE,&nrows,1,MPI_LMP_BIGINT,MPI_SUM,world);
+
   // write one chunk of atoms per proc to file
   // proc 0 pings each proc, receives its chunk, writes to file
   // all other procs wait for ping, send their chunk to proc 0
@@ -366,6 +377,11 @@ void WriteData::atoms()
     MPI_Request request;
 
     fmt::print(fp,"\nAtoms # {}\n\n",atom->atom_style);
+    if (binaryflag) {
+      std::vector<int> types;
+      atom->avec->data_columns(0,types);
+      binary_header(nrows,types);
+    }
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_DOUBLE,iproc,0,world,&request);
@@ -375,8 +391,10 @@ void WriteData::atoms()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_data(fp,recvrow,buf);
+      if (binaryflag) binary_rows(recvrow,buf);
+      else atom->avec->write_data(fp,recvrow,buf);
     }
+    if (binaryflag) binary_end();
 
   } else {
     MPI_Recv(&tmp,0,MPI_INT,0,0,world,MPI_STATUS_IGNORE);
@@ -408,6 +426,11 @@ void WriteData::velocities()
 
   atom->avec->pack_vel(buf);
 
+  // total # of rows of binary section
+
+  bigint nrows = sendrow;
+  if (binaryflag) MPI_Allreduce(MPI_IN_PLACE,&nrows,1,MPI_LMP_BIGINT,MPI_SUM,world);
+
   // write one chunk of velocities per proc to file
   // proc 0 pings each proc, receives its chunk, writes to file
   // all other procs wait for ping, send their chunk to proc 0
@@ -419,6 +442,11 @@ void WriteData::velocities()
     MPI_Request request;
 
     fputs("\nVelocities\n\n",fp);
+    if (binaryflag) {
+      std::vector<int> types;
+      atom->avec->data_columns(1,types);
+      binary_header(nrows,types);
+    }
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_DOUBLE,iproc,0,world,&request);
@@ -428,8 +456,10 @@ void WriteData::velocities()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_vel(fp,recvrow,buf);
+      if (binaryflag) binary_rows(recvrow,buf);
+      else atom->avec->write_vel(fp,recvrow,buf);
     }
+    if (binaryflag) binary_end();
 
   } else {
     MPI_Recv(&tmp,0,MPI_INT,0,0,world,MPI_STATUS_IGNORE);
@@ -473,6 +503,7 @@ void WriteData::bonds()
     MPI_Request request;
 
     fputs("\nBonds\n\n",fp);
+    if (binaryflag) binary_header(nbonds,std::vector<int>(ncol,Atom::INT));
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_LMP_TAGINT,iproc,0,world,&request);
@@ -482,9 +513,11 @@ void WriteData::bonds()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_bond(fp,recvrow,buf,index);
+      if (binaryflag) binary_rows(recvrow,buf);
+      else atom->avec->write_bond(fp,recvrow,buf,index);
       index += recvrow;
     }
+    if (binaryflag) binary_end();
 
   } else {
     MPI_Recv(&tmp,0,MPI_INT,0,0,world,MPI_STATUS_IGNORE);
@@ -528,6 +561,7 @@ void WriteData::angles()
     MPI_Request request;
 
     fputs("\nAngles\n\n",fp);
+    if (binaryflag) binary_header(nangles,std::vector<int>(ncol,Atom::INT));
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_LMP_TAGINT,iproc,0,world,&request);
@@ -537,9 +571,11 @@ void WriteData::angles()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_angle(fp,recvrow,buf,index);
+      if (binaryflag) binary_rows(recvrow,buf);
+      else atom->avec->write_angle(fp,recvrow,buf,index);
       index += recvrow;
     }
+    if (binaryflag) binary_end();
 
   } else {
     MPI_Recv(&tmp,0,MPI_INT,0,0,world,MPI_STATUS_IGNORE);
@@ -583,6 +619,7 @@ void WriteData::dihedrals()
     MPI_Request request;
 
     fputs("\nDihedrals\n\n",fp);
+    if (binaryflag) binary_header(ndihedrals,std::vector<int>(ncol,Atom::INT));
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_LMP_TAGINT,iproc,0,world,&request);
@@ -592,9 +629,11 @@ void WriteData::dihedrals()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_dihedral(fp,recvrow,buf,index);
+      if (binaryflag) binary_rows(recvrow,buf);
+      else atom->avec->write_dihedral(fp,recvrow,buf,index);
       index += recvrow;
     }
+    if (binaryflag) binary_end();
 
   } else {
     MPI_Recv(&tmp,0,MPI_INT,0,0,world,MPI_STATUS_IGNORE);
@@ -638,6 +677,7 @@ void WriteData::impropers()
     MPI_Request request;
 
     fputs("\nImpropers\n\n",fp);
+    if (binaryflag) binary_header(nimpropers,std::vector<int>(ncol,Atom::INT));
     for (int iproc = 0; iproc < nprocs; iproc++) {
       if (iproc) {
         MPI_Irecv(&buf[0][0],maxrow*ncol,MPI_LMP_TAGINT,iproc,0,world,&request);
@@ -647,9 +687,11 @@ void WriteData::impropers()
         recvrow /= ncol;
       } else recvrow = sendrow;
 
-      atom->avec->write_improper(fp,recvrow,buf,index);
+      if (binaryflag) binary_rows(recvrow,buf);
+      else atom->avec->write_improper(fp,recvrow,buf,index);
       index += recvrow;
     }
+    if (binaryflag) binary_end();
 
   } else {
     MPI_Recv(&tmp,0,MPI_INT,0,0,world,MPI_STATUS_IGNORE);
@@ -769,3 +811,69 @@ void WriteData::fix(Fix *ifix, int mth)
 
   memory->destroy(buf);
 }
+
+/* ----------------------------------------------------------------------
+   proc 0 writes header of binary section with nrows rows
+   types = Atom::DOUBLE or Atom::INT for each column
+------------------------------------------------------------------------- */
+
+void WriteData::binary_header(bigint nrows, const std::vector<int> &types)
+{
+  char magic[DATABIN_MAGIC_SIZE];
+  memset(magic,0,DATABIN_MAGIC_SIZE);
+  strcpy(magic,DATABIN_MAGIC);
+  int endian = DATABIN_ENDIAN;
+  int revision = DATABIN_REVISION;
+  int ncol = types.size();
+  std::vector<int> bintypes;
+  for (auto type : types) bintypes.push_back((type == Atom::DOUBLE) ? DATABIN_DOUBLE : DATABIN_INT);
+
+  fwrite(magic,sizeof(char),DATABIN_MAGIC_SIZE,fp);
+  fwrite(&endian,sizeof(int),1,fp);
+  fwrite(&revision,sizeof(int),1,fp);
+  fwrite(&nrows,sizeof(bigint),1,fp);
+  fwrite(&ncol,sizeof(int),1,fp);
+  fwrite(bintypes.data(),sizeof(int),ncol,fp);
+
+  binrows = nrows;
+  bincols = ncol;
+  binstart = platform::ftell(fp);
+  binoffset = 0;
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 writes next N rows of binary section
+   values are stored column by column, so each column is a contiguous array
+   ints in rows of Atoms and Velocities sections are already ubuf encoded
+------------------------------------------------------------------------- */
+
+void WriteData::binary_rows(int n, double **buf)
+{
+  std::vector<double> column(n);
+  for (int c = 0; c < bincols; c++) {
+    for (int i = 0; i < n; i++) column[i] = buf[i][c];
+    platform::fseek(fp,binstart + ((bigint) c*binrows + binoffset) * sizeof(double));
+    fwrite(column.data(),sizeof(double),n,fp);
+  }
+  binoffset += n;
+}
+
+void WriteData::binary_rows(int n, tagint **buf)
+{
+  std::vector<double> column(n);
+  for (int c = 0; c < bincols; c++) {
+    for (int i = 0; i < n; i++) column[i] = ubuf(buf[i][c]).d;
+    platform::fseek(fp,binstart + ((bigint) c*binrows + binoffset) * sizeof(double));
+    fwrite(column.data(),sizeof(double),n,fp);
+  }
+  binoffset += n;
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 positions file after last value of binary section
+------------------------------------------------------------------------- */
+
+void WriteData::binary_end()
+{
+  platform::fseek(fp,binstart + (bigint) bincols*binrows*sizeof(double));
+}
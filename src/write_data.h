@@ -22,6 +22,8 @@ CommandStyle(write_data,WriteData);
 
 #include "command.h"
 
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class WriteData : public Command {
@@ -35,12 +37,20 @@ class WriteData : public Command {
   int pairflag;
   int coeffflag;
   int fixflag;
+  int binaryflag;
   FILE *fp;
   bigint nbonds_local, nbonds;
   bigint nangles_local, nangles;
   bigint ndihedrals_local, ndihedrals;
   bigint nimpropers_local, nimpropers;
 
+  // current binary section
+
+  bigint binrows;      // # of rows
+  int bincols;         // # of columns
+  bigint binstart;     // file offset of first value
+  bigint binoffset;    // # of rows written so far
+
   void header();
   void type_arrays();
   void force_fields();
@@ -52,6 +62,11 @@ class WriteData : public Command {
   void impropers();
   void bonus(int);
   void fix(class Fix *, int);
+
+  void binary_header(bigint, const std::vector<int> &);
+  void binary_rows(int, double **);
+  void binary_rows(int, tagint **);
+  void binary_end();
 };
 
 }    // namespace LAMMPS_NS
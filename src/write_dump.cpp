@@ -84,6 +84,7 @@ void WriteDump::command(int narg, char **arg)
 
   dump->init();
   dump->write();
+  dump->wait_async();
 
   // delete the Dump instance and local storage
 
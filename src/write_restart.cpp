@@ -50,6 +50,21 @@ WriteRestart::WriteRestart(LAMMPS *lmp) : Command(lmp)
   multiproc = 0;
   noinit = 0;
   fp = nullptr;
+  asyncflag = 0;
+  async_error = 0;
+}
+
+/* ----------------------------------------------------------------------
+   complete a pending asynchronous write before the file is abandoned
+   cannot report I/O errors to all procs here, so just warn
+------------------------------------------------------------------------- */
+
+WriteRestart::~WriteRestart()
+{
+  if (asyncthread.joinable()) {
+    asyncthread.join();
+    if (async_error) error->warning(FLERR,"I/O error while writing restart");
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -83,6 +98,8 @@ void WriteRestart::command(int narg, char **arg)
   // also called by Output class for periodic restart files
 
   multiproc_options(multiproc,mpiioflag,narg-1,&arg[1]);
+  if (asyncflag)
+    error->all(FLERR,"Write_restart async option is only allowed with the restart command");
 
   // init entire system since comm->exchange is done
   // comm::init needs neighbor::init needs pair::init needs kspace::init, etc
@@ -199,8 +216,15 @@ void WriteRestart::multiproc_options(int multiproc_caller, int mpiioflag_caller,
     } else if (strcmp(arg[iarg],"noinit") == 0) {
       noinit = 1;
       iarg++;
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal write_restart command");
+      asyncflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else error->all(FLERR,"Illegal write_restart command");
   }
+
+  if (asyncflag && mpiioflag)
+    error->all(FLERR,"Restart file async output not allowed with MPI-IO");
 }
 
 /* ----------------------------------------------------------------------
@@ -210,6 +234,10 @@ void WriteRestart::multiproc_options(int multiproc_caller, int mpiioflag_caller,
 
 void WriteRestart::write(const std::string &file)
 {
+  // previous asynchronous write must be complete before starting a new one
+
+  wait_async();
+
   // special case where reneighboring is not done in integrator
   //   on timestep restart file is written (due to build_once being set)
   // if box is changing, must be reset, else restart file will have
@@ -380,7 +408,50 @@ void WriteRestart::write(const std::string &file)
 
     int tmp,recv_size;
 
-    if (filewriter) {
+    if (filewriter && asyncflag) {
+
+      // asynchronous output:
+      // receive data of all procs in my cluster into asyncbuf,
+      //   in the same layout as write_double_vec() followed by magic string
+      // helper thread writes asyncbuf to file and closes it while run continues
+      // helper thread must not call MPI or LAMMPS error functions
+
+      MPI_Status status;
+      MPI_Request request;
+      const char magic[] = MAGIC_STRING;
+      const bigint nheader = 2*sizeof(int);
+      int record[2] = {PERPROC, 0};
+      asyncbuf.clear();
+
+      for (int iproc = 0; iproc < nclusterprocs; iproc++) {
+        bigint offset = asyncbuf.size();
+        asyncbuf.resize(offset + nheader + (bigint) max_size*sizeof(double));
+        auto data = (double *) &asyncbuf[offset+nheader];
+        if (iproc) {
+          MPI_Irecv(data,max_size,MPI_DOUBLE,me+iproc,0,world,&request);
+          MPI_Send(&tmp,0,MPI_INT,me+iproc,0,world);
+          MPI_Wait(&request,&status);
+          MPI_Get_count(&status,MPI_DOUBLE,&recv_size);
+        } else {
+          recv_size = send_size;
+          memcpy(data,buf,send_size*sizeof(double));
+        }
+        record[1] = recv_size;
+        memcpy(&asyncbuf[offset],record,nheader);
+        asyncbuf.resize(offset + nheader + (bigint) recv_size*sizeof(double));
+      }
+      asyncbuf.insert(asyncbuf.end(),magic,magic+strlen(magic)+1);
+
+      FILE *afp = fp;
+      fp = nullptr;
+      async_error = 0;
+      asyncthread = std::thread([this,afp]() {
+        fwrite(asyncbuf.data(),sizeof(char),asyncbuf.size(),afp);
+        if (ferror(afp)) async_error = 1;
+        if (fclose(afp) != 0) async_error = 1;
+      });
+
+    } else if (filewriter) {
       MPI_Status status;
       MPI_Request request;
       for (int iproc = 0; iproc < nclusterprocs; iproc++) {
@@ -603,6 +674,25 @@ void WriteRestart::file_layout(int send_size)
   }
 }
 
+/* ----------------------------------------------------------------------
+   wait until helper thread of a pending asynchronous write is done
+   called by all procs, so I/O errors of the helper threads can be reported
+------------------------------------------------------------------------- */
+
+void WriteRestart::wait_async()
+{
+  if (!asyncflag) return;
+
+  if (asyncthread.joinable()) asyncthread.join();
+  asyncbuf.clear();
+  asyncbuf.shrink_to_fit();
+
+  int io_all = 0;
+  MPI_Allreduce(&async_error,&io_all,1,MPI_INT,MPI_MAX,world);
+  async_error = 0;
+  if (io_all) error->all(FLERR,"I/O error while writing restart");
+}
+
 // ----------------------------------------------------------------------
 // ----------------------------------------------------------------------
 // low-level fwrite methods
@@ -22,11 +22,15 @@ CommandStyle(write_restart,WriteRestart);
 
 #include "command.h"
 
+#include <thread>
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class WriteRestart : public Command {
  public:
   WriteRestart(class LAMMPS *);
+  ~WriteRestart() override;
   void command(int, char **) override;
   void multiproc_options(int, int, int, char **);
   void write(const std::string &);
@@ -50,6 +54,15 @@ class WriteRestart : public Command {
   class RestartMPIIO *mpiio;    // MPIIO for restart file output
   MPI_Offset headerOffset;
 
+  // asynchronous output
+
+  int asyncflag;                 // 1 if file writers write atom data on a helper thread
+  int async_error;               // 1 if I/O error in asynchronous write, set by helper thread
+  std::thread asyncthread;       // helper thread of pending asynchronous write
+  std::vector<char> asyncbuf;    // atom data of my cluster for pending asynchronous write
+
+  void wait_async();
+
   void header();
   void type_arrays();
   void force_fields();
@@ -0,0 +1,226 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "atom.h"
+#include "force.h"
+#include "info.h"
+#include "input.h"
+#include "kspace.h"
+#include "lammps.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace LAMMPS_NS {
+
+class KSpaceIntervalTest : public LAMMPSTest {
+protected:
+    void InitSystem() override
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("units           lj");
+        command("atom_style      charge");
+        command("atom_modify     map array");
+        command("lattice         fcc 0.8442");
+        command("region          box block 0 4 0 4 0 4");
+        command("create_box      2 box");
+        command("create_atoms    1 box");
+        command("mass            * 1.0");
+        command("set             group all type/ratio 2 0.5 4719");
+        command("set             type 1 charge 1.0");
+        command("set             type 2 charge -1.0");
+        command("displace_atoms  all random 0.05 0.05 0.05 8723");
+        command("velocity        all create 1.0 87287 loop geom");
+
+        command("pair_style      lj/cut/coul/long 2.5");
+        command("pair_coeff      * * 1.0 1.0");
+        command("kspace_style    pppm 1.0e-5");
+        command("timestep        0.002");
+        command("thermo_style    custom step pe elong etotal press");
+        END_HIDE_OUTPUT();
+    }
+
+    std::vector<double> get_forces()
+    {
+        std::vector<double> f(3 * lmp->atom->nlocal);
+        for (int i = 0; i < lmp->atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                f[3 * i + k] = lmp->atom->f[i][k];
+        return f;
+    }
+};
+
+TEST_F(KSpaceIntervalTest, keyword)
+{
+    ASSERT_EQ(lmp->force->kspace->interval, 1);
+    command("kspace_modify interval 4");
+    ASSERT_EQ(lmp->force->kspace->interval, 4);
+    TEST_FAILURE(".*ERROR: Illegal kspace_modify interval value: 0.*",
+                 command("kspace_modify interval 0"););
+    TEST_FAILURE(".*ERROR: Illegal kspace_modify command.*", command("kspace_modify interval"););
+
+    command("run_style respa 2 2 pair 1 kspace 2");
+    TEST_FAILURE(".*ERROR: Kspace_modify interval > 1 requires run_style verlet.*",
+                 command("run 0 post no"););
+}
+
+TEST_F(KSpaceIntervalTest, impulse)
+{
+    // KSpace forces are scaled by N on a step with a solve, energy and virial are not
+
+    BEGIN_HIDE_OUTPUT();
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    auto f1       = get_forces();
+    double elong1 = lmp->force->kspace->energy;
+    double vxx1   = lmp->force->kspace->virial[0];
+
+    BEGIN_HIDE_OUTPUT();
+    command("kspace_modify interval 2");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    auto f2 = get_forces();
+    EXPECT_NEAR(lmp->force->kspace->energy, elong1, 1.0e-12 * fabs(elong1));
+    EXPECT_NEAR(lmp->force->kspace->virial[0], vxx1, 1.0e-12 * fabs(elong1));
+
+    BEGIN_HIDE_OUTPUT();
+    command("kspace_modify interval 3");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    auto f3 = get_forces();
+
+    double fmax = 0.0;
+    for (std::size_t i = 0; i < f1.size(); ++i)
+        fmax = fmax > fabs(f2[i] - f1[i]) ? fmax : fabs(f2[i] - f1[i]);
+    ASSERT_GT(fmax, 1.0e-3);
+    for (std::size_t i = 0; i < f1.size(); ++i)
+        EXPECT_NEAR(f3[i] - f2[i], f2[i] - f1[i], 1.0e-10 * fmax);
+}
+
+TEST_F(KSpaceIntervalTest, skipped)
+{
+    // between solves the KSpace energy of the last solve is reported
+
+    BEGIN_HIDE_OUTPUT();
+    command("kspace_modify interval 3");
+    command("fix 1 all nve");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    double elong0 = lmp->force->kspace->energy;
+
+    BEGIN_HIDE_OUTPUT();
+    command("run 2 post no");
+    END_HIDE_OUTPUT();
+    EXPECT_DOUBLE_EQ(lmp->force->kspace->energy, elong0);
+
+    BEGIN_HIDE_OUTPUT();
+    command("run 3 post no");
+    END_HIDE_OUTPUT();
+    EXPECT_NE(lmp->force->kspace->energy, elong0);
+}
+
+TEST_F(KSpaceIntervalTest, nve)
+{
+    // with a KSpace solve every 2nd step, the trajectory follows the one with every step
+    //   and the total energy drift stays small
+
+    double e0, eref, e1;
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all nve");
+    command("variable etot equal etotal");
+    command("thermo 100");
+    command("run 0 post no");
+    e0 = get_variable_value("etot");
+    command("run 200 post no");
+    eref = get_variable_value("etot");
+    command("clear");
+    END_HIDE_OUTPUT();
+
+    InitSystem();
+    BEGIN_HIDE_OUTPUT();
+    command("kspace_modify interval 2");
+    command("fix 1 all nve");
+    command("variable etot equal etotal");
+    command("thermo 100");
+    command("run 200 post no");
+    e1 = get_variable_value("etot");
+    END_HIDE_OUTPUT();
+
+    EXPECT_NEAR(e1, eref, 1.0e-5 * fabs(eref));
+    EXPECT_LT(fabs(e1 - e0), 5.0e-3 * fabs(e0));
+}
+
+TEST_F(KSpaceIntervalTest, npt)
+{
+    // the barostat of fix npt sees the KSpace virial of the last solve in between
+
+    double eref, vref, e1, v1;
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all npt temp 1.0 1.0 0.2 iso 1.0 1.0 2.0");
+    command("variable etot equal etotal");
+    command("variable vol equal vol");
+    command("thermo 100");
+    command("run 200 post no");
+    eref = get_variable_value("etot");
+    vref = get_variable_value("vol");
+    command("clear");
+    END_HIDE_OUTPUT();
+
+    InitSystem();
+    BEGIN_HIDE_OUTPUT();
+    command("kspace_modify interval 2");
+    command("fix 1 all npt temp 1.0 1.0 0.2 iso 1.0 1.0 2.0");
+    command("variable etot equal etotal");
+    command("variable vol equal vol");
+    command("thermo 100");
+    command("run 200 post no");
+    e1 = get_variable_value("etot");
+    v1 = get_variable_value("vol");
+    END_HIDE_OUTPUT();
+
+    EXPECT_NEAR(e1, eref, 1.0e-5 * fabs(eref));
+    EXPECT_NEAR(v1, vref, 1.0e-5 * vref);
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    if (LAMMPS_NS::platform::mpi_vendor() == "Open MPI" && !LAMMPS_NS::Info::has_exceptions())
+        std::cout << "Warning: using OpenMPI without exceptions. "
+                     "Death tests will be skipped\n";
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -0,0 +1,208 @@
+// unit tests for mixed precision ghost atom communication
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "domain.h"
+#include "force.h"
+#include "input.h"
+#include "lammps.h"
+#include "pair.h"
+#include <cfloat>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPICommPrecisionTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        const char *args[] = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        InitSystem();
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    virtual void InitSystem()
+    {
+        command("units           lj");
+        command("atom_style      atomic");
+        command("atom_modify     map array");
+
+        command("lattice         fcc 0.8442");
+        command("region          box block 0 6 0 6 0 6");
+        command("create_box      1 box");
+        command("create_atoms    1 box");
+        command("mass            1 1.0");
+        command("displace_atoms  all random 0.05 0.05 0.05 8723");
+
+        command("pair_style      lj/cut 2.5");
+        command("pair_coeff      1 1 1.0 1.0 2.5");
+        command("newton          on");
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // run 0 and collect total pair energy and forces ordered by atom ID
+
+    double run_forces(std::vector<double> &f)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("run 0 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        return get_forces(f);
+    }
+
+    // collect total pair energy and forces of the last step ordered by atom ID
+
+    double get_forces(std::vector<double> &f)
+    {
+        auto atom  = lmp->atom;
+        int natoms = atom->natoms;
+        std::vector<double> flocal(3 * natoms, 0.0);
+        for (int i = 0; i < atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                flocal[3 * (atom->tag[i] - 1) + k] = atom->f[i][k];
+        f.resize(3 * natoms);
+        MPI_Allreduce(flocal.data(), f.data(), 3 * natoms, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+        double one = lmp->force->pair->eng_vdwl;
+        double all;
+        MPI_Allreduce(&one, &all, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        return all;
+    }
+};
+
+TEST_F(MPICommPrecisionTest, keyword)
+{
+    ASSERT_EQ(lmp->comm->precision, Comm::DOUBLE);
+    command("comm_modify precision mixed");
+    ASSERT_EQ(lmp->comm->precision, Comm::MIXED);
+    command("comm_modify precision double");
+    ASSERT_EQ(lmp->comm->precision, Comm::DOUBLE);
+}
+
+TEST_F(MPICommPrecisionTest, ghost_coords)
+{
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("run 0 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    auto atom  = lmp->atom;
+    int nlocal = atom->nlocal;
+    int nall   = nlocal + atom->nghost;
+    std::vector<double> xref(3 * nall);
+    for (int i = nlocal; i < nall; ++i)
+        for (int k = 0; k < 3; ++k)
+            xref[3 * i + k] = atom->x[i][k];
+
+    // ghost coords of atoms from other procs are sent as float offsets,
+    // owned coords must be unchanged
+
+    command("comm_modify precision mixed");
+    lmp->comm->forward_comm();
+
+    double maxerr = 0.0;
+    for (int i = nlocal; i < nall; ++i)
+        for (int k = 0; k < 3; ++k)
+            maxerr = fmax(maxerr, fabs(atom->x[i][k] - xref[3 * i + k]));
+    double allerr;
+    MPI_Allreduce(&maxerr, &allerr, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+    // documented bound: a few float roundings of offsets
+    // no larger than the box length
+
+    double prd   = lmp->domain->xprd;
+    double bound = 3.0 * FLT_EPSILON * prd;
+    EXPECT_LE(allerr, bound);
+    if (lmp->comm->nprocs > 1) EXPECT_GT(allerr, 0.0);
+}
+
+TEST_F(MPICommPrecisionTest, forces)
+{
+    std::vector<double> fref, fmixed;
+    double eref = run_forces(fref);
+
+    command("comm_modify precision mixed");
+    double emixed = run_forces(fmixed);
+
+    double fscale = 0.0;
+    for (auto &f : fref)
+        fscale = fmax(fscale, fabs(f));
+
+    EXPECT_NEAR(emixed, eref, 1.0e-6 * fabs(eref));
+    for (std::size_t i = 0; i < fref.size(); ++i)
+        EXPECT_NEAR(fmixed[i], fref[i], 1.0e-4 * fscale);
+
+    // switching back restores identical results
+
+    command("comm_modify precision double");
+    std::vector<double> fdouble;
+    double edouble = run_forces(fdouble);
+    EXPECT_DOUBLE_EQ(edouble, eref);
+    for (std::size_t i = 0; i < fref.size(); ++i)
+        EXPECT_DOUBLE_EQ(fdouble[i], fref[i]);
+}
+
+TEST_F(MPICommPrecisionTest, box_change)
+{
+    // the box changes between reneighborings, so ghost coords must use
+    //   the PBC shift of the current box, not of the last borders()
+
+    std::vector<double> fref, fmixed;
+    double eref, emixed;
+
+    command("velocity        all create 1.0 87287 loop geom");
+    command("fix             1 all nve");
+    command("fix             2 all deform 1 x erate 0.05 y erate -0.05 remap x");
+    command("neigh_modify    every 20 delay 0 check no");
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("run 10 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    eref = get_forces(fref);
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("clear");
+    InitSystem();
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    command("comm_modify     precision mixed");
+    command("velocity        all create 1.0 87287 loop geom");
+    command("fix             1 all nve");
+    command("fix             2 all deform 1 x erate 0.05 y erate -0.05 remap x");
+    command("neigh_modify    every 20 delay 0 check no");
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("run 10 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    emixed = get_forces(fmixed);
+
+    double fscale = 0.0;
+    for (auto &f : fref)
+        fscale = fmax(fscale, fabs(f));
+
+    EXPECT_NEAR(emixed, eref, 1.0e-6 * fabs(eref));
+    for (std::size_t i = 0; i < fref.size(); ++i)
+        EXPECT_NEAR(fmixed[i], fref[i], 1.0e-4 * fscale);
+}
+} // namespace LAMMPS_NS
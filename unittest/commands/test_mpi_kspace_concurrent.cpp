@@ -0,0 +1,227 @@
+// unit tests for KSpace computed concurrently on a second partition
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "compute.h"
+#include "force.h"
+#include "input.h"
+#include "kspace.h"
+#include "lammps.h"
+#include "modify.h"
+#include "universe.h"
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+// per-atom and global KSpace results of a run 0, per-atom data ordered by atom ID
+
+struct KSpaceResult {
+    std::vector<double> f, eatom, vatom;
+    double energy;
+    double virial[6];
+};
+
+class MPIKSpaceConcurrentTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        int nprocs;
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+        if (nprocs != 4) GTEST_SKIP() << "requires 4 MPI processes";
+
+        const char *args[] = {testbinary, "-partition", "2x2",  "-in",   "none", "-log",
+                              "none",     "-plog",      "none", "-pscreen", "none", "-echo",
+                              "none",     "-nocite"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        InitSystem();
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // charge neutral LJ melt with random displacements, so KSpace forces do not cancel
+
+    virtual void InitSystem()
+    {
+        command("units           lj");
+        command("atom_style      charge");
+        command("atom_modify     map array");
+
+        command("lattice         fcc 0.8442");
+        command("region          box block 0 6 0 6 0 6");
+        command("create_box      2 box");
+        command("create_atoms    1 box");
+        command("mass            * 1.0");
+        command("set             group all type/ratio 2 0.5 4719");
+        command("set             type 1 charge 1.0");
+        command("set             type 2 charge -1.0");
+        command("displace_atoms  all random 0.05 0.05 0.05 8723");
+
+        command("pair_style      lj/cut/coul/long 2.5");
+        command("pair_coeff      * * 1.0 1.0");
+        command("kspace_style    pppm 1.0e-5");
+
+        command("compute         pea all pe/atom kspace");
+        command("compute         sta all stress/atom NULL kspace");
+        command("thermo_style    custom step pe press");
+    }
+
+    void TearDown() override
+    {
+        if (!lmp) return;
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // run 0 on both partitions, collect results on the 1st partition only
+    //   since atoms of the 2nd partition are only copies with concurrent KSpace
+
+    void run_kspace(KSpaceResult &result)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("run 0 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        if (lmp->universe->iworld != 0) return;
+
+        auto atom  = lmp->atom;
+        int natoms = atom->natoms;
+        auto pea   = lmp->modify->get_compute_by_id("pea");
+        auto sta   = lmp->modify->get_compute_by_id("sta");
+        pea->compute_peratom();
+        sta->compute_peratom();
+
+        std::vector<double> flocal(3 * natoms, 0.0), elocal(natoms, 0.0), vlocal(6 * natoms, 0.0);
+        for (int i = 0; i < atom->nlocal; ++i) {
+            int itag = atom->tag[i] - 1;
+            for (int k = 0; k < 3; ++k)
+                flocal[3 * itag + k] = atom->f[i][k];
+            elocal[itag] = pea->vector_atom[i];
+            for (int k = 0; k < 6; ++k)
+                vlocal[6 * itag + k] = sta->array_atom[i][k];
+        }
+        result.f.resize(3 * natoms);
+        result.eatom.resize(natoms);
+        result.vatom.resize(6 * natoms);
+        MPI_Allreduce(flocal.data(), result.f.data(), 3 * natoms, MPI_DOUBLE, MPI_SUM, lmp->world);
+        MPI_Allreduce(elocal.data(), result.eatom.data(), natoms, MPI_DOUBLE, MPI_SUM, lmp->world);
+        MPI_Allreduce(vlocal.data(), result.vatom.data(), 6 * natoms, MPI_DOUBLE, MPI_SUM,
+                      lmp->world);
+
+        result.energy = lmp->force->kspace->energy;
+        for (int k = 0; k < 6; ++k)
+            result.virial[k] = lmp->force->kspace->virial[k];
+    }
+
+    void compare(const KSpaceResult &ref, const KSpaceResult &res)
+    {
+        if (lmp->universe->iworld != 0) return;
+
+        EXPECT_NEAR(res.energy, ref.energy, 1.0e-10 * fabs(ref.energy));
+        for (int k = 0; k < 6; ++k)
+            EXPECT_NEAR(res.virial[k], ref.virial[k], 1.0e-10 * fabs(ref.energy));
+
+        double fscale = 0.0, escale = 0.0, vscale = 0.0;
+        for (auto &f : ref.f)
+            fscale = fmax(fscale, fabs(f));
+        for (auto &e : ref.eatom)
+            escale = fmax(escale, fabs(e));
+        for (auto &v : ref.vatom)
+            vscale = fmax(vscale, fabs(v));
+        ASSERT_GT(fscale, 0.0);
+        ASSERT_GT(escale, 0.0);
+        ASSERT_GT(vscale, 0.0);
+
+        for (std::size_t i = 0; i < ref.f.size(); ++i)
+            EXPECT_NEAR(res.f[i], ref.f[i], 1.0e-10 * fscale);
+        for (std::size_t i = 0; i < ref.eatom.size(); ++i)
+            EXPECT_NEAR(res.eatom[i], ref.eatom[i], 1.0e-10 * escale);
+        for (std::size_t i = 0; i < ref.vatom.size(); ++i)
+            EXPECT_NEAR(res.vatom[i], ref.vatom[i], 1.0e-10 * vscale);
+    }
+};
+
+TEST_F(MPIKSpaceConcurrentTest, keyword)
+{
+    ASSERT_EQ(lmp->force->kspace->concurrent_flag, 0);
+    command("kspace_modify concurrent yes");
+    ASSERT_EQ(lmp->force->kspace->concurrent_flag, 1);
+    command("kspace_modify concurrent no");
+    ASSERT_EQ(lmp->force->kspace->concurrent_flag, 0);
+}
+
+TEST_F(MPIKSpaceConcurrentTest, verlet)
+{
+    KSpaceResult ref, res;
+    run_kspace(ref);
+
+    command("kspace_modify concurrent yes");
+    run_kspace(res);
+    compare(ref, res);
+}
+
+TEST_F(MPIKSpaceConcurrentTest, respa)
+{
+    command("run_style respa 2 2 pair 1 kspace 2");
+
+    KSpaceResult ref, res;
+    run_kspace(ref);
+
+    command("kspace_modify concurrent yes");
+    run_kspace(res);
+    compare(ref, res);
+}
+
+TEST_F(MPIKSpaceConcurrentTest, rerouting)
+{
+    // atoms move between KSpace procs when neighbor lists are rebuilt during a run
+
+    command("velocity all create 3.0 87287 loop geom");
+    command("fix 1 all nve");
+    command("neigh_modify every 1 delay 0 check yes");
+
+    KSpaceResult ref, res;
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("run 20 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    run_kspace(ref);
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("clear");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    InitSystem();
+    command("velocity all create 3.0 87287 loop geom");
+    command("fix 1 all nve");
+    command("neigh_modify every 1 delay 0 check yes");
+    command("kspace_modify concurrent yes");
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("run 20 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    run_kspace(res);
+
+    // trajectories diverge slowly from different summation order, so only compare loosely
+
+    if (lmp->universe->iworld != 0) return;
+    EXPECT_NEAR(res.energy, ref.energy, 1.0e-6 * fabs(ref.energy));
+    double fscale = 0.0;
+    for (auto &f : ref.f)
+        fscale = fmax(fscale, fabs(f));
+    for (std::size_t i = 0; i < ref.f.size(); ++i)
+        EXPECT_NEAR(res.f[i], ref.f[i], 1.0e-6 * fscale);
+}
+} // namespace LAMMPS_NS
@@ -4,11 +4,14 @@
 #include "atom.h"
 #include "comm.h"
 #include "domain.h"
+#include "exceptions.h"
+#include "fmt/format.h"
 #include "info.h"
 #include "input.h"
 #include "lammps.h"
 #include "neighbor.h"
 #include "timer.h"
+#include <cstring>
 #include <string>
 
 #include "gmock/gmock.h"
@@ -252,4 +255,261 @@ TEST_F(MPILoadBalanceTest, rcb_min_size)
     ASSERT_GT(dz, lmp->neighbor->skin);
 }
 
+// chains of 4 atoms along x, 5 chains per line with gaps in between
+// median cuts split chains, graph style moves the cuts into the gaps
+
+class MPIGraphBalanceTest : public MPILoadBalanceTest {
+protected:
+    void InitSystem() override
+    {
+        if (!Info::has_package("MOLECULE")) return;
+        command("boundary        f f f");
+        command("units           lj");
+        command("atom_style      bond");
+        command("atom_modify     map array");
+        command("comm_style      tiled");
+
+        command("region          box block 0 20 0 20 0 20");
+        command("create_box      1 box bond/types 1 extra/bond/per/atom 2 extra/special/per/atom 6");
+        command("mass            1 1.0");
+
+        int id = 0;
+        for (int j = 0; j < 4; ++j) {
+            for (int l = 0; l < 4; ++l) {
+                for (int c = 0; c < 5; ++c) {
+                    for (int k = 0; k < 4; ++k) {
+                        command(fmt::format("create_atoms 1 single {} {} {}", 0.8 * (5 * c + k) + 0.1,
+                                            2.0 + 1.5 * j, 2.0 + 1.5 * l));
+                        ++id;
+                        if (k > 0)
+                            command(fmt::format("create_bonds single/bond 1 {} {} special no", id - 1,
+                                                id));
+                    }
+                }
+            }
+        }
+        command("special_bonds   lj 0.0 1.0 1.0");
+
+        command("pair_style      zero 1.0");
+        command("pair_coeff      * *");
+        command("bond_style      zero");
+        command("bond_coeff      1 0.8");
+    }
+
+    // number of bonds whose partner is not owned by the same proc
+
+    bigint broken_bonds()
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("run 0 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        auto atom   = lmp->atom;
+        bigint nmine = 0;
+        for (int i = 0; i < atom->nlocal; ++i) {
+            for (int m = 0; m < atom->num_bond[i]; ++m) {
+                int j = atom->map(atom->bond_atom[i][m]);
+                if ((j < 0) || (j >= atom->nlocal)) ++nmine;
+            }
+        }
+        bigint nall;
+        MPI_Allreduce(&nmine, &nall, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+        return nall;
+    }
+};
+
+TEST_F(MPIGraphBalanceTest, graph)
+{
+    if (!Info::has_package("MOLECULE")) GTEST_SKIP();
+    ASSERT_EQ(lmp->atom->natoms, 320);
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("balance 1.0 rcb");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    bigint nrcb = broken_bonds();
+
+    // zero tolerance reproduces rcb
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("balance 1.0 graph 0.0");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    ASSERT_EQ(broken_bonds(), nrcb);
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("balance 1.0 graph 0.5");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    bigint ngraph = broken_bonds();
+
+    bigint nlocal = lmp->atom->nlocal;
+    bigint natoms;
+    MPI_Allreduce(&nlocal, &natoms, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+    ASSERT_EQ(natoms, 320);
+
+    if (lmp->comm->nprocs > 1) {
+        ASSERT_GT(nrcb, 0);
+        ASSERT_LT(ngraph, nrcb);
+    }
+}
+
+TEST_F(MPIGraphBalanceTest, graph_empty_procs)
+{
+    if (!Info::has_package("MOLECULE")) GTEST_SKIP();
+
+    // initially, only some procs own atoms
+
+    bigint nlocal = lmp->atom->nlocal;
+    bigint nempty = (nlocal == 0) ? 1 : 0;
+    bigint nall;
+    MPI_Allreduce(&nempty, &nall, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+    if (lmp->comm->nprocs > 1) ASSERT_GT(nall, 0);
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("balance 1.0 graph 0.5");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    nlocal = lmp->atom->nlocal;
+    ASSERT_GT(nlocal, 0);
+    MPI_Allreduce(&nlocal, &nall, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+    ASSERT_EQ(nall, 320);
+}
+
+TEST_F(MPIGraphBalanceTest, graph_nbx)
+{
+    if (!Info::has_package("MOLECULE")) GTEST_SKIP();
+
+    // sparse exchange of message counts in Irregular and Comm::rendezvous()
+    //   must give the same decomposition as the collective one
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("balance 1.0 graph 0.5");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    bigint nref   = broken_bonds();
+    int nlocalref = lmp->atom->nlocal;
+    double splitref[3][2];
+    memcpy(splitref, lmp->comm->mysplit, sizeof(splitref));
+
+    command("comm_modify nbx 2");
+    ASSERT_EQ(lmp->comm->nbx_minprocs, 2);
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("balance 1.0 rcb");
+    command("balance 1.0 graph 0.5");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    ASSERT_EQ(broken_bonds(), nref);
+    ASSERT_EQ(lmp->atom->nlocal, nlocalref);
+    for (int k = 0; k < 3; ++k) {
+        ASSERT_DOUBLE_EQ(lmp->comm->mysplit[k][0], splitref[k][0]);
+        ASSERT_DOUBLE_EQ(lmp->comm->mysplit[k][1], splitref[k][1]);
+    }
+
+    bigint nlocal = lmp->atom->nlocal;
+    bigint natoms;
+    MPI_Allreduce(&nlocal, &natoms, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+    ASSERT_EQ(natoms, 320);
+}
+
+class MPIAdaptiveBalanceTest : public MPILoadBalanceTest {
+protected:
+    // periodic box with one proc per 4 lattice planes in x
+    //   pair style zero, so atoms can be moved into each other
+
+    void InitSystem() override
+    {
+        command("units           lj");
+        command("atom_style      atomic");
+        command("atom_modify     map yes");
+        command("processors      4 1 1");
+
+        command("lattice         sc 1.0");
+        command("region          box block 0 16 0 8 0 8");
+        command("region          left block 0 7.5 0 8 0 8");
+        command("create_box      1 box");
+        command("mass            1 1.0");
+
+        command("pair_style      zero 2.5");
+        command("pair_coeff      * *");
+
+        command("neighbor        0.3 bin");
+        command("neigh_modify    every 1 delay 0 check yes");
+    }
+
+    // max/ave number of atoms per proc
+
+    double imbalance()
+    {
+        bigint nlocal = lmp->atom->nlocal;
+        bigint nmax, nall;
+        MPI_Allreduce(&nlocal, &nmax, 1, MPI_LMP_BIGINT, MPI_MAX, MPI_COMM_WORLD);
+        MPI_Allreduce(&nlocal, &nall, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+        return (double)nmax * lmp->comm->nprocs / (double)nall;
+    }
+};
+
+TEST_F(MPIAdaptiveBalanceTest, setup)
+{
+    if (lmp->comm->nprocs != 4) GTEST_SKIP();
+
+    // all atoms on the two left procs are re-balanced during setup
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("create_atoms    1 region left");
+    command("fix             bal all balance 50 1.1 shift x 20 1.05 adaptive yes");
+    command("run             0 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    ASSERT_EQ(lmp->atom->natoms, 512);
+    ASSERT_LT(lmp->comm->xsplit[2], 0.5);
+    ASSERT_LT(imbalance(), 1.3);
+}
+
+TEST_F(MPIAdaptiveBalanceTest, run)
+{
+    if (lmp->comm->nprocs != 4) GTEST_SKIP();
+
+    // left half of the atoms moves 4.5 planes into the right half, so without
+    //   re-balancing the 3rd proc ends up with twice the average number of atoms
+    // with timers off, the imbalance threshold alone triggers the re-balance
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("create_atoms    1 box");
+    command("group           left region left");
+    command("timer           off");
+    command("timestep        0.005");
+    command("fix             move left move linear 0.9 0.0 0.0");
+    command("fix             bal all balance 50 1.1 shift x 20 1.05 adaptive yes");
+    command("run             0 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    ASSERT_EQ(lmp->atom->natoms, 1024);
+    ASSERT_DOUBLE_EQ(imbalance(), 1.0);
+    ASSERT_DOUBLE_EQ(lmp->comm->xsplit[1], 0.25);
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("run             1000 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    ASSERT_EQ(lmp->atom->natoms, 1024);
+    ASSERT_GT(lmp->comm->xsplit[1], 0.3);
+    ASSERT_LT(imbalance(), 1.5);
+}
+
+TEST_F(MPIAdaptiveBalanceTest, tiled)
+{
+    if (!Info::has_exceptions()) GTEST_SKIP();
+
+    // tiled decompositions are recomputed from scratch, not shifted
+
+    command("comm_style      tiled");
+    command("create_atoms    1 region left");
+    if (!verbose) ::testing::internal::CaptureStdout();
+    std::string mesg;
+    try {
+        command("fix bal all balance 50 1.1 rcb adaptive yes");
+    } catch (LAMMPSException &e) {
+        mesg = e.what();
+    }
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    ASSERT_THAT(mesg, HasSubstr("Fix balance adaptive requires balance style shift"));
+}
+
 } // namespace LAMMPS_NS
@@ -13,6 +13,7 @@
 
 #include "lammps.h"
 
+#include "atom.h"
 #include "citeme.h"
 #include "comm.h"
 #include "force.h"
@@ -241,6 +242,44 @@ TEST_F(SimpleCommandsTest, ResetTimestep)
     TEST_FAILURE(".*ERROR: Expected integer .*", command("reset_timestep xxx"););
 }
 
+TEST_F(SimpleCommandsTest, AtomModifySoa)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("atom_modify soa yes");
+    command("lattice sc 1.0");
+    command("region box block 0 4 0 4 0 4");
+    command("create_box 1 box");
+    command("create_atoms 1 box");
+    command("mass 1 1.0");
+    command("pair_style lj/cut 2.5");
+    command("pair_coeff * * 1.0 1.0");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->soa_active, 1);
+    ASSERT_NE(lmp->atom->xsoa[0], nullptr);
+    ASSERT_GE(lmp->atom->maxsoa, lmp->atom->nlocal + lmp->atom->nghost);
+
+    // the copy is not maintained if the pair style does not read it
+
+    BEGIN_CAPTURE_OUTPUT();
+    command("pair_style zero 2.5");
+    command("pair_coeff * *");
+    command("run 0 post no");
+    auto mesg = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(mesg, ContainsRegex(".*WARNING: Atom_modify soa has no effect with pair style zero.*"));
+    ASSERT_EQ(lmp->atom->soa_active, 0);
+    ASSERT_EQ(lmp->atom->xsoa[0], nullptr);
+
+    BEGIN_HIDE_OUTPUT();
+    command("pair_style lj/cut 2.5");
+    command("pair_coeff * * 1.0 1.0");
+    command("atom_modify soa no");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->soa_active, 0);
+    ASSERT_EQ(lmp->atom->xsoa[0], nullptr);
+}
+
 TEST_F(SimpleCommandsTest, Suffix)
 {
     ASSERT_EQ(lmp->suffix_enable, 0);
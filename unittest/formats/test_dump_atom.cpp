@@ -597,6 +597,73 @@ TEST_F(DumpAtomTest, per_processor_multi_file_run1)
     delete_file(run1_p0_1);
 }
 
+TEST_F(DumpAtomTest, sort_id_run0)
+{
+    auto dump_file = dump_filename("sort_id_run0");
+    generate_dump(dump_file, "sort id", 0);
+
+    ASSERT_FILE_EXISTS(dump_file);
+    auto lines = read_lines(dump_file);
+    ASSERT_EQ(lines.size(), 41);
+    for (int i = 9; i < 41; ++i)
+        ASSERT_EQ(std::stoi(utils::split_words(lines[i])[0]), i - 8);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpAtomTest, sort_descend_run0)
+{
+    auto dump_file = dump_filename("sort_descend_run0");
+    generate_dump(dump_file, "sort -3", 0);
+
+    ASSERT_FILE_EXISTS(dump_file);
+    auto lines = read_lines(dump_file);
+    ASSERT_EQ(lines.size(), 41);
+    for (int i = 10; i < 41; ++i)
+        ASSERT_GE(std::stod(utils::split_words(lines[i - 1])[2]),
+                  std::stod(utils::split_words(lines[i])[2]));
+    delete_file(dump_file);
+}
+
+TEST_F(DumpAtomTest, per_processor_sort_nfile_run0)
+{
+    auto dump_file = dump_filename("sort_nfile_p%");
+    generate_dump(dump_file, "sort id nfile 1", 0);
+
+    auto sort_nfile_p0 = dump_filename("sort_nfile_p0");
+    ASSERT_FILE_EXISTS(sort_nfile_p0);
+    auto lines = read_lines(sort_nfile_p0);
+    ASSERT_EQ(lines.size(), 41);
+    ASSERT_THAT(lines[9], Eq("1 1 0 0 0"));
+    delete_file(sort_nfile_p0);
+}
+
+TEST_F(DumpAtomTest, async_run2)
+{
+    auto dump_file = dump_filename("async_run2");
+    generate_dump(dump_file, "async yes", 2);
+    close_dump();
+
+    ASSERT_FILE_EXISTS(dump_file);
+    ASSERT_EQ(count_lines(dump_file), 123);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpAtomTest, async_multi_file_run1)
+{
+    auto dump_file = dump_filename("async_run1_*");
+    generate_dump(dump_file, "buffer no async yes", 1);
+    close_dump();
+
+    auto run1_0 = dump_filename("async_run1_0");
+    auto run1_1 = dump_filename("async_run1_1");
+    ASSERT_FILE_EXISTS(run1_0);
+    ASSERT_FILE_EXISTS(run1_1);
+    ASSERT_EQ(count_lines(run1_0), 41);
+    ASSERT_EQ(count_lines(run1_1), 41);
+    delete_file(run1_0);
+    delete_file(run1_1);
+}
+
 TEST_F(DumpAtomTest, dump_modify_scale_invalid)
 {
     BEGIN_HIDE_OUTPUT();
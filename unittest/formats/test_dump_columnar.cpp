@@ -0,0 +1,259 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "../testing/systems/melt.h"
+#include "../testing/utils.h"
+#include "fmt/format.h"
+#include "info.h"
+#include "output.h"
+#include "thermo.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstring>
+
+using ::testing::ContainsRegex;
+using ::testing::Eq;
+using ::testing::Ne;
+
+bool verbose = false;
+
+class DumpColumnarTest : public MeltTest {
+    std::string dump_style = "columnar";
+
+public:
+    void enable_triclinic()
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("change_box all triclinic");
+        END_HIDE_OUTPUT();
+    }
+
+    std::string dump_filename(std::string ident)
+    {
+        return fmt::format("dump_{}_{}.melt", dump_style, ident);
+    }
+
+    void generate_dump(std::string dump_file, std::string fields, std::string dump_modify_options,
+                       int ntimesteps)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command(fmt::format("dump id all {} 1 {} {}", dump_style, dump_file, fields));
+
+        if (!dump_modify_options.empty()) {
+            command(fmt::format("dump_modify id {}", dump_modify_options));
+        }
+
+        command(fmt::format("run {} post no", ntimesteps));
+        END_HIDE_OUTPUT();
+    }
+
+    void continue_dump(int ntimesteps)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command(fmt::format("run {} pre no post no", ntimesteps));
+        END_HIDE_OUTPUT();
+    }
+
+    void close_dump()
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("undump id");
+        END_HIDE_OUTPUT();
+    }
+
+    // return last 16 bytes of file, which hold the index magic string
+
+    std::string read_trailer(std::string dump_file)
+    {
+        char trailer[16] = {'\0'};
+        FILE *fp         = fopen(dump_file.c_str(), "rb");
+        if (fp) {
+            fseek(fp, -16, SEEK_END);
+            if (fread(trailer, 1, 16, fp) != 16) trailer[0] = '\0';
+            fclose(fp);
+        }
+        return std::string(trailer);
+    }
+
+    // remove index record at end of file
+
+    void strip_index(std::string dump_file)
+    {
+        std::string content;
+        FILE *fp = fopen(dump_file.c_str(), "rb");
+        if (!fp) return;
+        char buf[4096];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) content.append(buf, n);
+        fclose(fp);
+
+        int64_t nframes;
+        memcpy(&nframes, content.data() + content.size() - 24, sizeof(int64_t));
+        content.resize(content.size() - (sizeof(int) + 2 * sizeof(int64_t) * (nframes + 1) + 16));
+
+        fp = fopen(dump_file.c_str(), "wb");
+        fwrite(content.data(), 1, content.size(), fp);
+        fclose(fp);
+    }
+
+    // run, rerun snapshots of steps 1 and 2 and compare potential energy
+
+    void check_rerun(std::string dump_file, std::string rerun_files, std::string fields,
+                     std::string dump_modify_options, double epsilon)
+    {
+        HIDE_OUTPUT([&] {
+            command("fix 1 all nve");
+        });
+        generate_dump(dump_file, fields, dump_modify_options, 1);
+        double pe_1, pe_2, pe_rerun;
+        lmp->output->thermo->evaluate_keyword("pe", &pe_1);
+        continue_dump(1);
+        close_dump();
+        lmp->output->thermo->evaluate_keyword("pe", &pe_2);
+
+        HIDE_OUTPUT([&] {
+            command(fmt::format("rerun {} first 2 last 2 every 1 post no dump x y z format columnar",
+                                rerun_files));
+        });
+        lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+        ASSERT_NEAR(pe_2, pe_rerun, epsilon);
+
+        HIDE_OUTPUT([&] {
+            command(fmt::format("rerun {} first 1 last 1 every 1 post no dump x y z format columnar",
+                                rerun_files));
+        });
+        lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+        ASSERT_NEAR(pe_1, pe_rerun, epsilon);
+    }
+};
+
+TEST_F(DumpColumnarTest, run1)
+{
+    auto dump_file = dump_filename("run1");
+    auto fields    = "id type x y z vx vy vz";
+
+    generate_dump(dump_file, fields, "", 1);
+    close_dump();
+
+    ASSERT_FILE_EXISTS(dump_file);
+    ASSERT_THAT(read_trailer(dump_file), Eq("COLUMNAR INDEX"));
+    delete_file(dump_file);
+}
+
+TEST_F(DumpColumnarTest, rerun)
+{
+    auto dump_file = dump_filename("rerun");
+    check_rerun(dump_file, dump_file, "id type x y z", "", 1.0e-14);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpColumnarTest, rerun_scaled)
+{
+    auto dump_file = dump_filename("rerun_scaled");
+    check_rerun(dump_file, dump_file, "id type xs ys zs", "compression_level 1", 1.0e-14);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpColumnarTest, rerun_precision)
+{
+    auto dump_file = dump_filename("rerun_precision");
+    check_rerun(dump_file, dump_file, "id type xu yu zu", "precision 1.0e8", 1.0e-5);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpColumnarTest, rerun_triclinic)
+{
+    auto dump_file = dump_filename("rerun_triclinic");
+    enable_triclinic();
+    check_rerun(dump_file, dump_file, "id type x y z", "", 1.0e-14);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpColumnarTest, rerun_multi_file)
+{
+    auto dump_file = dump_filename("rerun_multi_file_*");
+    std::string files;
+    for (int i = 0; i < 3; i++) files += " " + dump_filename(fmt::format("rerun_multi_file_{}", i));
+    check_rerun(dump_file, files, "id type x y z", "", 1.0e-14);
+    for (int i = 0; i < 3; i++) {
+        auto file = dump_filename(fmt::format("rerun_multi_file_{}", i));
+        ASSERT_THAT(read_trailer(file), Eq("COLUMNAR INDEX"));
+        delete_file(file);
+    }
+}
+
+TEST_F(DumpColumnarTest, rerun_no_index)
+{
+    auto dump_file = dump_filename("rerun_no_index");
+
+    // without index, e.g. from an interrupted run, snapshots are scanned in order
+
+    HIDE_OUTPUT([&] {
+        command("fix 1 all nve");
+    });
+    generate_dump(dump_file, "id type x y z", "", 1);
+    double pe_1, pe_2, pe_rerun;
+    lmp->output->thermo->evaluate_keyword("pe", &pe_1);
+    continue_dump(1);
+    close_dump();
+    lmp->output->thermo->evaluate_keyword("pe", &pe_2);
+    strip_index(dump_file);
+    ASSERT_THAT(read_trailer(dump_file), Ne("COLUMNAR INDEX"));
+
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 2 last 2 post no dump x y z format columnar",
+                            dump_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_NEAR(pe_2, pe_rerun, 1.0e-14);
+
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 1 last 1 post no dump x y z format columnar",
+                            dump_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_NEAR(pe_1, pe_rerun, 1.0e-14);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpColumnarTest, compressed_filename)
+{
+    TEST_FAILURE(".*ERROR: Dump columnar file name must not have a compression suffix.*",
+                 command("dump id all columnar 1 dump_columnar.melt.gz id type x y z"););
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
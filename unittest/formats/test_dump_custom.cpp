@@ -125,6 +125,34 @@ TEST_F(DumpCustomTest, run1)
     delete_file(dump_file);
 }
 
+TEST_F(DumpCustomTest, format_line_run0)
+{
+    auto dump_file = dump_filename("format_line_run0");
+    auto fields    = "id type x y";
+
+    generate_dump(dump_file, fields, "format line \"%5d %-3d x=%10.4f {%%%g}\"", 0);
+
+    ASSERT_FILE_EXISTS(dump_file);
+    auto lines = read_lines(dump_file);
+    ASSERT_EQ(lines.size(), 41);
+    ASSERT_THAT(lines[9], Eq("    1 1   x=    0.0000 {%0}"));
+    delete_file(dump_file);
+}
+
+TEST_F(DumpCustomTest, no_buffer_format_alternate_run0)
+{
+    auto dump_file = dump_filename("no_buffer_format_alternate_run0");
+    auto fields    = "id type x y";
+
+    generate_dump(dump_file, fields, "buffer no format float \"%#g\"", 0);
+
+    ASSERT_FILE_EXISTS(dump_file);
+    auto lines = read_lines(dump_file);
+    ASSERT_EQ(lines.size(), 41);
+    ASSERT_THAT(lines[9], Eq("1 1 0.00000 0.00000"));
+    delete_file(dump_file);
+}
+
 TEST_F(DumpCustomTest, thresh_run0)
 {
     auto dump_file = dump_filename("thresh_run0");
@@ -323,6 +323,9 @@ TEST_F(FileOperationsTest, write_restart)
     command("write_restart multi2-%.restart fileper 2");
     command("write_restart multi3-%.restart nfile 1");
     if (info->has_package("MPIIO")) command("write_restart test.restart.mpiio");
+    command("restart 2 async.restart async yes");
+    command("run 4 post no");
+    command("restart 0");
     END_HIDE_OUTPUT();
 
     ASSERT_FILE_EXISTS("noinit.restart");
@@ -334,6 +337,8 @@ TEST_F(FileOperationsTest, write_restart)
     ASSERT_FILE_EXISTS("multi2-0.restart");
     ASSERT_FILE_EXISTS("multi3-base.restart");
     ASSERT_FILE_EXISTS("multi3-0.restart");
+    ASSERT_FILE_EXISTS("async.restart.334");
+    ASSERT_FILE_EXISTS("async.restart.336");
     if (info->has_package("MPIIO")) {
         ASSERT_FILE_EXISTS("test.restart.mpiio");
     }
@@ -349,6 +354,8 @@ TEST_F(FileOperationsTest, write_restart)
     TEST_FAILURE(".*ERROR: Illegal write_restart command.*", command("write_restart"););
     TEST_FAILURE(".*ERROR: Illegal write_restart command.*",
                  command("write_restart test.restart xxxx"););
+    TEST_FAILURE(".*ERROR: Write_restart async option is only allowed with the restart command.*",
+                 command("write_restart test.restart async yes"););
     TEST_FAILURE(".*ERROR on proc 0: Cannot open restart file some_crazy_dir/test.restart:"
                  " No such file or directory.*",
                  command("write_restart some_crazy_dir/test.restart"););
@@ -383,9 +390,17 @@ TEST_F(FileOperationsTest, write_restart)
     ASSERT_EQ(lmp->atom->natoms, 1);
     ASSERT_EQ(lmp->update->ntimestep, 333);
     ASSERT_EQ(lmp->domain->triclinic, 1);
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("read_restart async.restart.336");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 1);
+    ASSERT_EQ(lmp->update->ntimestep, 336);
 
     // clean up
     delete_file("noinit.restart");
+    delete_file("async.restart.334");
+    delete_file("async.restart.336");
     delete_file("test.restart");
     delete_file("step333.restart");
     delete_file("multi-base.restart");
@@ -477,7 +492,49 @@ TEST_F(FileOperationsTest, write_data)
     ASSERT_EQ(lmp->atom->natoms, 1);
     ASSERT_EQ(lmp->domain->triclinic, 1);
 
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("pair_style zero 1.0");
+    command("read_data test.data parallel 4");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 1);
+    ASSERT_EQ(lmp->atom->nlocal, 1);
+    ASSERT_DOUBLE_EQ(lmp->atom->x[0][0], 0.5);
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Illegal read_data parallel value.*",
+                 command("read_data test.data parallel -1"););
+
+    BEGIN_HIDE_OUTPUT();
+    command("pair_style zero 1.0");
+    command("read_data test.data");
+    command("velocity all set 0.25 0.0 -1.0");
+    command("write_data binary.data binary yes");
+    command("clear");
+    command("pair_style zero 1.0");
+    command("read_data binary.data");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 1);
+    ASSERT_EQ(lmp->atom->tag[0], 1);
+    ASSERT_DOUBLE_EQ(lmp->atom->x[0][0], 0.5);
+    ASSERT_DOUBLE_EQ(lmp->atom->v[0][0], 0.25);
+    ASSERT_DOUBLE_EQ(lmp->atom->v[0][2], -1.0);
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("pair_style zero 1.0");
+    command("read_data binary.data parallel 2");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 1);
+    ASSERT_DOUBLE_EQ(lmp->atom->v[0][0], 0.25);
+    TEST_FAILURE(".*ERROR: Illegal write_data command.*",
+                 command("write_data test.data binary"););
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    END_HIDE_OUTPUT();
+
     // clean up
+    delete_file("binary.data");
     delete_file("charge.data");
     delete_file("nocoeff.data");
     delete_file("noinit.data");
@@ -0,0 +1,151 @@
+// unit tests for reading data files with several parallel readers
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "input.h"
+#include "lammps.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPIReadDataTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+    int me;
+
+    void SetUp() override
+    {
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        const char *args[] = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        MPI_Barrier(MPI_COMM_WORLD);
+        if (me == 0) {
+            remove("mpi_read_data.mol");
+            remove("mpi_read_data_ref.data");
+            remove("mpi_read_data_bin.data");
+            remove("mpi_read_data_out0.data");
+            remove("mpi_read_data_out1.data");
+        }
+    }
+
+    // molecular system with more rows in the Atoms, Velocities, Bonds, and Angles
+    //   sections than the readers read in one round, so each reads several chunks
+
+    void create_system()
+    {
+        if (me == 0) {
+            std::ofstream mol("mpi_read_data.mol");
+            mol << "# bent trimer\n\n3 atoms\n2 bonds\n1 angles\n\n"
+                << "Coords\n\n1 0.0 0.0 0.0\n2 0.35 0.0 0.0\n3 0.5 0.3 0.0\n\n"
+                << "Types\n\n1 1\n2 2\n3 1\n\n"
+                << "Charges\n\n1 -0.5\n2 1.0\n3 -0.5\n\n"
+                << "Bonds\n\n1 1 1 2\n2 1 2 3\n\n"
+                << "Angles\n\n1 1 1 2 3\n";
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("units           lj");
+        command("atom_style      full");
+        command("atom_modify     map array");
+        command("lattice         sc 1.0");
+        command("region          box block 0 33 0 33 0 33");
+        command("create_box      2 box bond/types 1 angle/types 1 "
+                "extra/bond/per/atom 2 extra/angle/per/atom 1 extra/special/per/atom 2");
+        command("molecule        trimer mpi_read_data.mol");
+        command("create_atoms    0 box mol trimer 4721");
+        command("mass            * 1.0");
+        command("velocity        all create 1.0 87287 loop geom");
+        command("write_data      mpi_read_data_ref.data");
+        command("write_data      mpi_read_data_bin.data binary yes");
+        command("clear");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // read data file and write it back as text
+
+    void read_write(const std::string &infile, const std::string &keywords,
+                    const std::string &outfile)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("atom_style      full");
+        command("atom_modify     map array");
+        command("read_data       " + infile + " " + keywords);
+        command("write_data      " + outfile);
+        command("clear");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // data files written on the same procs must be identical,
+    //   incl the order of atoms and of topology within each proc
+
+    void compare_files(const std::string &file0, const std::string &file1)
+    {
+        if (me != 0) return;
+        std::ifstream in0(file0), in1(file1);
+        std::string line0, line1;
+        int nline = 0;
+        while (std::getline(in0, line0)) {
+            ASSERT_TRUE((bool)std::getline(in1, line1)) << "missing line " << nline;
+            ASSERT_EQ(line0, line1) << "at line " << nline;
+            ++nline;
+        }
+        ASSERT_FALSE((bool)std::getline(in1, line1));
+        ASSERT_GT(nline, 100000);
+    }
+};
+
+TEST_F(MPIReadDataTest, binary_parallel)
+{
+    create_system();
+    read_write("mpi_read_data_ref.data", "", "mpi_read_data_out0.data");
+
+    read_write("mpi_read_data_bin.data", "", "mpi_read_data_out1.data");
+    compare_files("mpi_read_data_out0.data", "mpi_read_data_out1.data");
+
+    read_write("mpi_read_data_bin.data", "parallel 2", "mpi_read_data_out1.data");
+    compare_files("mpi_read_data_out0.data", "mpi_read_data_out1.data");
+
+    read_write("mpi_read_data_bin.data", "parallel 3", "mpi_read_data_out1.data");
+    compare_files("mpi_read_data_out0.data", "mpi_read_data_out1.data");
+}
+
+TEST_F(MPIReadDataTest, text_parallel)
+{
+    // Atoms section is several MB, so each reader reads blocks of growing size
+    //   in several rounds, 2nd pass for topology skips Atoms and Velocities
+
+    create_system();
+    read_write("mpi_read_data_ref.data", "", "mpi_read_data_out0.data");
+
+    read_write("mpi_read_data_ref.data", "parallel 2", "mpi_read_data_out1.data");
+    compare_files("mpi_read_data_out0.data", "mpi_read_data_out1.data");
+
+    read_write("mpi_read_data_ref.data", "parallel 3", "mpi_read_data_out1.data");
+    compare_files("mpi_read_data_out0.data", "mpi_read_data_out1.data");
+}
+} // namespace LAMMPS_NS